@@ -0,0 +1,43 @@
+#pragma once
+
+#include <GLM/vec3.hpp>
+#include <cstdint>
+
+namespace UnifiedEngine
+{
+    class Collider;
+
+    //In the order an object's events are handed out
+    enum CollisionEventType{
+        COLLISION_ENTER = 0,
+        COLLISION_STAY,
+        COLLISION_EXIT,
+        TRIGGER_ENTER,
+        TRIGGER_STAY,
+        TRIGGER_EXIT
+    };
+
+    //What a script is told, from its own object's side
+    struct Collision{
+        Collider* Self = nullptr; //The collider on the script's object
+        Collider* Other = nullptr;
+        glm::vec3 Normal = glm::vec3(0.f); //Pushing Self away from Other, zero for triggers and exits
+        glm::vec3 Point = glm::vec3(0.f); //Middle of the contact points
+        float Impulse = 0.f; //Normal impulse the solver applied this step
+    };
+
+    struct CollisionEvent{
+        CollisionEventType Type;
+        Collision Data;
+        int Owner = -1; //Lowest collider proxy on Self's object, set while dispatching so each object's events sort together
+    };
+
+    //A touching pair after a step, kept sorted by Key to find what changed since the last
+    struct TouchingPair{
+        uint64_t Key; //Proxy pair
+        Collider* A;
+        Collider* B;
+        bool Trigger;
+        int Manifold; //Its manifold while the step is being diffed, -1 for triggers
+    };
+} // namespace UnifiedEngine
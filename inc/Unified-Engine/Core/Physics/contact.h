@@ -0,0 +1,50 @@
+#pragma once
+
+#include <GLM/vec3.hpp>
+#include <GLM/mat3x3.hpp>
+#include <cstdint>
+
+namespace UnifiedEngine
+{
+    class Collider;
+
+    //Most points a manifold keeps, a face against a face is reduced to its four best
+    constexpr int MAX_CONTACT_POINTS = 4;
+
+    //Surfaces this close count as touching so resting contacts don't flicker, their points have a negative Depth
+    constexpr float CONTACT_MARGIN = 0.005f;
+
+    struct ContactPoint{
+        glm::vec3 Position; //World space, halfway between the surfaces
+        float Depth; //Penetration, positive when overlapping and down to -CONTACT_MARGIN when just apart
+
+        //Accumulated impulses, carried over to the next step when the point persists (Warm starting)
+        float NormalImpulse = 0.f;
+        float TangentImpulse[2] = {0.f, 0.f};
+
+        //Filled by the solver
+        glm::vec3 RA, RB; //From each body's centre
+        float NormalMass = 0.f;
+        float TangentMass[2] = {0.f, 0.f};
+        float Bias = 0.f;
+    };
+
+    struct ContactManifold{
+        Collider* A = nullptr;
+        Collider* B = nullptr;
+        int BodyA = -1; //Index of each side's solver body, -1 for static geometry
+        int BodyB = -1;
+
+        glm::vec3 Normal = glm::vec3(0.f); //From A to B
+        glm::vec3 Tangent[2];
+
+        int PointCount = 0;
+        ContactPoint Points[MAX_CONTACT_POINTS];
+
+        float Friction = 0.f;
+        float Restitution = 0.f;
+    };
+
+    //Contact points between two colliders (Boxes, spheres and meshes in either order), returns how many were found
+    int Collide(Collider* A, Collider* B, ContactManifold& Manifold);
+} // namespace UnifiedEngine
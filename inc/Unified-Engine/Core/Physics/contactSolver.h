@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Unified-Engine/Core/Physics/contact.h>
+#include <cstddef>
+
+namespace UnifiedEngine
+{
+    //Velocities a rigid body is solved with, copied back to it afterwards
+    struct SolverBody{
+        glm::vec3 Velocity = glm::vec3(0.f);
+        glm::vec3 AngularVelocity = glm::vec3(0.f);
+        glm::vec3 InverseMass = glm::vec3(0.f); //Per world axis, 0 on locked axes
+        glm::mat3 InverseInertia = glm::mat3(0.f); //World space
+        glm::vec3 Center = glm::vec3(0.f);
+    };
+
+    struct SolverSettings{
+        unsigned Iterations = 8;
+        float Baumgarte = 0.2f; //Fraction of the penetration pushed out each step
+        float Slop = 0.01f; //Penetration left alone so resting contacts persist
+        float RestitutionThreshold = 1.f; //Closing speeds under this do not bounce
+    };
+
+    /**
+     * @brief Sequential impulses (As in Box2D): each contact point's normal impulse is clamped to push only, friction
+     *        to the friction cone of it, and both accumulate so the last step's impulses can be applied up front (Warm starting).
+     *        Bodies are indexed by the manifolds' BodyA/BodyB, -1 is immovable.
+     *
+     */
+    void PrepareContacts(ContactManifold* const* Manifolds, size_t Count, SolverBody* Bodies, float DeltaTime, const SolverSettings& Settings);
+    void WarmStartContacts(ContactManifold* const* Manifolds, size_t Count, SolverBody* Bodies);
+    void SolveContacts(ContactManifold* const* Manifolds, size_t Count, SolverBody* Bodies); //One iteration
+
+    //All of the above with Settings.Iterations iterations
+    void SolveContactGroup(ContactManifold* const* Manifolds, size_t Count, SolverBody* Bodies, float DeltaTime, const SolverSettings& Settings);
+} // namespace UnifiedEngine
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <Unified-Engine/Core/Physics/sweepAndPrune.h>
+#include <Unified-Engine/Core/Physics/contactSolver.h>
+#include <Unified-Engine/Core/Physics/sceneQuery.h>
+#include <Unified-Engine/Core/Physics/collisionEvent.h>
+#include <Unified-Engine/Core/Spatial/aabbTree.h>
+#include <unordered_map>
+#include <vector>
+#include <cstddef>
+
+namespace UnifiedEngine
+{
+    class Collider;
+    class RigidBody;
+    struct OrientedBox;
+
+    struct ColliderPair{
+        Collider* A;
+        Collider* B;
+    };
+
+    //Bodies joined by contacts, ranges into the world's island arrays
+    struct PhysicsIsland{
+        size_t BodyStart = 0;
+        size_t BodyCount = 0;
+        size_t ManifoldStart = 0;
+        size_t ManifoldCount = 0;
+        bool Awake = false;
+    };
+
+    /**
+     * @brief Owns the physics broadphase and steps every RigidBody. Enabled colliders and rigid bodies register themselves
+     *        on update, Step then runs after objects update:
+     *        - Every collider's proxies take its current box, then sweep and prune pairs the colliders whose boxes overlap
+     *        - Velocities take gravity, acceleration and drag
+     *        - Pairs with a rigid body get contact manifolds, matched with last step's for warm starting
+     *        - Bodies are split into islands by the contacts between them (union find)
+     *        - Sequential impulses resolve each awake island, in parallel on the worker pool, then positions move by the solved velocities
+     *        - Bullet bodies sweep their colliders' proxies over their whole motion, then move hit by hit: up to the time of
+     *          impact with what their proxies paired with, a contact solved there, then on with the rest of the step
+     *        - Islands that stay slower than SleepVelocity for SleepTime go to sleep, skipping integration and solving
+     *          until an awake body touches them
+     *
+     *        Colliders on the same object are never paired. A collider without a RigidBody on its object is immovable.
+     *        Trigger colliders only report overlaps, they get no manifold and bullets pass through them.
+     *
+     *        Each step compares its touching pairs (Sorted by proxy pair) with the last step's for enter, stay and exit
+     *        events. They queue up until DispatchEvents hands them to the ScriptableObjects on each collider's object,
+     *        sorted so each object's events go out together, collider by collider. The queues are reused, so nothing is
+     *        allocated per event.
+     *
+     *        Deterministic mode makes a run repeatable bit for bit: Advance only takes steps of FixedTimeStep, pairs are put
+     *        in proxy order (Sweep and prune's order depends on how the boxes moved), and every step ends with a hash of
+     *        every body's state. Recorded hashes can be checked against a replay to find the first step that differs.
+     *        Island solving stays parallel, islands share no bodies so the threads' order changes nothing.
+     *
+     *        Colliders are also kept in a dynamic AABB tree for scene queries (Rays, sphere casts and overlaps), which test
+     *        the exact shapes of what the tree finds. Given the scene tree it shares that with culling and skips the
+     *        proxies that aren't colliders. Queries only read, so any number can run at once between steps.
+     *
+     */
+    class PhysicsWorld{
+    protected:
+        SweepAndPrune Broadphase;
+        AABBTree LocalQueryTree = {}; //Used when not given a scene tree
+        AABBTree* QueryTree; //The same colliders for scene queries (Sweep and prune can only pair), Data is the ObjectComponent
+        std::vector<ColliderPair> PairList = {};
+
+        std::vector<RigidBody*> Bodies = {};
+        std::vector<SolverBody> SolverBodies = {};
+
+        std::vector<ContactManifold> Manifolds = {};
+        std::vector<uint64_t> ManifoldKeys = {}; //Proxy pair of each manifold
+        std::vector<ContactManifold> OldManifolds = {};
+        std::vector<uint64_t> OldManifoldKeys = {};
+        std::unordered_map<uint64_t, size_t> OldManifoldIndex = {}; //Proxy pair to its manifold in OldManifolds
+
+        std::vector<int> IslandParent = {}; //Union find over Bodies
+        std::vector<PhysicsIsland> Islands = {};
+        std::vector<int> IslandBodies = {};
+        std::vector<ContactManifold*> IslandManifolds = {};
+
+        std::vector<ColliderPair> TriggerPairs = {}; //Overlapping this step, at least one is a trigger
+        std::vector<TouchingPair> Touching = {}; //After the last step, sorted by Key
+        std::vector<TouchingPair> NextTouching = {};
+        std::vector<CollisionEvent> Events = {}; //Two per change (One for each side) waiting for DispatchEvents
+
+        std::vector<RigidBody*> Bullets = {}; //Awake bullets this step
+        std::vector<ColliderPair> BulletPairs = {}; //A is the bullet's collider
+
+        float Accumulator = 0.f; //Frame time Advance hasn't stepped yet
+        std::vector<uint64_t>* HashRecord = nullptr;
+        const std::vector<uint64_t>* HashExpected = nullptr;
+        uint64_t HashStart = 0; //StepIndex the record or replay began at
+
+    public:
+        SolverSettings Settings = {};
+
+        float SleepVelocity = 0.1f; //Linear and angular speed an island has to stay under to sleep
+        float SleepTime = 0.5f; //Seconds under SleepVelocity before sleeping, 0 never sleeps
+
+        unsigned BulletSubsteps = 4; //Hits a bullet resolves in one step, the rest of its motion waits for the next
+
+        bool Deterministic = false; //Fixed steps, pairs in a fixed order and a state hash after every step
+        float FixedTimeStep = 1.f / 60.f; //Length of each step Advance takes when Deterministic
+        unsigned MaxStepsPerFrame = 4; //Steps Advance may take for one frame, time past that is dropped so a slow frame can't snowball
+
+        uint64_t StepIndex = 0; //Steps taken since the world was made
+        uint64_t LastStateHash = 0; //StateHash after the last Step, when Deterministic
+        int64_t DivergedStep = -1; //First step (Counted from VerifyHashes) whose hash differed from the expected one, -1 while they match
+
+        //Stats, from the last Step
+        size_t ColliderCount = 0;
+        size_t PairCount = 0;
+        size_t ContactCount = 0;
+        size_t IslandCount = 0;
+        size_t SleepingCount = 0; //Bodies
+        size_t BulletCount = 0; //Awake
+        double SolverMilliseconds = 0.0;
+
+    public:
+        PhysicsWorld(AABBTree* SceneTree = nullptr); //Shares the scene tree for queries when given one
+        ~PhysicsWorld();
+
+    public:
+        int AddCollider(Collider* collider); //Creates or moves its proxy
+        int RemoveCollider(Collider* collider); //Wakes whatever it was touching
+
+        int AddBody(RigidBody* body);
+        int RemoveBody(RigidBody* body);
+
+        int Step(float DeltaTime);
+        int Advance(float FrameTime); //A frame's steps, FixedTimeStep at a time when Deterministic or one step otherwise, then DispatchEvents. Returns the steps taken
+        void DispatchEvents(); //Hands every queued collision event to its object's scripts
+
+        //FNV-1a over every body's position, rotation, velocities and sleep state in body order, equal only for bit identical states
+        uint64_t StateHash() const;
+
+        //Replays, from the next step each step's hash is appended to Log or compared with Expected (Null stops)
+        void RecordHashes(std::vector<uint64_t>* Log);
+        void VerifyHashes(const std::vector<uint64_t>* Expected);
+
+        //Overlapping collider boxes found by the last Step
+        inline const std::vector<ColliderPair>& Pairs() const {return this->PairList;}
+        //Touching pairs from the last Step, with the impulses that kept them apart
+        inline const std::vector<ContactManifold>& Contacts() const {return this->Manifolds;}
+
+    public: //Scene queries, colliders whose Layer bit isn't in LayerMask are skipped. Directions are normalised
+        bool Raycast(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, RaycastHit& Hit, uint32_t LayerMask = ALL_LAYERS) const; //Nearest hit
+        size_t RaycastAll(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, std::vector<RaycastHit>& Hits, uint32_t LayerMask = ALL_LAYERS) const; //Nearest first
+        bool SphereCast(const glm::vec3& Origin, float Radius, const glm::vec3& Direction, float MaxDistance, RaycastHit& Hit, uint32_t LayerMask = ALL_LAYERS) const; //Finite MaxDistance, colliders it starts in are ignored
+
+        size_t OverlapBox(const OrientedBox& Box, std::vector<Collider*>& Out, uint32_t LayerMask = ALL_LAYERS) const;
+        size_t OverlapSphere(const glm::vec3& Center, float Radius, std::vector<Collider*>& Out, uint32_t LayerMask = ALL_LAYERS) const;
+
+        //Each ray's nearest hit into Hits (Room for Count), split over the worker pool
+        void RaycastBatch(const RayQuery* Rays, size_t Count, RaycastHit* Hits, uint32_t LayerMask = ALL_LAYERS) const;
+
+    protected:
+        void FindContacts();
+        void BuildIslands();
+        void Solve(float DeltaTime);
+        void UpdateSleeping(float DeltaTime);
+
+        void SyncProxies(); //Every collider's proxies to where it is now, so no step pairs against boxes from before the last
+        void SweepBullets(float DeltaTime); //Grows their proxies over the motion ahead
+        void AdvanceBullets(float DeltaTime); //Moves them in place of IntegratePosition
+
+        void DropContacts(Collider* collider, RigidBody* body); //Erases the manifolds touching either, waking the other side
+        void QueueEvents(); //Diffs this step's touching pairs with the last step's
+        static int OwnerKey(Collider* collider); //Lowest proxy of the colliders on its object, the same for each of them
+
+        int FindIsland(int Body);
+    };
+
+    extern PhysicsWorld* __GLOBAL_PHYSICS_WORLD;
+} // namespace UnifiedEngine
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <GLM/vec3.hpp>
+#include <cfloat>
+#include <cstdint>
+
+namespace UnifiedEngine
+{
+    class Collider;
+    class ObjectComponent;
+
+    //Default mask of a scene query, every layer
+    constexpr uint32_t ALL_LAYERS = 0xFFFFFFFFu;
+
+    struct RaycastHit{
+        Collider* HitCollider = nullptr; //Null when nothing was hit
+        ObjectComponent* Object = nullptr; //The collider's parent
+        glm::vec3 Point = glm::vec3(0.f);
+        glm::vec3 Normal = glm::vec3(0.f); //Of the surface, facing back along the ray
+        float Distance = 0.f; //0 when the ray starts inside
+    };
+
+    //One ray of a batched cast
+    struct RayQuery{
+        glm::vec3 Origin = glm::vec3(0.f);
+        glm::vec3 Direction = glm::vec3(0.f, 0.f, 1.f); //Normalised
+        float MaxDistance = FLT_MAX;
+    };
+} // namespace UnifiedEngine
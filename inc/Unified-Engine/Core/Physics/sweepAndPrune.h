@@ -0,0 +1,89 @@
+#pragma once
+
+#include <Unified-Engine/Objects/Mesh/mesh.h>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace UnifiedEngine
+{
+    struct BroadphasePair{
+        int ProxyA; //Always the lower proxy
+        int ProxyB;
+    };
+
+    /**
+     * @brief Incremental sweep and prune over the min/max endpoints of every proxy's box on all three axes.
+     *        Endpoints stay sorted between updates so a step only costs the insertion sort swaps of what moved,
+     *        a min passing a max starts an overlap and a max passing a min ends one, which keeps the pair set current.
+     *
+     *        Proxies are created, moved and destroyed freely, Update applies all of it at once.
+     *
+     */
+    class SweepAndPrune{
+    protected:
+        struct Proxy{
+            AABB Box;
+            void* Data = nullptr;
+            bool Alive = false;
+        };
+
+        struct Endpoint{
+            float Value;
+            uint32_t Tag; //Proxy << 1, low bit set for a max
+
+            inline int Owner() const {return (int)(this->Tag >> 1);}
+            inline bool IsMax() const {return this->Tag & 1;}
+        };
+
+        std::vector<Proxy> Proxies = {};
+        std::vector<int> FreeProxies = {};
+        std::vector<int> DeadProxies = {}; //Destroyed since the last update, reused once their endpoints and pairs are gone
+
+        std::vector<Endpoint> Axes[3] = {};
+        size_t Sorted = 0; //Endpoints per axis already in order, anything after came from new proxies
+
+        std::vector<BroadphasePair> PairList = {};
+        std::unordered_map<uint64_t, size_t> PairIndex = {}; //Key to position in PairList
+
+    public:
+        //Stats, from the last Update
+        size_t Swaps = 0;
+        bool Rebuilt = false;
+
+    public:
+        SweepAndPrune();
+        ~SweepAndPrune();
+
+    public:
+        int CreateProxy(const AABB& Box, void* Data);
+        int DestroyProxy(int Proxy);
+        int MoveProxy(int Proxy, const AABB& Box);
+
+        //Sorts the endpoints and brings the pair set up to date
+        int Update();
+
+        inline const std::vector<BroadphasePair>& Pairs() const {return this->PairList;}
+
+        inline const AABB& Box(int Proxy) const {return this->Proxies[Proxy].Box;}
+        inline void* Data(int Proxy) const {return this->Proxies[Proxy].Data;}
+        inline size_t Count() const {return this->Proxies.size() - this->FreeProxies.size() - this->DeadProxies.size();}
+        inline size_t Capacity() const {return this->Proxies.size();} //Proxies ever made, Data is null for the free ones
+
+    protected:
+        void Purge(); //Drops the endpoints and pairs of dead proxies
+        void Rebuild(); //Full sort and sweep, cheaper than inserting many proxies one swap at a time
+        void SortAxis(int Axis);
+
+        bool Overlaps(int A, int B) const;
+        void AddPair(int A, int B);
+        void RemovePair(int A, int B);
+
+        static inline uint64_t PairKey(int A, int B){
+            if(A > B)
+                std::swap(A, B);
+            return ((uint64_t)(uint32_t)A << 32) | (uint32_t)B;
+        }
+    };
+} // namespace UnifiedEngine
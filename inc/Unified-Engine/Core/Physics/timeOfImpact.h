@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Unified-Engine/Objects/Mesh/mesh.h>
+#include <GLM/vec3.hpp>
+
+namespace UnifiedEngine
+{
+    class Collider;
+    struct OrientedBox;
+
+    /**
+     * @brief Time of impact queries, how far along a straight Motion a shape gets before touching another that stays put.
+     *        Fraction is in [0, 1] of Motion. Neither shape turns during the sweep, a body turning fast enough to matter
+     *        is left to the contacts of the next step.
+     *
+     *        Shapes already overlapping at the start give no hit, contacts handle those.
+     *
+     */
+
+    //Box against box (Slab test against Other grown by Moving)
+    bool SweepAABB(const AABB& Moving, const glm::vec3& Motion, const AABB& Other, float& Fraction);
+
+    //Sphere against box, the box is grown by the radius so corners hit slightly early
+    bool SweepSphere(const glm::vec3& Center, float Radius, const glm::vec3& Motion, const AABB& Other, float& Fraction);
+
+    //Collider shapes. Box pairs are exact (Separating axes over time) and so are spheres against boxes (Rounded edges and
+    //corners), a moving mesh sweeps as its bounding box and a mesh being hit is tested triangle by triangle through its BVH
+    bool TimeOfImpact(Collider* Moving, const glm::vec3& Motion, Collider* Other, float& Fraction);
+
+    //A sphere that isn't a collider (Scene sphere casts) into a collider's shape
+    bool SweepSphere(const glm::vec3& Center, float Radius, const glm::vec3& Motion, Collider* Other, float& Fraction);
+
+    //The same separating axes standing still, touching counts
+    bool BoxesOverlap(const OrientedBox& A, const OrientedBox& B);
+    bool BoxTriangleOverlap(const OrientedBox& Box, const glm::vec3& A, const glm::vec3& B, const glm::vec3& C);
+} // namespace UnifiedEngine
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Unified-Engine/Objects/Mesh/mesh.h>
+#include <Unified-Engine/Core/Spatial/bvh.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace UnifiedEngine
+{
+    /**
+     * @brief Collision copy of a mesh, the full detail triangles' positions with a BVH over each triangle's box.
+     *        Everything stays in the mesh's local space, colliders move queries into it instead of moving the triangles,
+     *        so it is built once and shared by every step after.
+     *
+     */
+    class TriangleMesh{
+    protected:
+        std::vector<glm::vec3> Positions = {};
+        std::vector<uint32_t> Indices = {}; //Three per triangle
+        AABB LocalBounds = {};
+        BVH Tree;
+
+    public:
+        TriangleMesh();
+        TriangleMesh(const Mesh& mesh);
+        ~TriangleMesh();
+
+    public:
+        int Build(const Mesh& mesh); //-1 without a triangle, a mesh without indices is taken three vertices at a time
+        void Clear();
+
+        inline size_t TriangleCount() const {return this->Indices.size() / 3;}
+        inline bool Empty() const {return this->Indices.empty();}
+        inline const AABB& Bounds() const {return this->LocalBounds;}
+        inline const BVH& Hierarchy() const {return this->Tree;} //Items are triangle indices
+
+        void Triangle(size_t Index, glm::vec3& A, glm::vec3& B, glm::vec3& C) const;
+
+    protected:
+        void AddIndices(const Mesh& mesh); //The full detail triangles, skipping any pointing past the vertices
+    };
+
+    //Exact separating axis test, touching counts and coplanar triangles are handled
+    bool TrianglesIntersect(const glm::vec3& A0, const glm::vec3& A1, const glm::vec3& A2, const glm::vec3& B0, const glm::vec3& B1, const glm::vec3& B2);
+
+    glm::vec3 ClosestPointOnTriangle(const glm::vec3& Point, const glm::vec3& A, const glm::vec3& B, const glm::vec3& C);
+} // namespace UnifiedEngine
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Unified-Engine/Objects/Mesh/mesh.h>
+#include <GLM/vec4.hpp>
+#include <GLM/mat4x4.hpp>
+
+namespace UnifiedEngine
+{
+    /**
+     * @brief The six clip planes of a view projection matrix (Gribb and Hartmann), normals point inwards.
+     *
+     */
+    struct Frustum
+    {
+        glm::vec4 Planes[6] = {};
+
+        Frustum() = default;
+        explicit Frustum(const glm::mat4& ViewProjection)
+        {
+            //Left/right, bottom/top, near/far are the w row plus and minus the x, y and z rows
+            glm::vec4 w(ViewProjection[0][3], ViewProjection[1][3], ViewProjection[2][3], ViewProjection[3][3]);
+
+            for (int i = 0; i < 3; i++)
+            {
+                glm::vec4 row(ViewProjection[0][i], ViewProjection[1][i], ViewProjection[2][i], ViewProjection[3][i]);
+                Planes[i * 2] = w + row;
+                Planes[(i * 2) + 1] = w - row;
+            }
+        }
+
+        //False only when the box is entirely outside one plane (Boxes near corners may pass)
+        bool Intersects(const AABB& box) const
+        {
+            for (int i = 0; i < 6; i++)
+            {
+                //Corner furthest along the plane normal
+                glm::vec3 corner(Planes[i].x >= 0.f ? box.max.x : box.min.x,
+                                 Planes[i].y >= 0.f ? box.max.y : box.min.y,
+                                 Planes[i].z >= 0.f ? box.max.z : box.min.z);
+
+                if ((Planes[i].x * corner.x) + (Planes[i].y * corner.y) + (Planes[i].z * corner.z) + Planes[i].w < 0.f)
+                    return false;
+            }
+            return true;
+        }
+    };
+} // namespace UnifiedEngine
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <GLM/vec4.hpp>
+#include <cstdint>
+#include <cstddef>
+
+namespace UnifiedEngine
+{
+    enum MipFilter{
+        MIP_FILTER_BOX = 0, //2x2 average, what glGenerateMipmap gives
+        MIP_FILTER_KAISER   //8 tap Kaiser windowed sinc, sharper without ringing
+    };
+
+    struct MipSettings{
+        MipFilter Filter = MIP_FILTER_KAISER;
+        bool GammaCorrect = true; //Filter in linear space, colour is treated as sRGB
+        bool PremultipliedAlpha = true; //Weight colour by alpha so transparent texels do not bleed in
+        bool OutputPremultiplied = false; //Keep every level premultiplied (Blend with GL_ONE, GL_ONE_MINUS_SRC_ALPHA)
+    };
+
+    int MipLevelCount(int Size); //Levels down to 1x1
+    size_t MipChainOffset(int Size, int Level); //Byte offset of a level in a tightly packed RGBA8 chain of a square image
+
+    //Multiplies RGB by alpha in place
+    int PremultiplyAlpha(uint8_t* Pixels, size_t Count);
+
+    /**
+     * @brief Rebuilds the part of the next level (SrcSize / 2 square) affected by Region of the source level.
+     *        Rows are spread over the worker pool when there is one.
+     *
+     * @param Region Changed source texels (Min x, min y, max x, max y)
+     * @return The texels of Dest that were rewritten
+     */
+    glm::ivec4 DownsampleRegion(const uint8_t* Src, int SrcSize, uint8_t* Dest, glm::ivec4 Region, const MipSettings& Settings);
+
+    //Fills every level after the first of a chain laid out as MipChainOffset describes
+    int BuildMipChain(uint8_t* Chain, int Size, const MipSettings& Settings);
+} // namespace UnifiedEngine
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Unified-Engine/Core/Rendering/frustum.h>
+#include <Unified-Engine/Core/Spatial/bvh.h>
+#include <Unified-Engine/Objects/gameObject.h>
+#include <vector>
+#include <cstddef>
+
+namespace UnifiedEngine
+{
+    /**
+     * @brief Bakes GameObjects marked Static into combined world space meshes, one per shader, atlas page
+     *        and grid cell, so thousands of static objects draw in a few calls. Cells are frustum culled through a BVH.
+     *        Baking only happens after a static object is added or removed (instantiate/destroy).
+     *
+     *        A batch is drawn with the shader arguments and materials of the first object baked into it.
+     *        Objects with no CPU side mesh (Uploaded from a MeshFile) are left to draw themselves.
+     *
+     */
+    class StaticBatcher{
+    protected:
+        struct Batch{
+            GameObject* Object;
+            AABB Bounds;
+        };
+
+        std::vector<GameObject*> Members = {};
+        std::vector<Batch> Batches = {};
+        BVH Tree; //Over the batch bounds, culls whole groups of cells at once
+        bool Dirty = false;
+
+    public:
+        float CellSize; //!< World space size of a batch cell
+
+        //Stats, from the last Render
+        size_t DrawCalls = 0;
+        size_t Culled = 0;
+
+    public:
+        StaticBatcher(float CellSize = 64.f);
+        ~StaticBatcher();
+
+    public:
+        int Add(GameObject* Object); //Adds it and any static children
+        int Remove(GameObject* Object);
+
+        int Update(); //Re-bakes when the members changed, call after objects update so matrices are current
+        int Render(const glm::mat4& ViewProjection);
+
+        inline size_t BatchCount(){return this->Batches.size();}
+
+    protected:
+        int Bake();
+        int Release();
+    };
+
+    extern StaticBatcher* __GLOBAL_STATIC_BATCHER;
+} // namespace UnifiedEngine
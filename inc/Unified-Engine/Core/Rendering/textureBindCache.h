@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Unified-Engine/includeGL.h>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace UnifiedEngine
+{
+    //Unit used for uploads and other short lived binds, never handed out as a sampler unit
+    constexpr GLuint TEXTURE_SCRATCH_UNIT = 0;
+
+    /**
+     * @brief Shadows the texture bindings of the main context so binds that would not change
+     *        anything are skipped. Every sampled texture is given a stable unit by AssignUnit,
+     *        units are only re-used (least recently used first) once all of them are taken.
+     *        Any texture bind/delete on the main context should go through here or call Invalidate().
+     * 
+     */
+    class TextureBindCache{
+    protected:
+        //Bindings per unit for the targets we track
+        struct UnitBindings{
+            GLuint Textures[3];
+        };
+
+        std::vector<UnitBindings> Units = {};
+        GLuint ActiveUnit = 0;
+
+        //Sampler unit assignment
+        std::unordered_map<GLuint, GLuint> AssignedUnits = {}; //Texture -> Unit
+        std::vector<GLuint> UnitOwners = {}; //Unit -> Texture
+        std::vector<uint64_t> UnitLastUse = {};
+        uint64_t UseCounter = 0;
+
+    protected:
+        int Setup();
+        static int TargetSlot(GLenum Target);
+
+    public:
+        //Stats
+        uint64_t BindsIssued = 0;
+        uint64_t BindsSkipped = 0;
+
+    public:
+        TextureBindCache();
+        ~TextureBindCache();
+
+    public:
+        int ActiveTexture(GLuint Unit);
+        int Bind(GLuint Unit, GLenum Target, GLuint Texture);
+
+        GLuint AssignUnit(GLuint Texture); //Stable sampler unit for the texture
+        int Forget(GLuint Texture); //Call when a texture is deleted
+        int Invalidate(); //Call after binding textures without the cache
+    };
+
+    extern TextureBindCache BindCache;
+} // namespace UnifiedEngine
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Unified-Engine/includeGL.h>
+#include <cstdint>
+#include <cstddef>
+
+//S3TC is an extension so glad (core only) does not define it
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace UnifiedEngine
+{
+    enum TextureCompression{
+        TEXTURE_COMPRESSION_NONE = 0,
+        TEXTURE_COMPRESSION_BC1, //RGB 4bpp, alpha is dropped
+        TEXTURE_COMPRESSION_BC3, //RGBA 8bpp, BC1 colour + seperate alpha block
+        TEXTURE_COMPRESSION_BC7  //RGBA 8bpp, encoded with mode 6 (Needs GL 4.2 or ARB_texture_compression_bptc)
+    };
+
+    //Bytes per 4x4 block (0 for none)
+    size_t CompressedBlockSize(TextureCompression Format);
+    //Bytes needed for a Width x Height image, partial blocks are padded
+    size_t CompressedImageSize(TextureCompression Format, int Width, int Height);
+
+    GLenum CompressedInternalFormat(TextureCompression Format);
+
+    //Falls back BC7 -> BC3 -> None depending on what the context supports, call on the GL thread
+    TextureCompression SupportedCompression(TextureCompression Requested);
+
+    /**
+     * @brief Encodes an RGBA8 image into 4x4 blocks (rows of blocks, left to right, top to bottom).
+     *        Block rows are spread over the worker pool when there is one.
+     *
+     * @param Stride Bytes between rows of Src (0 = Width * 4)
+     */
+    int CompressImage(TextureCompression Format, const uint8_t* Src, int Width, int Height, size_t Stride, uint8_t* Dest);
+
+    //Decodes blocks made by CompressImage back to RGBA8 (BC7 only supports mode 6)
+    int DecompressImage(TextureCompression Format, const uint8_t* Src, int Width, int Height, uint8_t* Dest);
+
+    //Peak signal to noise ratio in dB over the first Channels channels of two RGBA8 images
+    double ComputePSNR(const uint8_t* A, const uint8_t* B, int Width, int Height, int Channels = 4);
+} // namespace UnifiedEngine
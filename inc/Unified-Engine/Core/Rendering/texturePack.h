@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Unified-Engine/Core/Rendering/texturePackFormat.h>
+#include <Unified-Engine/Objects/Components/texture2d.h>
+#include <Unified-Engine/Utility/mappedFile.h>
+#include <unordered_map>
+#include <vector>
+#include <string>
+
+namespace UnifiedEngine
+{
+    /**
+     * @brief A texture pack made by tools/asset_cook, memory mapped so nothing is decoded at runtime.
+     *        Each cooked page becomes its own atlas page the first time one of its textures is loaded,
+     *        uploaded (With its mips) straight out of the mapping.
+     * 
+     */
+    class TexturePack{
+    protected:
+        MappedFile File;
+        const TexturePackHeader* Header = nullptr;
+        const TexturePackEntry* Entries = nullptr;
+
+        std::unordered_map<std::string, uint32_t> Lookup = {}; //Canonical file path -> entry
+        std::vector<int> AtlasPages = {}; //Pack page -> atlas page (-1 until uploaded)
+        std::vector<uint32_t> AtlasGenerations = {}; //Generation of the atlas page when it was uploaded, stale once the page empties
+
+    protected:
+        int UploadPage(uint32_t Page);
+        bool PageResident(uint32_t Page);
+
+    public:
+        TexturePack();
+        ~TexturePack();
+
+    public:
+        int Open(std::string FilePath, std::string Root = ""); //Root defaults to the folder holding the pack
+
+        Texture2D* Load(const std::string& FullPath); //Nullptr when the pack does not have it
+        int Load(const std::string& FullPath, Texture2D* Into); //Puts an evicted texture back where it was cooked
+        bool Contains(const std::string& FullPath);
+
+        inline size_t Count(){return this->Lookup.size();}
+    };
+
+    extern std::vector<TexturePack*> __GLOBAL_TEXTURE_PACKS;
+
+    //Packs are searched in mount order by LoadTexture and LoadTextureAsync
+    TexturePack* MountTexturePack(std::string FilePath, std::string Root = "");
+
+    //Canonical path (See GetFullPath) -> texture from the first pack holding it
+    Texture2D* FindPackedTexture(const std::string& FullPath);
+} // namespace UnifiedEngine
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+//On disk layout of a cooked texture pack (.uepack), shared by the runtime and tools/asset_cook
+//No GL in here so the cooker can build without a context
+
+namespace UnifiedEngine
+{
+    constexpr uint32_t TEXTURE_PACK_MAGIC = 0x4B504555; //"UEPK"
+    constexpr uint32_t TEXTURE_PACK_VERSION = 1; //Bump on any layout change, old packs are rejected
+    constexpr uint32_t TEXTURE_PACK_PAGE_SIZE = 4096; //Same as ATLAS_PAGE_SIZE
+
+    //Page data starts on this boundary so each page maps cleanly
+    constexpr uint64_t TEXTURE_PACK_ALIGNMENT = 4096;
+
+    /**
+     * @brief File layout:
+     *        Header | Entries[EntryCount] | Path strings | (aligned) Pages[PageCount]
+     *        Every page is PageStride bytes of RGBA8, mip 0 first then each smaller level.
+     *
+     */
+    struct TexturePackHeader{
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t PageSize; //Must match TEXTURE_PACK_PAGE_SIZE
+        uint32_t PageCount;
+        uint32_t MipCount;
+        uint32_t EntryCount;
+        uint64_t EntryOffset;
+        uint64_t StringOffset;
+        uint64_t PageOffset;
+        uint64_t PageStride;
+    };
+
+    struct TexturePackEntry{
+        uint32_t PathOffset; //Into the string table, relative to the pack root with '/' seperators
+        uint32_t PathLength;
+        uint32_t Page;
+        uint32_t x;
+        uint32_t y;
+        uint32_t w;
+        uint32_t h;
+        float UV[8]; //Same order as TextureUVs
+    };
+
+    static_assert(sizeof(TexturePackHeader) == 56, "Texture pack header layout changed");
+    static_assert(sizeof(TexturePackEntry) == 60, "Texture pack entry layout changed");
+
+    //Byte offset of a mip level inside a page
+    inline uint64_t TexturePackMipOffset(uint32_t PageSize, uint32_t Level){
+        uint64_t offset = 0;
+
+        for(uint32_t i = 0; i < Level; i++){
+            uint64_t size = (PageSize >> i) ? (PageSize >> i) : 1;
+            offset += size * size * 4;
+        }
+
+        return offset;
+    }
+} // namespace UnifiedEngine
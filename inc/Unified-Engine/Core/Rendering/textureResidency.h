@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Unified-Engine/Objects/Components/texture2d.h>
+#include <list>
+#include <cstdint>
+#include <cstddef>
+
+namespace UnifiedEngine
+{
+    /**
+     * @brief Keeps the atlas pages on the GPU under Budget. Memory only comes back when a page empties, so
+     *        once over budget it evicts whole pages, least recently bound first, where every texture on the
+     *        page may go. Evicted textures are reloaded from their cooked pack or file the next time they are
+     *        bound. Textures without a file path, and pinned ones, are never evicted and keep their page.
+     *        An array atlas allocates its layers up front and can't give them back, so it is never evicted from.
+     *
+     */
+    class TextureResidency{
+    protected:
+        std::list<Texture2D*> Textures = {};
+        uint64_t Frame = 0;
+
+    public:
+        size_t Budget; //!< Bytes of atlas pages before eviction starts (0 never evicts)
+        unsigned EvictionFrames; //!< Frames a texture has to go unbound before it may be evicted
+
+        //Stats
+        size_t ResidentBytes = 0; //Atlas PageBytes() at the last Update
+        uint64_t Evictions = 0;
+        uint64_t Restores = 0;
+
+    public:
+        TextureResidency(size_t Budget = 0, unsigned EvictionFrames = 120);
+        ~TextureResidency();
+
+    public:
+        int Track(Texture2D* texture); //Called by the atlas whenever a texture is placed
+        int Untrack(Texture2D* texture);
+        int Touch(Texture2D* texture); //Marks the texture as used this frame
+
+        int Evict(Texture2D* texture);
+        int Restore(Texture2D* texture); //Asynchronous when there is a streamer and the texture is not in a pack
+
+        int Update(); //Call once per frame on the GL thread, evicts until back under budget
+
+    protected:
+        bool Evictable(Texture2D* texture); //Has a source, isn't pinned and has gone unbound for EvictionFrames
+
+        inline size_t Count(){return this->Textures.size();}
+    };
+
+    extern TextureResidency* __GLOBAL_TEXTURE_RESIDENCY;
+} // namespace UnifiedEngine
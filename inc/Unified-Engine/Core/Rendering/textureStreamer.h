@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Unified-Engine/includeGL.h>
+#include <Unified-Engine/Objects/Components/texture2d.h>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <string>
+
+namespace UnifiedEngine
+{
+    //A decoded image waiting for the GL thread
+    struct TextureStreamRequest
+    {
+        Texture2D* Texture = nullptr;
+        uint8_t* Data = nullptr;
+        int width = 0;
+        int height = 0;
+    };
+
+    /**
+     * @brief Decodes textures on the worker pool and uploads them on the GL thread.
+     *        Uploads go through a persistently mapped pixel buffer split into one segment per
+     *        frame in flight, UploadBudget bytes are uploaded per Update() at most.
+     *        Requested textures show the placeholder until their data has been uploaded.
+     * 
+     */
+    class TextureStreamer{
+    protected:
+        //Filled by the worker threads
+        std::mutex ReadyLock;
+        std::condition_variable ReadySignal;
+        std::deque<TextureStreamRequest> Ready = {};
+
+        //GL thread only
+        std::unordered_map<std::string, Texture2D*> InFlight = {};
+        Texture2D* Placeholder = nullptr;
+
+        //Pixel buffer ring
+        GLuint PBO = 0;
+        uint8_t* Mapped = nullptr;
+        GLsync SegmentFences[3] = {0, 0, 0};
+        size_t SegmentSize = 0;
+        int Segment = 0;
+        size_t SegmentUsed = 0;
+
+    protected:
+        int Upload(TextureStreamRequest Request);
+        int Decode(Texture2D* texture); //Queues the texture's file on the worker pool
+
+    public:
+        size_t UploadBudget; //!< Bytes uploaded per frame (At least one texture is always uploaded)
+
+    public:
+        TextureStreamer(size_t UploadBudget = 8 * 1024 * 1024);
+        ~TextureStreamer();
+
+    public:
+        Texture2D* Request(std::string FilePath);
+        Texture2D* CheckInFlight(std::string FilePath);
+        int Reload(Texture2D* texture); //Streams an evicted texture back in
+
+        int ShowPlaceholder(Texture2D* texture); //Points the texture at the placeholder's space
+
+        int Update(); //Call once per frame on the GL thread
+        int Finish(Texture2D* texture); //Blocks until the texture is decoded and uploads it now
+        int Cancel(Texture2D* texture); //Stops streaming a texture about to be deleted, blocks until its decode is done
+
+        inline size_t Pending(){return this->InFlight.size();}
+    };
+
+    extern TextureStreamer* __GLOBAL_TEXTURE_STREAMER;
+
+    //Returns straight away, the texture shows a placeholder until it has streamed in
+    Texture2D* LoadTextureAsync(std::string FilePath);
+} // namespace UnifiedEngine
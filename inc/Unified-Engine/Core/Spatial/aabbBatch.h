@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Unified-Engine/Objects/Mesh/mesh.h>
+#include <Unified-Engine/Core/Rendering/frustum.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace UnifiedEngine
+{
+    /**
+     * @brief Boxes kept as six float arrays (Structure of arrays) so a query is tested against 8 boxes at once with AVX2,
+     *        4 with SSE2 or NEON, and one at a time otherwise. The kernel is picked at runtime like the other SIMD paths.
+     *        Every test gives the same answer as the matching AABB or Frustum function.
+     *
+     *        Tests take any [Begin, End) range and write the index of each box that passes to Hits, which needs room for
+     *        End - Begin indices, returning how many were written.
+     *
+     */
+    class AABBBatch{
+    protected:
+        std::vector<float> MinX = {};
+        std::vector<float> MinY = {};
+        std::vector<float> MinZ = {};
+        std::vector<float> MaxX = {};
+        std::vector<float> MaxY = {};
+        std::vector<float> MaxZ = {};
+
+    public:
+        AABBBatch();
+        AABBBatch(const std::vector<AABB>& Boxes);
+        ~AABBBatch();
+
+    public:
+        void Clear();
+        void Reserve(size_t Count);
+
+        size_t Add(const AABB& Box); //Returns its index
+        void Set(size_t Index, const AABB& Box);
+        void RemoveSwap(size_t Index); //The last box takes its place
+        AABB Get(size_t Index) const;
+
+        inline size_t Count() const {return this->MinX.size();}
+
+    public: //Tests
+        size_t Overlaps(const AABB& Query, size_t Begin, size_t End, uint32_t* Hits) const;
+        size_t RayHits(const glm::vec3& Origin, const glm::vec3& InverseDirection, float MaxDistance, size_t Begin, size_t End, uint32_t* Hits, float* Distances) const; //Distances is filled beside Hits
+        size_t Visible(const Frustum& frustum, size_t Begin, size_t End, uint32_t* Hits) const;
+    };
+} // namespace UnifiedEngine
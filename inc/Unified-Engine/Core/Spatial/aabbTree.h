@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Unified-Engine/Core/Rendering/frustum.h>
+#include <Unified-Engine/Objects/Mesh/mesh.h>
+#include <functional>
+#include <vector>
+#include <cstddef>
+
+namespace UnifiedEngine
+{
+    struct AABBTreeNode{
+        AABB Box; //Fattened for leaves
+        void* Data = nullptr;
+        int Parent = -1; //Next free node while on the free list
+        int Child1 = -1;
+        int Child2 = -1;
+        int Height = -1; //0 for leaves, -1 when free
+
+        inline bool IsLeaf() const {return this->Child1 == -1;}
+    };
+
+    //Callbacks get the proxy (Or item index for BVH), returning false from an overlap callback stops the query
+    typedef std::function<bool(int Proxy)> SpatialQueryCallback;
+
+    //Ray callbacks return the new maximum distance, MaxDistance to carry on, less to clip or 0 to stop
+    typedef std::function<float(int Proxy, float MaxDistance)> SpatialRayCallback;
+
+    /**
+     * @brief Dynamic bounding volume tree (As in Box2D's b2DynamicTree), leaves hold proxies with a fat AABB
+     *        so small moves do not touch the tree. Inserts pick the sibling with the least added area and
+     *        rotate on the way back up to keep it balanced.
+     *
+     *        __GLOBAL_SCENE_TREE holds every GameObject with a mesh, GameObjects keep their own proxy moved.
+     *
+     */
+    class AABBTree{
+    protected:
+        std::vector<AABBTreeNode> Nodes = {};
+        int Root = -1;
+        int FreeList = -1;
+        size_t Proxies = 0;
+
+    public:
+        float Margin; //!< Added to every side of a proxy's box
+        float Prediction; //!< Displacement multiplier the box is stretched by in the direction of movement
+
+    public:
+        AABBTree(float Margin = 0.1f, float Prediction = 2.f);
+        ~AABBTree();
+
+    public:
+        int CreateProxy(const AABB& Box, void* Data);
+        int DestroyProxy(int Proxy);
+
+        //Only re-inserts when the box left its fat box, returns true when it did
+        bool MoveProxy(int Proxy, const AABB& Box, const glm::vec3& Displacement = glm::vec3(0.f));
+
+        inline const AABB& FatBox(int Proxy) const {return this->Nodes[Proxy].Box;}
+        inline void* Data(int Proxy) const {return this->Nodes[Proxy].Data;}
+
+        inline size_t Count() const {return this->Proxies;}
+        inline int Height() const {return (this->Root == -1) ? 0 : this->Nodes[this->Root].Height;}
+
+    public: //Queries
+        void Query(const AABB& Box, const SpatialQueryCallback& Callback) const;
+        void Query(const Frustum& frustum, const SpatialQueryCallback& Callback) const;
+        void RayCast(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, const SpatialRayCallback& Callback) const; //Direction normalised
+
+        //Up to K proxies closest to Point (By distance to their box), nearest first
+        void Nearest(const glm::vec3& Point, size_t K, std::vector<int>& Out) const;
+
+    protected:
+        int AllocateNode();
+        void FreeNode(int Node);
+
+        void InsertLeaf(int Leaf);
+        void RemoveLeaf(int Leaf);
+        int Balance(int Node);
+    };
+
+    extern AABBTree* __GLOBAL_SCENE_TREE;
+} // namespace UnifiedEngine
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Unified-Engine/Core/Spatial/aabbTree.h>
+#include <Unified-Engine/Core/Spatial/aabbBatch.h>
+#include <GLM/mat3x3.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace UnifiedEngine
+{
+    //Gets an item of each hierarchy, returning false stops the query
+    typedef std::function<bool(int Item, int OtherItem)> SpatialPairCallback;
+
+    struct BVHNode{
+        AABB Box;
+        uint32_t First; //First item for leaves, right child for inner nodes (The left child is the next node)
+        uint32_t Count; //Items in a leaf, 0 for inner nodes
+    };
+
+    /**
+     * @brief Static bounding volume hierarchy built once with a binned surface area heuristic, for things
+     *        that never move (Baked scenery, static batches). Nodes are laid out depth first in one array.
+     *        Queries give the index of the box in the array it was built from, same callbacks as AABBTree.
+     *        Leaf boxes are also kept in Items order as an AABBBatch, so a whole leaf is tested with one SIMD call.
+     *
+     */
+    class BVH{
+    protected:
+        std::vector<BVHNode> Nodes = {};
+        std::vector<uint32_t> Items = {}; //Leaf ranges index into this
+        std::vector<AABB> Boxes = {};
+        AABBBatch LeafBoxes; //Boxes[Items[i]] at i
+
+    public:
+        unsigned LeafSize = 4; //!< Most items a leaf holds when splitting stops paying off
+
+    public:
+        BVH();
+        BVH(const std::vector<AABB>& Boxes);
+        ~BVH();
+
+    public:
+        int Build(const std::vector<AABB>& Boxes);
+        void Clear();
+
+        inline size_t Count() const {return this->Boxes.size();}
+        inline const AABB& Box(int Item) const {return this->Boxes[Item];}
+
+    public: //Queries
+        void Query(const AABB& Box, const SpatialQueryCallback& Callback) const;
+        void Query(const Frustum& frustum, const SpatialQueryCallback& Callback) const;
+        void RayCast(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, const SpatialRayCallback& Callback) const; //Direction normalised
+        void Nearest(const glm::vec3& Point, size_t K, std::vector<int>& Out) const;
+
+        //Items of both hierarchies whose boxes overlap, walking both at once. Other's boxes are moved into this one's
+        //space by Linear * p + Translation first (Grown to stay axis aligned, so a few extra pairs can come through)
+        void QueryPairs(const BVH& Other, const glm::mat3& Linear, const glm::vec3& Translation, const SpatialPairCallback& Callback) const;
+
+    protected:
+        void Split(uint32_t Node, const std::vector<glm::vec3>& Centers);
+    };
+} // namespace UnifiedEngine
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Unified-Engine/Core/Spatial/aabbTree.h>
+#include <Unified-Engine/Core/Spatial/bvh.h>
+#include <Unified-Engine/Core/Physics/sweepAndPrune.h>
+#include <functional>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace UnifiedEngine
+{
+    //Box of a proxy's object as it is now, read during a Rebuild
+    typedef std::function<AABB(int Proxy, void* Data)> SpatialBoxCallback;
+
+    struct SpatialHashProxy{
+        AABB Box;
+        void* Data = nullptr;
+        int Cell[3] = {0, 0, 0};
+        int Bucket = -1; //BucketCount() for the large list, -1 while free
+        int Next = -1; //In its bucket, or the next free proxy
+        int Previous = -1;
+    };
+
+    /**
+     * @brief Uniform grid hashed into a fixed number of buckets, for many similar sized objects that all move (Crowds,
+     *        swarms, debris) where a tree would be re-inserting every frame. A proxy lives in the one cell holding its
+     *        box's centre, linked into that cell's bucket, so creating, moving and destroying are O(1). Queries look at
+     *        the cells around the box grown by the largest small proxy's half size, at most half a cell, which catches
+     *        every proxy no bigger than a cell; bigger ones are kept on a separate list every query checks.
+     *
+     *        Proxies, queries and callbacks work like AABBTree's. Update and Pairs match SweepAndPrune so it can stand in
+     *        as a broadphase. Rebuild relinks every proxy at once over the worker pool, cheaper than moving each one
+     *        when nearly everything moved, and grows the buckets to keep about two per proxy.
+     *
+     *        Proxies come out of a bucket in no set order.
+     *
+     */
+    class SpatialHashGrid{
+    protected:
+        float CellSize;
+        float InverseCellSize;
+        float Reach = 0.f; //Largest half size of a small proxy since the last Rebuild, how far queries look past a box
+
+        std::vector<SpatialHashProxy> Proxies = {};
+        std::vector<int> Heads = {}; //First proxy of each bucket, the large list last
+        int FreeList = -1;
+        size_t Live = 0;
+
+        std::vector<BroadphasePair> PairList = {};
+        std::vector<std::vector<BroadphasePair>> ChunkPairs = {}; //Each Update job's pairs, joined in order after
+
+    public:
+        SpatialHashGrid(float CellSize = 2.f, size_t Buckets = 4096);
+        ~SpatialHashGrid();
+
+    public:
+        int CreateProxy(const AABB& Box, void* Data);
+        int DestroyProxy(int Proxy);
+
+        //Only relinks when the centre crossed into another cell, returns true when it did
+        bool MoveProxy(int Proxy, const AABB& Box);
+
+        //Every proxy relinked from its box (Or BoxOf's, when given), in parallel
+        int Rebuild(const SpatialBoxCallback& BoxOf = nullptr);
+
+        //Changes the cell size, relinking everything
+        int SetCellSize(float Size);
+
+        inline float GetCellSize() const {return this->CellSize;}
+        inline size_t BucketCount() const {return this->Heads.size() - 1;}
+
+        inline const AABB& Box(int Proxy) const {return this->Proxies[Proxy].Box;}
+        inline void* Data(int Proxy) const {return this->Proxies[Proxy].Data;}
+        inline size_t Count() const {return this->Live;}
+
+    public: //Queries
+        void Query(const AABB& Box, const SpatialQueryCallback& Callback) const;
+        void Query(const glm::vec3& Center, float Radius, const SpatialQueryCallback& Callback) const; //Boxes touching the sphere
+
+        //Every overlapping pair once, lower proxy first
+        void QueryPairs(const SpatialPairCallback& Callback) const;
+
+    public: //Broadphase
+        int Update(); //Finds every overlapping pair, split over the worker pool
+
+        inline const std::vector<BroadphasePair>& Pairs() const {return this->PairList;}
+
+    protected:
+        int CellOf(float Value) const;
+        int BucketOf(const int* Cell) const;
+        int Locate(const AABB& Box, int* Cell) const; //Bucket of its centre's cell, or the large list
+
+        void Link(int Proxy);
+        void Unlink(int Proxy);
+
+        //Proxies overlapping Box, small ones only above SmallAfter and large ones only above LargeAfter. False when stopped
+        bool Visit(const AABB& Box, int SmallAfter, int LargeAfter, const SpatialQueryCallback& Callback) const;
+
+        //Pairs a small proxy finds with the small ones above it, a large one with every small one and the large ones above it
+        bool VisitPairs(int Proxy, const SpatialPairCallback& Callback) const;
+    };
+} // namespace UnifiedEngine
@@ -1,11 +1,43 @@
 #pragma once
 
+#include <Unified-Engine/Core/Rendering/textureCompression.h>
+#include <Unified-Engine/Core/Rendering/mipBuilder.h>
+#include <cstddef>
+
 namespace UnifiedEngine
 {
     struct GlobalConfig{
         //OpenGL
         unsigned char VersionMajor = 3;
         unsigned char VersionMinor = 3;
+
+        //Textures
+        bool TextureAtlasArray = false; //Store atlas pages as layers of one GL_TEXTURE_2D_ARRAY (Needs a sampler2DArray shader)
+        TextureCompression AtlasCompression = TEXTURE_COMPRESSION_NONE; //Block compress atlas pages on the CPU (Keeps an RGBA copy of each page in memory)
+        bool AtlasCPUMips = false; //Build atlas mips on the CPU for only the changed texels instead of glGenerateMipmap over whole pages (Keeps an RGBA copy of each page's mips)
+        MipSettings AtlasMips = {}; //Filtering used when AtlasCPUMips is set
+        size_t TextureBudget = 0; //Bytes of atlas pages on the GPU before the pages of the least recently used textures are evicted (0 never evicts)
+        unsigned TextureEvictionFrames = 120; //Frames a texture must go unbound before it can be evicted
+
+        //Meshes
+        float LODPixelError = 1.f; //Most an LOD's error may cover on screen, in pixels, before a finer LOD is drawn
+        float LODHysteresis = 0.25f; //Fraction under LODPixelError a coarser LOD needs before switching down, stops popping at the boundary
+        float StaticBatchCellSize = 64.f; //World size of the grid static objects are batched and culled by
+
+        //Spatial
+        float SceneTreeMargin = 0.1f; //Slack around every object's box in the scene tree, bigger means fewer re-inserts but looser queries
+
+        //Physics
+        unsigned PhysicsIterations = 8; //Contact solver passes per step, more settles stacks better at a linear cost
+        float PhysicsSleepVelocity = 0.1f; //Bodies slower than this, linear and angular, count as resting
+        float PhysicsSleepTime = 0.5f; //Seconds a whole island has to rest before it sleeps (0 never sleeps)
+        unsigned PhysicsBulletSubsteps = 4; //Hits a bullet body can stop at in one step
+        bool PhysicsDeterministic = false; //Step physics at PhysicsFixedTimeStep in a fixed order so runs and replays match bit for bit
+        float PhysicsFixedTimeStep = 1.f / 60.f; //Seconds per physics step when deterministic
+        unsigned PhysicsMaxStepsPerFrame = 4; //Deterministic steps one frame may take before the rest of its time is dropped
+
+        //Debug
+        unsigned ProfilerReportFrames = 0; //Logs the profiler's section averages every this many frames (0 never)
     };
 
     //Modifiable Config (Refain from modifying after init)
@@ -11,9 +11,13 @@
 #include <Unified-Engine/input/input.h>
 #include <Unified-Engine/Objects/skybox.h>
 #include <Unified-Engine/Debug/Debugger.h>
+#include <Unified-Engine/Core/Physics/sceneQuery.h>
+#include <vector>
 
 namespace UnifiedEngine
 {
+    struct OrientedBox;
+
     int __INIT__ENGINE();
 
     class GameInstance{
@@ -70,6 +74,14 @@ namespace UnifiedEngine
         std::list<GameObject*> GetGameObjectsWithTag(std::string tag);
         Camera* GetMainCamera();
 
+    public: //Physics Queries, against every collider in the physics world (See PhysicsWorld), nothing is hit without one
+        bool Raycast(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, RaycastHit& Hit, uint32_t LayerMask = ALL_LAYERS);
+        size_t RaycastAll(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, std::vector<RaycastHit>& Hits, uint32_t LayerMask = ALL_LAYERS);
+        bool SphereCast(const glm::vec3& Origin, float Radius, const glm::vec3& Direction, float MaxDistance, RaycastHit& Hit, uint32_t LayerMask = ALL_LAYERS);
+        size_t OverlapBox(const OrientedBox& Box, std::vector<Collider*>& Out, uint32_t LayerMask = ALL_LAYERS);
+        size_t OverlapSphere(const glm::vec3& Center, float Radius, std::vector<Collider*>& Out, uint32_t LayerMask = ALL_LAYERS);
+        void RaycastBatch(const RayQuery* Rays, size_t Count, RaycastHit* Hits, uint32_t LayerMask = ALL_LAYERS);
+
     private:
         int RecuseSearchChild(int Setting, bool multi, void* resultstore, std::list<ObjectComponent*>* StartingPoint, void* argument = nullptr);
     };
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace UnifiedEngine
+{
+    /**
+     * @brief Fixed set of worker threads that run submitted jobs in order of submission.
+     *        Jobs must not touch OpenGL, anything GL related has to be handed back to the main thread.
+     * 
+     */
+    class ThreadPool{
+    protected:
+        std::vector<std::thread> Workers = {};
+        std::deque<std::function<void()>> Jobs = {};
+
+        std::mutex JobLock;
+        std::condition_variable JobSignal;
+        std::condition_variable IdleSignal;
+
+        int ActiveJobs = 0;
+        bool Stopping = false;
+
+    protected:
+        void WorkerLoop();
+
+    public:
+        ThreadPool(unsigned int WorkerCount = 0); //0 = One less than the hardware threads
+        ~ThreadPool();
+
+    public:
+        int Submit(std::function<void()> Job);
+        int Wait(); //Blocks until every submitted job has finished
+
+        //Splits [0, Count) into Grain sized ranges run across the workers and the calling thread, returns once all are done
+        int ParallelFor(size_t Count, size_t Grain, const std::function<void(size_t Begin, size_t End)>& Job);
+
+        inline unsigned int WorkerCount(){return this->Workers.size();}
+    };
+
+    extern ThreadPool* __GLOBAL_THREAD_POOL;
+} // namespace UnifiedEngine
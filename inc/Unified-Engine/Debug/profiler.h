@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace UnifiedEngine
+{
+    namespace Debug
+    {
+        struct ProfileSection{
+            const char* Name;
+            double Milliseconds = 0.0; //Over the last frame
+            double Average = 0.0; //Smoothed over recent frames
+            uint64_t Calls = 0; //Over the last frame
+
+            double Running = 0.0;
+            uint64_t RunningCalls = 0;
+        };
+
+        /**
+         * @brief Per frame CPU timings of named sections, only for the main thread. Sections are found by their name's
+         *        pointer so names should be string literals. Use a ProfileScope to time a block.
+         *
+         */
+        class Profiler{
+        protected:
+            std::vector<ProfileSection> SectionList = {};
+
+        public:
+            bool Enabled = true;
+
+        public:
+            int Section(const char* Name); //Index of the section, made on first use
+            void Add(int Section, double Milliseconds);
+
+            //Moves this frame's totals into Milliseconds/Average and starts the next
+            void Frame();
+
+            void Report(); //Logs every section's average
+
+            inline const std::vector<ProfileSection>& Sections() const {return this->SectionList;}
+            const ProfileSection* Find(const char* Name) const;
+        };
+
+        extern Profiler __GLOBAL_PROFILER;
+
+        class ProfileScope{
+        protected:
+            int Index;
+            std::chrono::steady_clock::time_point Start;
+
+        public:
+            ProfileScope(const char* Name) : Index(__GLOBAL_PROFILER.Enabled ? __GLOBAL_PROFILER.Section(Name) : -1), Start(std::chrono::steady_clock::now()) {}
+            ~ProfileScope(){
+                if(this->Index >= 0)
+                    __GLOBAL_PROFILER.Add(this->Index, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - this->Start).count());
+            }
+        };
+    } // namespace Debug
+} // namespace UnifiedEngine
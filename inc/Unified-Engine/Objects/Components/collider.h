@@ -3,6 +3,8 @@
 #include <Unified-Engine/Objects/objectComponent.h>
 #include <GLM/vec3.hpp>
 #include <Unified-Engine/Objects/Mesh/mesh.h>
+#include <GLM/mat3x3.hpp>
+#include <Unified-Engine/Core/Physics/triangleMesh.h>
 
 namespace UnifiedEngine
 {
@@ -14,23 +16,53 @@ namespace UnifiedEngine
 
     class BoxCollider;
     class SphericalCollider;
+    class MeshCollider;
+    class RigidBody;
+
+    //Box in world space, Axes are its unit local axes as columns
+    struct OrientedBox{
+        glm::vec3 Center;
+        glm::mat3 Axes;
+        glm::vec3 HalfSize;
+    };
 
     class Collider : public ObjectComponent{
+        friend class PhysicsWorld;
     public: //CollisionChecks
         Collider(ObjectComponent* Parent, ColliderType CType) : ObjectComponent(Parent, OBJECT_COLLIDER, true), Type(CType){}
+        ~Collider();
 
     public:
         glm::vec3 Offset = glm::vec3(0.0f);
+        unsigned Layer = 0; //!< 0 to 31, scene queries only see it when this bit is in their LayerMask
+        bool IsTrigger = false; //!< Only reports overlaps (OnTrigger events), never pushes or is pushed
     protected:
         const ColliderType Type;
+
+        int Proxy = -1; //In __GLOBAL_PHYSICS_WORLD's broadphase
+        int QueryProxy = -1; //In its query tree
+        RigidBody* Body = nullptr; //The parent's, found as it joins the world (Null for static geometry)
+
+    public:
+        inline ColliderType GetType() const {return this->Type;}
+        inline RigidBody* GetBody() const {return this->Body;}
+
+        virtual AABB WorldBounds(); //Box around the shape after the parent's transform, empty without a shape
+        int ReleasePhysics(); //Leaves the physics world (destroy does this), it is added back on the next update
+
+    public:
+        int Update() override; //Keeps its broadphase proxy current
     };
 
     class BoxCollider : public Collider{
     public:
-        AABB* BoundingBox = nullptr;
+        AABB* BoundingBox = nullptr; //!< In the parent's local space, the parent's mesh bounds when null
     public:
         BoxCollider(ObjectComponent* Parent, AABB* BB) : Collider(Parent, COLLIDER_BOX), BoundingBox(BB) {};
 
+        AABB WorldBounds() override;
+        bool WorldBox(OrientedBox& Out); //False without a box
+
         bool operator^(const UnifiedEngine::BoxCollider& other) const {
             // Perform collision detection logic here
             if (!BoundingBox || !other.BoundingBox) return false;
@@ -46,17 +78,43 @@ namespace UnifiedEngine
         }
     };
 
-    // class SphericalCollider : public Collider{
-    // public:
-    //     float Radius = 0.0f;
-    // };
+    class SphericalCollider : public Collider{
+    public:
+        float Radius = 0.5f; //!< In the parent's local space, scaled by its largest scale axis
+    public:
+        SphericalCollider(ObjectComponent* Parent, float R) : Collider(Parent, COLLIDER_SPHERE), Radius(R) {};
+
+        AABB WorldBounds() override;
+        void WorldSphere(glm::vec3& Center, float& WorldRadius);
+    };
+
+    /**
+     * @brief Collides with the triangles of a mesh, kept with their own BVH (See TriangleMesh) so contacts only test
+     *        the triangles near the other shape. Triangles are two sided and the shape is moved by the parent's
+     *        transform, scale included. Meant for static scenery, a rigid body on it is given the inertia of its bounds.
+     *
+     */
+    class MeshCollider : public Collider{
+    public:
+        Mesh* SourceMesh = nullptr; //!< In the parent's local space, the parent's mesh when null (Empty for meshes uploaded from a MeshFile)
+    protected:
+        TriangleMesh Shape;
+
+        //What the last build was from, an empty shape is only built again once this changes
+        const Mesh* Attempted = nullptr;
+        size_t AttemptedVertices = 0;
+        size_t AttemptedIndices = 0;
 
-    // class MeshCollider : public Collider{
-    // public:
-    //     MeshCollider() {}
+        const Mesh* FindMesh(); //SourceMesh or the parent's
+    public:
+        MeshCollider(ObjectComponent* Parent, Mesh* M = nullptr) : Collider(Parent, COLLIDER_MESH), SourceMesh(M) {};
 
-    //     Mesh* mesh = nullptr;
+        AABB WorldBounds() override;
+        void WorldTransform(glm::mat3& Linear, glm::vec3& Translation); //World = Linear * local + Translation
 
-    //     bool intersects(MeshCollider* Other);
-    // };
+        const TriangleMesh& GetShape(); //Built from the mesh on first use
+        int Rebuild(); //After the mesh's vertices or indices change, -1 without a triangle
+
+        bool Intersects(MeshCollider* Other); //Any triangle of one touching any of the other
+    };
 } // namespace UnifiedEngine
@@ -2,37 +2,66 @@
 
 #include <Unified-Engine/Objects/objectComponent.h>
 #include <GLM/vec3.hpp>
+#include <GLM/mat3x3.hpp>
 
 namespace UnifiedEngine
 {
     class Collider;
 
     class RigidBody : public ObjectComponent{
+        friend class PhysicsWorld;
     public:
         //Movement
-        //TODO: Rotation Locks and Movement Locks
-        glm::vec3 PositionLock = glm::vec3(1.0);
-        glm::vec3 RotationLock = glm::vec3(1.0);
+        glm::vec3 PositionLock = glm::vec3(1.0); //!< 0 on an axis stops contacts and forces moving it
+        glm::vec3 RotationLock = glm::vec3(1.0); //!< 0 on an axis stops contacts spinning it
 
-        int Mass = 1;
-        double Gravity = -9.8;
-        int FrictionLevel = 0;
+        int Mass = 1; //!< 0 or less never reacts to contacts or gravity, only moves by its Velocity
+        float Gravity = -9.8f;
+        int FrictionLevel = 5; //!< Contact friction in tenths (5 is a coefficient of 0.5)
+        float Restitution = 0.f; //!< Bounciness of contacts, 0 to 1
         glm::vec3 DragFactor = glm::vec3(10, 1, 10);
+        float AngularDrag = 0.05f;
 
         glm::vec3 Acceleration = glm::vec3(0.0);
         glm::vec3 Velocity = glm::vec3(0.0);
+        glm::vec3 AngularVelocity = glm::vec3(0.0); //!< World space, radians per second
 
         bool Friction = true;
         bool UseGravity = true;
+        bool CanSleep = true; //!< Lets the world stop stepping it while it rests
+        bool Bullet = false; //!< Swept along its motion each step so it can't pass through thin colliders, for fast and small bodies
+
+    protected:
+        int SolverIndex = -1; //In __GLOBAL_PHYSICS_WORLD
+        glm::vec3 LocalInverseInertia = glm::vec3(0.0); //About the parent's axes, from its first collider
+
+        //Sleeping
+        bool Sleeping = false;
+        float SleepTimer = 0.f; //Seconds spent under the world's SleepVelocity
+        glm::vec3 SleepPosition = glm::vec3(0.0); //Moving it by hand while asleep wakes it
 
     public:
         RigidBody(ObjectComponent* parent); //Ensure Seupt As Component Not Child
         ~RigidBody();
 
     public:
-        int Update();
+        int Update(); //Joins the physics world, which steps it (Integrates itself without one)
         int Render();
 
+        int ReleasePhysics(); //Leaves the physics world (destroy does this), it is added back on the next update
+
+        int Wake(); //Setting a Velocity or Acceleration, or moving it, also wakes it
+        inline bool IsSleeping() const {return this->Sleeping;}
+
+    public: //Stepping
+        int IntegrateVelocity(float DeltaTime); //Gravity, acceleration and drag
+        int IntegratePosition(float DeltaTime);
+
+        float FrictionCoefficient() const;
+        glm::vec3 InverseMass() const; //Per world axis
+        glm::mat3 InverseInertia(); //World space
+        int UpdateMassProperties(); //Inertia from the first collider's shape
+
     protected:
         int CheckIfCollided(Collider* collider1, Collider* collider2);
     };
@@ -1,13 +1,30 @@
 #pragma once
 
 #include <GLM/vec2.hpp>
+#include <GLM/vec4.hpp>
 #include <Unified-Engine/includeGL.h>
+#include <Unified-Engine/Core/Rendering/textureCompression.h>
 #include <list>
+#include <vector>
 #include <string>
+#include <unordered_map>
 
 namespace UnifiedEngine
 {
     class Texture2D;
+    class TextureStreamer;
+    class TexturePack;
+    class TextureResidency;
+
+    enum TextureState{
+        TEXTURE_PENDING = 0, //Showing the placeholder while the data streams in
+        TEXTURE_READY,
+        TEXTURE_FAILED,
+        TEXTURE_EVICTED //Space was given back to the atlas, reloaded from its file or pack when next bound
+    };
+
+    //Width and height of every atlas page (or array layer)
+    constexpr int ATLAS_PAGE_SIZE = 4096;
 
     struct TextureUVs{
         glm::vec2 UV[4];
@@ -39,50 +56,136 @@ namespace UnifiedEngine
     
     class TextureAtlas{
         friend Texture2D;
+        friend TextureStreamer;
+        friend TexturePack;
+        friend TextureResidency;
     protected:
-        std::list<GLuint> TextureIdentifiers;
+        //Indexed by page (0 once a page has been released)
+        std::vector<GLuint> TextureIdentifiers;
+
+        std::vector<std::list<Atlas_Space_Identifier>> SpaceIdentifiers;
+        std::vector<std::list<Atlas_Texture_Identifier>> Texture2DIdentifiers;
 
-        std::list<std::list<Atlas_Space_Identifier>> SpaceIdentifiers;
-        std::list<std::list<Atlas_Texture_Identifier>> Texture2DIdentifiers;
+        //Canonical file path -> texture for constant time de-duplication
+        std::unordered_map<std::string, Texture2D*> Textures;
 
         GLuint Bound = 0;
 
+        //GL_TEXTURE_2D for seperate pages, GL_TEXTURE_2D_ARRAY when pages are layers
+        const GLenum Target = GL_TEXTURE_2D;
+
+        //Compressed or CPU mipped pages are edited in an RGBA copy and uploaded by Flush()
+        TextureCompression Compression = TEXTURE_COMPRESSION_NONE;
+        bool CPUMips = false;
+        int MipLevels = 1; //Levels held in each page copy (See MipChainOffset)
+        std::vector<std::vector<uint8_t>> PageShadows;
+        std::vector<glm::ivec4> PageDirty; //Min x, min y, max x, max y of the top level changes (Empty when max <= min)
+
+        std::vector<uint8_t> PageLocked; //Cooked pages keep their layout, freed space is not handed out again
+        std::vector<uint32_t> PageGenerations; //Bumped whenever a page is emptied so packs know to upload it again
+
     protected:
         Atlas_Image_Location FindAvailableSpace(glm::ivec2 size);
+        int PlaceImage(Texture2D* image, Atlas_Image_Location& Location); //Reserves space and sets UVs without uploading
+        int PlaceImageAt(Texture2D* image, int Page, glm::ivec2 Position); //Records an image at a known spot (Space must already be taken)
         int CopyImageData(GLuint Dest, GLuint Src, glm::ivec2 Position, glm::ivec2 Size);
-        int CopyImageData(GLuint Dest, uint8_t* Src, glm::ivec2 Position, glm::ivec2 Size);
-        GLuint CreateNewImage();
+        virtual int CopyImageData(GLuint Dest, int Layer, uint8_t* Src, glm::ivec2 Position, glm::ivec2 Size);
+        virtual GLuint CreateNewImage();
+        virtual int AddPage(); //Returns the new page index or -1
+        virtual int ReleasePage(int Page); //Called once the last texture has left a page
+        int FreeSpace(Texture2D* image); //Gives the texture's rectangle back without forgetting its path
+        int UploadLevel(int Page, int Level, const uint8_t* Src); //Replaces a whole mip level of a page
+
+        inline bool UsesShadow(){return this->Compression || this->CPUMips;}
+        int AddPageShadow(int Page);
+        int CopyToShadow(int Page, const uint8_t* Src, glm::ivec2 Position, glm::ivec2 Size);
+        int UploadShadow(int Page, int Level, glm::ivec4 Region); //Sends part of a level from the page copy (Encoding it when compressed)
+        virtual int UploadRegion(int Page, int Level, glm::ivec2 Position, glm::ivec2 Size, const uint8_t* Src, int RowLength);
+        virtual int UploadBlocks(int Page, int Level, glm::ivec2 Position, glm::ivec2 Size, const uint8_t* Blocks);
+
+        TextureAtlas(GLenum Target); //For backends that create their own pages
     
     public:
         TextureAtlas();
-        ~TextureAtlas();
+        virtual ~TextureAtlas();
 
     public:
         int AddImage(Texture2D* image);
         int RemoveImage(Texture2D* image);
 
-        int Toggle(Texture2D* image);
+        virtual int Toggle(Texture2D* image);
+
+        int Flush(); //Rebuilds mips/re-encodes and uploads the changed parts of shadowed pages, call on the GL thread before drawing
+
+        size_t TextureBytes(int width, int height); //Page memory a texture of this size takes up (Including its share of the mips)
+        virtual size_t PageBytes(); //Memory held by the live pages
+        virtual bool ReleasesPages(){return true;} //Whether emptying a page gives its memory back
 
         Texture2D* CheckExists(std::string FilePath);
     };
 
+    /**
+     * @brief Atlas backend that stores every page as a layer of one GL_TEXTURE_2D_ARRAY.
+     *        The whole atlas is a single texture so it only needs binding once, textures
+     *        are selected in the shader with their Layer (sampler2DArray + "TextureLayer").
+     * 
+     */
+    class TextureArrayAtlas : public TextureAtlas{
+    protected:
+        GLuint ArrayID = 0;
+        int LayerCapacity = 0;
+
+    protected:
+        int CopyImageData(GLuint Dest, int Layer, uint8_t* Src, glm::ivec2 Position, glm::ivec2 Size) override;
+        GLuint CreateNewImage() override;
+        int AddPage() override;
+        int ReleasePage(int Page) override;
+        int UploadRegion(int Page, int Level, glm::ivec2 Position, glm::ivec2 Size, const uint8_t* Src, int RowLength) override;
+        int UploadBlocks(int Page, int Level, glm::ivec2 Position, glm::ivec2 Size, const uint8_t* Blocks) override;
+
+    public:
+        TextureArrayAtlas(int InitialLayers = 2);
+        ~TextureArrayAtlas();
+
+    public:
+        int Toggle(Texture2D* image) override;
+
+        size_t PageBytes() override;
+        bool ReleasesPages() override {return false;}
+    };
+
     //TODO: if no atlas return faults on attempts to load texture
     extern TextureAtlas* __GLOBAL_ATLAS;
 
     class Texture2D{
         friend TextureAtlas;
+        friend TextureStreamer;
+        friend TexturePack;
+        friend TextureResidency;
     protected:
         std::string FilePath;
-        uint8_t* Data;
+        uint8_t* Data; //Only set while the pixels are being handed to the atlas, never owned
 
         int width;
         int height;
 
+        //Residency (See TextureResidency)
+        std::list<Texture2D*>::iterator ResidencyEntry;
+        bool Resident = false;
+        uint64_t LastUsed = 0;
+
+        Texture2D(); //Empty texture for streaming into
+
     public:
         TextureUVs UVs;
         const TextureUVs& UVsr; // TODO MOVE TO PROTECTED
         const GLuint& TextID;
         GLuint TextureID;
+        int Page = -1; //!< Index of the atlas page holding this texture (TextureID is that page's handle)
+        int Layer = 0; //!< Layer of the array atlas holding this texture (Always 0 for 2D pages)
+        TextureState State = TEXTURE_PENDING;
+        GLint Unit = 0; //!< Sampler unit the page was last bound to (Sent as the "Texture" uniform)
+        bool Pinned = false; //!< Never evicted (Textures without a file path are always pinned)
 
     public:
         Texture2D(std::string FilePath);
@@ -101,6 +204,8 @@ namespace UnifiedEngine
         void operator=(TextureAtlas* Atlas);
     };
 
+    std::string GetFullPath(const std::string& filePath);
+
     Texture2D* LoadTexture(std::string FilePath);
 
 } // namespace UnifiedEngine
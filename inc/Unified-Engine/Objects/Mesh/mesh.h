@@ -2,9 +2,14 @@
 
 #include <Unified-Engine/includeGL.h>
 #include <vector>
+#include <cstdint>
+#include <utility>
+#include <optional>
 #include <GLM/vec2.hpp>
 #include <GLM/vec3.hpp>
+#include <GLM/mat3x3.hpp>
 #include <float.h>
+#include <cmath>
 #include <glm/common.hpp>
 
 namespace UnifiedEngine
@@ -19,6 +24,22 @@ namespace UnifiedEngine
 		glm::vec3 normal = {0, 0, 0};
 	};
 
+	//How a mesh's vertices are stored on the GPU, chosen per mesh
+	enum VertexLayout{
+		VERTEX_LAYOUT_FULL = 0, //Vertex as is, 44 bytes
+		VERTEX_LAYOUT_COMPACT, //CompactVertex with 16 bit positions quantized to the mesh bounds, 20 bytes
+		VERTEX_LAYOUT_COMPACT_HALF //CompactVertex with half float positions (No bounds needed, less precise away from the origin), 20 bytes
+	};
+
+	//Compressed vertex for static geometry, the standard shaders decode it (See "VertexLayout", "MeshOffset" and "MeshScale")
+	struct CompactVertex
+	{
+		uint16_t position[4]; //Unorm16 within the bounds or half float, w is padding
+		uint8_t color[4]; //RGBA8, colour is clamped to [0, 1]
+		uint16_t uv[2]; //Half float
+		int16_t normal[2]; //Octahedral, snorm16
+	};
+
 	// Helper struct for AABB (Axis-Aligned Bounding Box)
     struct AABB
     {
@@ -39,9 +60,93 @@ namespace UnifiedEngine
                    (min.y <= other->max.y && max.y >= other->min.y) &&
                    (min.z <= other->max.z && max.z >= other->min.z);
         }
+
+        inline void merge(const AABB& other)
+        {
+            min = glm::min(min, other.min);
+            max = glm::max(max, other.max);
+        }
+
+        inline bool contains(const AABB& other) const
+        {
+            return (min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z) &&
+                   (max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z);
+        }
+
+        inline glm::vec3 center() const
+        {
+            return (min + max) * 0.5f;
+        }
+
+        //Half the surface area, what SAH costs are measured in
+        inline float area() const
+        {
+            glm::vec3 d = max - min;
+            return (d.x * d.y) + (d.y * d.z) + (d.z * d.x);
+        }
+
+        //Slab test against a ray with 1 / direction precomputed, Distance is where it enters (0 when inside)
+        inline bool intersectsRay(const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance, float& distance) const
+        {
+            float enter = 0.f;
+            float exit = maxDistance;
+
+            for (int i = 0; i < 3; i++)
+            {
+                float t0 = (min[i] - origin[i]) * inverseDirection[i];
+                float t1 = (max[i] - origin[i]) * inverseDirection[i];
+                if (t0 > t1)
+                    std::swap(t0, t1);
+
+                //NaN from 0 * inf (On a slab face) keeps the old bound
+                enter = (t0 > enter) ? t0 : enter;
+                exit = (t1 < exit) ? t1 : exit;
+
+                if (enter > exit)
+                    return false;
+            }
+
+            distance = enter;
+            return true;
+        }
+
+        //Box around this one after linear * p + translation, the half size takes the absolute of each axis (Arvo)
+        inline AABB transformed(const glm::mat3& linear, const glm::vec3& translation) const
+        {
+            glm::vec3 c = linear * center() + translation;
+            glm::vec3 half = (max - min) * 0.5f;
+            glm::vec3 extent(0.f);
+
+            for (int i = 0; i < 3; i++)
+            {
+                extent[i] = std::abs(linear[0][i]) * half.x + std::abs(linear[1][i]) * half.y + std::abs(linear[2][i]) * half.z;
+            }
+
+            AABB out;
+            out.min = c - extent;
+            out.max = c + extent;
+            return out;
+        }
     };
 
 	AABB* computeAABB(const class Mesh* mesh);
+	AABB computeBounds(const class Mesh* mesh);
+
+	size_t VertexStride(VertexLayout Layout);
+
+	//Position = Offset + (Stored * Scale) for the layout, what the shader gets as MeshOffset/MeshScale
+	void VertexDequantization(VertexLayout Layout, const AABB& Bounds, glm::vec3& Offset, glm::vec3& Scale);
+
+	CompactVertex PackVertex(const Vertex& vertex, VertexLayout Layout, const AABB& Bounds);
+	Vertex UnpackVertex(const CompactVertex& vertex, VertexLayout Layout, const AABB& Bounds);
+
+	//A range of the index buffer drawn at one level of detail
+	struct MeshLOD
+	{
+		GLuint FirstIndex = 0;
+		GLuint IndexCount = 0;
+		float Error = 0.f; //Object space error against the full mesh
+	};
 
 	//Main Body
 	struct Mesh
@@ -50,7 +155,13 @@ namespace UnifiedEngine
 		std::vector<Vertex> vertices = {};
 		std::vector<GLuint> indices = {};
 
-		// AABB
-		AABB* GeneratedAABB = nullptr;
+		//Empty when the indices are only the full detail mesh, otherwise LODs[0] is full detail
+		std::vector<MeshLOD> LODs = {};
+
+		//Layout used when uploaded (Precision sensitive meshes keep VERTEX_LAYOUT_FULL)
+		VertexLayout Layout = VERTEX_LAYOUT_FULL;
+
+		// AABB, held by value so copies of the mesh never share or free it
+		std::optional<AABB> GeneratedAABB = std::nullopt;
 	};
 } // namespace UnifiedEngine
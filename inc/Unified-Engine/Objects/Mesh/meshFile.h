@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Unified-Engine/Objects/Mesh/meshFormat.h>
+#include <Unified-Engine/Objects/Mesh/mesh.h>
+#include <Unified-Engine/Utility/mappedFile.h>
+#include <string>
+
+namespace UnifiedEngine
+{
+    /**
+     * @brief A mesh made by tools/mesh_convert, memory mapped so nothing is parsed at load.
+     *        The vertex and index sections can be uploaded straight out of the mapping
+     *        (See GameObject(const MeshFile&, ShaderObject*)), the file can be closed afterwards.
+     *
+     */
+    class MeshFile{
+    protected:
+        MappedFile File;
+        const MeshFileHeader* Header = nullptr;
+
+    public:
+        MeshFile();
+        MeshFile(const std::string& FilePath);
+        ~MeshFile();
+
+    public:
+        int Open(const std::string& FilePath);
+        int Close();
+
+        inline bool IsOpen() const {return this->Header != nullptr;}
+
+        inline const MeshFileHeader* Info() const {return this->Header;}
+        inline VertexLayout Layout() const {return (VertexLayout)this->Header->Layout;}
+        inline const void* Vertices() const {return this->File.Bytes() + this->Header->VertexOffset;}
+        inline const void* Indices() const {return this->File.Bytes() + this->Header->IndexOffset;}
+        inline const MeshFileLOD* LODs() const {return (const MeshFileLOD*)(this->File.Bytes() + this->Header->LODOffset);}
+
+        inline size_t VertexBytes() const {return (size_t)this->Header->VertexCount * this->Header->VertexStride;}
+        inline size_t IndexBytes() const {return (size_t)this->Header->IndexCount * this->Header->IndexSize;}
+
+        AABB Bounds() const;
+        int ToMesh(Mesh& Out) const; //Copies into a Mesh for CPU side use (Collision, editing)
+    };
+
+    //Writes a mesh as a .uemesh in mesh.Layout, indices are stored as 16 bit when every vertex can be reached
+    int WriteMeshFile(const std::string& FilePath, const Mesh& mesh);
+} // namespace UnifiedEngine
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+//On disk layout of a converted mesh (.uemesh), shared by the runtime and tools/mesh_convert
+//No GL in here so the converter can build without a context
+
+namespace UnifiedEngine
+{
+    constexpr uint32_t MESH_FILE_MAGIC = 0x534D4555; //"UEMS"
+    constexpr uint32_t MESH_FILE_VERSION = 1; //Bump on any layout change, old meshes are rejected
+
+    //Every section starts on this boundary so it can be handed to the GPU straight from the mapping
+    constexpr uint64_t MESH_FILE_ALIGNMENT = 64;
+
+    enum MeshFileLayout{
+        MESH_LAYOUT_FULL = 0, //Vertex as declared in mesh.h (Float position, color, uv, normal)
+        MESH_LAYOUT_COMPACT = 1, //CompactVertex, positions quantized to Min/Max
+        MESH_LAYOUT_COMPACT_HALF = 2 //CompactVertex, half float positions
+    };
+
+    /**
+     * @brief File layout:
+     *        Header | (aligned) LODs[LODCount] | (aligned) Vertices[VertexCount] | (aligned) Indices[IndexCount]
+     *        Vertices are one interleaved stream of VertexStride bytes, indices are IndexSize bytes each.
+     *        Every LOD is a range of the index section, LOD 0 is full detail.
+     *
+     */
+    struct MeshFileHeader{
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t Layout; //MeshFileLayout
+        uint32_t VertexStride;
+        uint32_t VertexCount;
+        uint32_t IndexSize; //2 or 4
+        uint32_t IndexCount;
+        uint32_t LODCount;
+        float Min[3]; //Bounds of every vertex
+        float Max[3];
+        uint64_t LODOffset;
+        uint64_t VertexOffset;
+        uint64_t IndexOffset;
+    };
+
+    struct MeshFileLOD{
+        uint32_t FirstIndex;
+        uint32_t IndexCount;
+        float Error; //Object space error against LOD 0
+        uint32_t Reserved;
+    };
+
+    static_assert(sizeof(MeshFileHeader) == 80, "Mesh file header layout changed");
+    static_assert(sizeof(MeshFileLOD) == 16, "Mesh file LOD layout changed");
+
+    inline uint64_t MeshFileAlign(uint64_t Offset){
+        return ((Offset + MESH_FILE_ALIGNMENT - 1) / MESH_FILE_ALIGNMENT) * MESH_FILE_ALIGNMENT;
+    }
+} // namespace UnifiedEngine
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Unified-Engine/Objects/Mesh/mesh.h>
+#include <string>
+
+namespace UnifiedEngine
+{
+    //Mesh importers, every file is memory mapped and parsed in place with the work spread over the
+    //worker pool when there is one. GeneratedAABB is filled in.
+
+    /**
+     * @brief Reads a Wavefront OBJ into Out. Line aligned chunks are parsed in parallel, polygons are
+     *        fanned into triangles and identical position/uv/normal corners share a vertex (De-duplicated
+     *        in hash sharded tables). Vertex colours ("v x y z r g b") are kept.
+     *
+     */
+    int ImportOBJ(const std::string& FilePath, Mesh& Out);
+
+    /**
+     * @brief Reads a binary glTF 2.0 (.glb) into Out. Every triangle primitive of the default scene
+     *        is merged into one mesh with its node transform baked in. Takes POSITION, NORMAL,
+     *        TEXCOORD_0 and COLOR_0 from the embedded buffer (External buffers are not read).
+     *
+     */
+    int ImportGLB(const std::string& FilePath, Mesh& Out);
+
+    //Picks the importer from the extension (.obj, .glb)
+    int ImportMesh(const std::string& FilePath, Mesh& Out);
+} // namespace UnifiedEngine
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Unified-Engine/Objects/Mesh/mesh.h>
+
+namespace UnifiedEngine
+{
+    //Index and vertex order optimisation, run by tools/mesh_convert and optionally by GameObject::ReplaceMesh
+    //Only the order changes, every LOD range keeps its own triangles
+    //Meshes without indices are drawn in vertex order and are left as they are
+
+    /**
+     * @brief Post transform cache behaviour of the index buffer, simulated with a FIFO of CacheSize.
+     *        ACMR is vertices transformed per triangle (0.5 to 3, lower is better),
+     *        ATVR is vertices transformed per vertex referenced (1 is ideal).
+     *
+     */
+    struct MeshCacheStats{
+        float ACMR = 0.f;
+        float ATVR = 0.f;
+    };
+
+    MeshCacheStats AnalyzeVertexCache(const Mesh& mesh, unsigned CacheSize = 16);
+
+    //Reorders triangles for the post transform cache (Tom Forsyth's linear speed vertex cache optimisation)
+    int OptimizeVertexCache(Mesh& mesh);
+
+    //Splits the cache ordered triangles into clusters where the cache restarts and draws the outward facing
+    //clusters first so less is overdrawn, undone when ACMR grows past Threshold times what it was
+    int OptimizeOverdraw(Mesh& mesh, float Threshold = 1.05f);
+
+    //Renumbers vertices in the order they are first used so fetching walks the vertex buffer forwards,
+    //unused vertices are dropped
+    int OptimizeVertexFetch(Mesh& mesh);
+
+    //All three in order, logging the cache statistics before and after when Report is set
+    int OptimizeMesh(Mesh& mesh, bool Report = true);
+} // namespace UnifiedEngine
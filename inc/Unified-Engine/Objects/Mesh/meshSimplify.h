@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Unified-Engine/Objects/Mesh/mesh.h>
+#include <vector>
+
+namespace UnifiedEngine
+{
+    /**
+     * @brief Quadric error edge collapse (Garland and Heckbert) over a triangle list into mesh.vertices.
+     *        Vertices are never moved or added, an edge collapses onto one of its ends so every LOD
+     *        can share the one vertex buffer. Positions are welded first so uv/normal seams do not stop
+     *        collapses, open borders are held in place by extra planes.
+     *
+     *        Stops at TargetCount indices or once a collapse would cost more than TargetError
+     *        (Object space distance). Returns the error reached.
+     *
+     */
+    float SimplifyIndices(const Mesh& mesh, const GLuint* Indices, size_t Count, size_t TargetCount, float TargetError, std::vector<GLuint>& Out);
+
+    /**
+     * @brief Builds an LOD chain into mesh.LODs, each LOD has about Ratio of the triangles of the one before
+     *        and is appended to the index buffer. Stops early when an LOD would go past MaxError
+     *        (A fraction of the bounds' diagonal) or barely simplifies.
+     *        Any existing LODs are replaced, LOD 0 stays as it was.
+     *
+     */
+    int GenerateLODs(Mesh& mesh, unsigned MaxLODs = 4, float Ratio = 0.5f, float MaxError = 0.05f);
+} // namespace UnifiedEngine
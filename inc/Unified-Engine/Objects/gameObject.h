@@ -2,6 +2,7 @@
 
 #include <Unified-Engine/Objects/objectComponent.h>
 #include <Unified-Engine/Objects/Mesh/mesh.h>
+#include <Unified-Engine/Objects/Mesh/meshFile.h>
 #include <Unified-Engine/Objects/Components/transform.h>
 #include <Unified-Engine/Objects/Components/shaderObject.h>
 #include <string>
@@ -12,12 +13,24 @@ namespace UnifiedEngine
     class GameObject : public ObjectComponent{
         friend ShaderObject;
         friend ObjectComponent;
+        friend class StaticBatcher;
+        friend class MeshCollider;
+        friend class GameInstance;
     protected:
         //Buffers
 		GLuint VAO = 0;
 		GLuint VBO = 0;
 		GLuint EBO = 0;
 
+        //What the buffers hold (The mesh vectors are empty when uploaded from a MeshFile)
+        GLsizei VertexCount = 0;
+        GLsizei IndexCount = 0;
+        GLenum IndexType = GL_UNSIGNED_INT;
+
+        //Vertex decoding sent to the shader ("VertexLayout", "MeshOffset", "MeshScale")
+        GLint Layout = VERTEX_LAYOUT_FULL;
+        glm::vec3 MeshOffset = glm::vec3(0.f);
+        glm::vec3 MeshScale = glm::vec3(1.f);
         
         Transform transformOld = {};
 
@@ -26,8 +39,14 @@ namespace UnifiedEngine
 
         //Matricies
         glm::mat4 ModelMatrix;
+
+        bool Batched = false; //Drawn by the static batcher, the matrix is frozen and only children render
+
+        int SpatialProxy = -1; //Proxy in __GLOBAL_SCENE_TREE
+        bool InView = false; //Found in the camera frustum this frame, cleared once drawn
     protected: //Math and Mesh Functions
         int GenerateVAOBuffers();
+        int GenerateVAOBuffers(const void* Vertices, size_t VertexCount, const void* Indices, size_t IndexCount, GLenum IndexType, VertexLayout Layout);
 
         bool NoShader = true;
         
@@ -40,12 +59,26 @@ namespace UnifiedEngine
         //To fix rendering problems its not part of children and required
         ShaderObject* shader = nullptr;
 
+        int LOD = 0; //!< Level of detail drawn when the mesh has LODs
+        bool AutoLOD = true; //!< Pick LOD every update from the main camera (See SelectLOD)
+        bool Static = false; //!< Never moves once instantiated, baked into a shared batch (Set before instantiate, see StaticBatcher)
+        bool Spatial = true; //!< Kept in __GLOBAL_SCENE_TREE while it has a mesh, and only drawn when the tree finds it in view
+
     public:
         GameObject(Mesh _mesh, ShaderObject* _shader);
         GameObject(GameObject* _parent, Mesh _mesh, ShaderObject* _shader);
+        GameObject(const MeshFile& _mesh, ShaderObject* _shader); //Uploads straight from the mapping
         ~GameObject();
 
-        int ReplaceMesh(Mesh newMesh);
+        int ReplaceMesh(Mesh newMesh, bool Optimize = false); //Optimize reorders it first (See OptimizeMesh)
+        int ReplaceMesh(const MeshFile& newMesh);
+
+        //Coarsest LOD whose error projects under LODPixelError from the main camera
+        int SelectLOD();
+
+        AABB LocalBounds(); //Mesh bounds before the transform, empty without a mesh
+        AABB WorldBounds(); //Mesh bounds through ModelMatrix, empty without a mesh
+        int ReleaseSpatial(); //Drops it from the scene tree (destroy does this), it is added back on the next update
 
     public:
         int Update() override;
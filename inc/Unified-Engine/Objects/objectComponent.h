@@ -30,7 +30,7 @@ namespace UnifiedEngine
         const ObjectComponentType type;
 
         ObjectComponent(ObjectComponent* _Parent, ObjectComponentType Type, bool Component = false);
-        ~ObjectComponent();
+        virtual ~ObjectComponent();
 
     public:
         int UpdateC(); //Chilren
@@ -1,14 +1,27 @@
 #pragma once
 #include <Unified-Engine/Objects/objectComponent.h>
+#include <Unified-Engine/Core/Physics/collisionEvent.h>
 
 namespace UnifiedEngine
-{   
+{
     /**
      * @brief To Be inhertited from to allow to attach to a gameobject and be updated along with the game
-     * 
+     *        Override the collision functions to hear about the colliders on the same gameobject, they are called
+     *        together once the frame's physics has stepped
+     *
      */
     class ScriptableObject : public ObjectComponent{
     protected:
         ScriptableObject(ObjectComponent* Parent) : ObjectComponent(Parent, OBJECT_SCRIPTABLE_OBJECT, true){}
+
+    public: //Collisions, Enter on the first step touching, Stay on every step after, Exit on the first step apart
+        virtual void OnCollisionEnter(const Collision&){}
+        virtual void OnCollisionStay(const Collision&){}
+        virtual void OnCollisionExit(const Collision&){}
+
+        //Either collider set as a trigger, nothing is pushed apart
+        virtual void OnTriggerEnter(const Collision&){}
+        virtual void OnTriggerStay(const Collision&){}
+        virtual void OnTriggerExit(const Collision&){}
     };
 } // namespace UnifiedEngine
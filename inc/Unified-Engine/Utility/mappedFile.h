@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace UnifiedEngine
+{
+    /**
+     * @brief Read only memory mapping of a whole file.
+     *        Pages are only read from disk when they are first touched.
+     * 
+     */
+    class MappedFile{
+    protected:
+        const uint8_t* Data = nullptr;
+        size_t Size = 0;
+
+#ifdef _WIN32
+        void* File = nullptr;
+        void* Mapping = nullptr;
+#else
+        int Descriptor = -1;
+#endif
+
+    public:
+        MappedFile();
+        MappedFile(const std::string& FilePath);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+    public:
+        int Open(const std::string& FilePath);
+        int Close();
+
+        inline const uint8_t* Bytes() const {return this->Data;}
+        inline size_t Length() const {return this->Size;}
+        inline bool IsOpen() const {return this->Data != nullptr;}
+    };
+} // namespace UnifiedEngine
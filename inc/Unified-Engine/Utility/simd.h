@@ -0,0 +1,25 @@
+#pragma once
+
+//Compile time SIMD availability, AVX2 is picked at runtime with CPUSupportsAVX2()
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define UE_SIMD_SSE2 1
+    #include <emmintrin.h>
+    #include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define UE_SIMD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+//Lets a single function use AVX2 without building the whole library for it
+#if defined(UE_SIMD_SSE2) && (defined(__GNUC__) || defined(__clang__))
+    #define UE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+    #define UE_TARGET_AVX2
+#endif
+
+namespace UnifiedEngine
+{
+    bool CPUSupportsAVX2();
+} // namespace UnifiedEngine
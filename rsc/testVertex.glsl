@@ -14,12 +14,30 @@ uniform mat4 ModelMatrix;
 uniform mat4 ViewMatrix;
 uniform mat4 ProjectionMatrix;
 
+//Compact vertices (See VertexLayout in mesh.h), 0 is uncompressed
+uniform int VertexLayout;
+uniform vec3 MeshOffset;
+uniform vec3 MeshScale;
+
+vec3 DecodeNormal(vec3 n){
+	if(VertexLayout == 0) return n;
+
+	//Octahedral, unfold the lower half
+	vec3 o = vec3(n.xy, 1.f - abs(n.x) - abs(n.y));
+	float t = max(-o.z, 0.f);
+	o.x += (o.x >= 0.f) ? -t : t;
+	o.y += (o.y >= 0.f) ? -t : t;
+	return normalize(o);
+}
+
 void main(){
-	vs_position = vec4(ModelMatrix * vec4(vertex_position, 1.f)).xyz;
+	vec3 position = (VertexLayout == 0) ? vertex_position : MeshOffset + (vertex_position * MeshScale);
+
+	vs_position = vec4(ModelMatrix * vec4(position, 1.f)).xyz;
 	vs_color = vertex_color;
 	vs_texcoord = vec2(vertex_texcoord.x, vertex_texcoord.y * -1.f);
-	vs_normal = mat3(ModelMatrix) * vertex_normal;
+	vs_normal = mat3(ModelMatrix) * DecodeNormal(vertex_normal);
 
-	gl_Position = ProjectionMatrix * ViewMatrix * ModelMatrix * vec4(vertex_position, 1.f);
+	gl_Position = ProjectionMatrix * ViewMatrix * ModelMatrix * vec4(position, 1.f);
 	// gl_Position = vec4(vertex_position, 1.f);
 }
@@ -0,0 +1,22 @@
+#version 460
+
+in vec3 vs_position;
+in vec3 vs_color;
+in vec2 vs_texcoord;
+in vec3 vs_normal;
+
+out vec4 fs_color;
+
+uniform vec3 CameraPosition;
+uniform vec3 CameraFront;
+
+uniform sampler2DArray Texture;
+uniform int TextureLayer;
+uniform vec2[4] UVMap;
+
+void main(){
+	//Final
+	fs_color = texture(Texture, vec3(vs_texcoord, TextureLayer));
+
+    if(fs_color.a==0.0) discard;
+}
@@ -0,0 +1,134 @@
+#include <Unified-Engine/Core/Physics/contactSolver.h>
+#include <GLM/geometric.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace UnifiedEngine;
+
+//Tangents from the normal alone so they line up with last step's accumulated friction
+static inline void TangentBasis(const glm::vec3& Normal, glm::vec3& T1, glm::vec3& T2){
+    if(std::abs(Normal.x) >= 0.57735f)
+        T1 = glm::normalize(glm::vec3(Normal.y, -Normal.x, 0.f));
+    else
+        T1 = glm::normalize(glm::vec3(0.f, Normal.z, -Normal.y));
+
+    T2 = glm::cross(Normal, T1);
+}
+
+//Inverse of the mass felt along Direction at the two points
+static inline float EffectiveMass(const SolverBody& A, const SolverBody& B, const glm::vec3& RA, const glm::vec3& RB, const glm::vec3& Direction){
+    glm::vec3 ra = glm::cross(RA, Direction);
+    glm::vec3 rb = glm::cross(RB, Direction);
+
+    float k = glm::dot(Direction, A.InverseMass * Direction) + glm::dot(Direction, B.InverseMass * Direction)
+            + glm::dot(ra, A.InverseInertia * ra) + glm::dot(rb, B.InverseInertia * rb);
+
+    return (k > 0.f) ? 1.f / k : 0.f;
+}
+
+static inline glm::vec3 RelativeVelocity(const SolverBody& A, const SolverBody& B, const glm::vec3& RA, const glm::vec3& RB){
+    return (B.Velocity + glm::cross(B.AngularVelocity, RB)) - (A.Velocity + glm::cross(A.AngularVelocity, RA));
+}
+
+static inline void ApplyImpulse(SolverBody& A, SolverBody& B, const glm::vec3& RA, const glm::vec3& RB, const glm::vec3& Impulse){
+    A.Velocity -= A.InverseMass * Impulse;
+    A.AngularVelocity -= A.InverseInertia * glm::cross(RA, Impulse);
+    B.Velocity += B.InverseMass * Impulse;
+    B.AngularVelocity += B.InverseInertia * glm::cross(RB, Impulse);
+}
+
+void UnifiedEngine::PrepareContacts(ContactManifold* const* Manifolds, size_t Count, SolverBody* Bodies, float DeltaTime, const SolverSettings& Settings){
+    SolverBody fixed = {};
+
+    for(size_t m = 0; m < Count; m++){
+        ContactManifold& manifold = *Manifolds[m];
+        SolverBody& a = (manifold.BodyA >= 0) ? Bodies[manifold.BodyA] : fixed;
+        SolverBody& b = (manifold.BodyB >= 0) ? Bodies[manifold.BodyB] : fixed;
+
+        TangentBasis(manifold.Normal, manifold.Tangent[0], manifold.Tangent[1]);
+
+        for(int p = 0; p < manifold.PointCount; p++){
+            ContactPoint& point = manifold.Points[p];
+
+            //Static geometry has no centre, the point itself does
+            point.RA = (manifold.BodyA >= 0) ? point.Position - a.Center : glm::vec3(0.f);
+            point.RB = (manifold.BodyB >= 0) ? point.Position - b.Center : glm::vec3(0.f);
+
+            point.NormalMass = EffectiveMass(a, b, point.RA, point.RB, manifold.Normal);
+            point.TangentMass[0] = EffectiveMass(a, b, point.RA, point.RB, manifold.Tangent[0]);
+            point.TangentMass[1] = EffectiveMass(a, b, point.RA, point.RB, manifold.Tangent[1]);
+
+            //Push out part of the penetration, and bounce off fast closing speeds. A gap may still close this step
+            if(point.Depth < 0.f)
+                point.Bias = point.Depth / DeltaTime;
+            else
+                point.Bias = (Settings.Baumgarte / DeltaTime) * std::max(0.f, point.Depth - Settings.Slop);
+
+            float closing = glm::dot(RelativeVelocity(a, b, point.RA, point.RB), manifold.Normal);
+            if(closing < -Settings.RestitutionThreshold)
+                point.Bias = std::max(point.Bias, -manifold.Restitution * closing);
+        }
+    }
+}
+
+void UnifiedEngine::WarmStartContacts(ContactManifold* const* Manifolds, size_t Count, SolverBody* Bodies){
+    SolverBody fixed = {};
+
+    for(size_t m = 0; m < Count; m++){
+        ContactManifold& manifold = *Manifolds[m];
+        SolverBody& a = (manifold.BodyA >= 0) ? Bodies[manifold.BodyA] : fixed;
+        SolverBody& b = (manifold.BodyB >= 0) ? Bodies[manifold.BodyB] : fixed;
+
+        for(int p = 0; p < manifold.PointCount; p++){
+            const ContactPoint& point = manifold.Points[p];
+
+            glm::vec3 impulse = (manifold.Normal * point.NormalImpulse) + (manifold.Tangent[0] * point.TangentImpulse[0]) + (manifold.Tangent[1] * point.TangentImpulse[1]);
+            ApplyImpulse(a, b, point.RA, point.RB, impulse);
+        }
+    }
+}
+
+void UnifiedEngine::SolveContacts(ContactManifold* const* Manifolds, size_t Count, SolverBody* Bodies){
+    SolverBody fixed = {};
+
+    for(size_t m = 0; m < Count; m++){
+        ContactManifold& manifold = *Manifolds[m];
+        SolverBody& a = (manifold.BodyA >= 0) ? Bodies[manifold.BodyA] : fixed;
+        SolverBody& b = (manifold.BodyB >= 0) ? Bodies[manifold.BodyB] : fixed;
+
+        for(int p = 0; p < manifold.PointCount; p++){
+            ContactPoint& point = manifold.Points[p];
+
+            //Friction first, limited by the normal impulse of the last iteration
+            float limit = manifold.Friction * point.NormalImpulse;
+
+            for(int t = 0; t < 2; t++){
+                float speed = glm::dot(RelativeVelocity(a, b, point.RA, point.RB), manifold.Tangent[t]);
+                float lambda = -speed * point.TangentMass[t];
+
+                float previous = point.TangentImpulse[t];
+                point.TangentImpulse[t] = std::clamp(previous + lambda, -limit, limit);
+
+                ApplyImpulse(a, b, point.RA, point.RB, manifold.Tangent[t] * (point.TangentImpulse[t] - previous));
+            }
+
+            //Normal, the total may only push
+            float speed = glm::dot(RelativeVelocity(a, b, point.RA, point.RB), manifold.Normal);
+            float lambda = (point.Bias - speed) * point.NormalMass;
+
+            float previous = point.NormalImpulse;
+            point.NormalImpulse = std::max(previous + lambda, 0.f);
+
+            ApplyImpulse(a, b, point.RA, point.RB, manifold.Normal * (point.NormalImpulse - previous));
+        }
+    }
+}
+
+void UnifiedEngine::SolveContactGroup(ContactManifold* const* Manifolds, size_t Count, SolverBody* Bodies, float DeltaTime, const SolverSettings& Settings){
+    PrepareContacts(Manifolds, Count, Bodies, DeltaTime, Settings);
+    WarmStartContacts(Manifolds, Count, Bodies);
+
+    for(unsigned i = 0; i < Settings.Iterations; i++){
+        SolveContacts(Manifolds, Count, Bodies);
+    }
+}
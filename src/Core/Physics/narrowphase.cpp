@@ -0,0 +1,972 @@
+#include <Unified-Engine/Core/Physics/contact.h>
+#include <Unified-Engine/Objects/Components/collider.h>
+#include <GLM/geometric.hpp>
+#include <GLM/matrix.hpp>
+#include <vector>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace UnifiedEngine;
+
+//An edge axis has to beat the best face axis by this much, face contacts give steadier manifolds
+constexpr float EDGE_RELATIVE_TOLERANCE = 0.95f;
+constexpr float EDGE_ABSOLUTE_TOLERANCE = 0.001f;
+
+//Clipped face points, a quad cut by four planes has at most eight and a triangle cut by six at most nine
+constexpr int MAX_CLIP_POINTS = 12;
+
+//Mesh triangles whose normal is this close to the manifold's add their points to it
+constexpr float MESH_NORMAL_TOLERANCE = 0.9f;
+
+static int SphereSphere(const glm::vec3& CenterA, float RadiusA, const glm::vec3& CenterB, float RadiusB, ContactManifold& Manifold){
+    glm::vec3 d = CenterB - CenterA;
+    float distance2 = glm::dot(d, d);
+    float radius = RadiusA + RadiusB;
+
+    if(distance2 > (radius + CONTACT_MARGIN) * (radius + CONTACT_MARGIN))
+        return 0;
+
+    float distance = std::sqrt(distance2);
+
+    //Same centre, any direction will do
+    Manifold.Normal = (distance > 1e-6f) ? d / distance : glm::vec3(0.f, 1.f, 0.f);
+
+    ContactPoint& point = Manifold.Points[0];
+    point = ContactPoint{};
+    point.Depth = radius - distance;
+    point.Position = CenterA + Manifold.Normal * (RadiusA - (point.Depth * 0.5f));
+
+    Manifold.PointCount = 1;
+
+    return 1;
+}
+
+//Normal points from the box to the sphere
+static int BoxSphere(const OrientedBox& Box, const glm::vec3& Center, float Radius, glm::vec3& Normal, ContactPoint& Point){
+    glm::vec3 local = glm::transpose(Box.Axes) * (Center - Box.Center);
+    glm::vec3 closest = glm::clamp(local, -Box.HalfSize, Box.HalfSize);
+    glm::vec3 d = local - closest;
+    float distance2 = glm::dot(d, d);
+
+    if(distance2 > (Radius + CONTACT_MARGIN) * (Radius + CONTACT_MARGIN))
+        return 0;
+
+    float depth;
+
+    if(distance2 > 1e-12f){
+        float distance = std::sqrt(distance2);
+        Normal = Box.Axes * (d / distance);
+        depth = Radius - distance;
+    }
+    else{
+        //Centre inside, out through the nearest face
+        int axis = 0;
+        float nearest = FLT_MAX;
+
+        for(int i = 0; i < 3; i++){
+            float gap = Box.HalfSize[i] - std::abs(local[i]);
+            if(gap < nearest){
+                nearest = gap;
+                axis = i;
+            }
+        }
+
+        float sign = (local[axis] < 0.f) ? -1.f : 1.f;
+        closest[axis] = sign * Box.HalfSize[axis];
+
+        Normal = Box.Axes[axis] * sign;
+        depth = nearest + Radius;
+    }
+
+    glm::vec3 surface = Box.Center + Box.Axes * closest;
+
+    Point = ContactPoint{};
+    Point.Depth = depth;
+    Point.Position = (surface + (Center - Normal * Radius)) * 0.5f;
+
+    return 1;
+}
+
+//Overlap of both boxes projected on Axis, negative when it separates them
+static inline float Penetration(const OrientedBox& A, const OrientedBox& B, const glm::vec3& Offset, const glm::vec3& Axis){
+    float ra = 0.f;
+    float rb = 0.f;
+
+    for(int i = 0; i < 3; i++){
+        ra += A.HalfSize[i] * std::abs(glm::dot(A.Axes[i], Axis));
+        rb += B.HalfSize[i] * std::abs(glm::dot(B.Axes[i], Axis));
+    }
+
+    return ra + rb - std::abs(glm::dot(Offset, Axis));
+}
+
+//Keeps the part of the polygon on the inside of the plane (Sutherland-Hodgman)
+static int ClipPolygon(const glm::vec3* In, int Count, const glm::vec3& Normal, float Offset, glm::vec3* Out){
+    int out = 0;
+
+    for(int i = 0; i < Count; i++){
+        const glm::vec3& a = In[i];
+        const glm::vec3& b = In[(i + 1) % Count];
+
+        float da = glm::dot(Normal, a) - Offset;
+        float db = glm::dot(Normal, b) - Offset;
+
+        if(da <= 0.f && out < MAX_CLIP_POINTS)
+            Out[out++] = a;
+
+        //Crosses the plane, a point on it is kept as it is
+        if(((da < 0.f && db > 0.f) || (da > 0.f && db < 0.f)) && out < MAX_CLIP_POINTS)
+            Out[out++] = a + (b - a) * (da / (da - db));
+    }
+
+    return out;
+}
+
+//Keeps the deepest point and the three that span the most area with it
+static int ReducePoints(ContactPoint* Points, int Count){
+    if(Count <= MAX_CONTACT_POINTS)
+        return Count;
+
+    int chosen[MAX_CONTACT_POINTS];
+
+    chosen[0] = 0;
+    for(int i = 1; i < Count; i++){
+        if(Points[i].Depth > Points[chosen[0]].Depth)
+            chosen[0] = i;
+    }
+
+    float best = -1.f;
+    chosen[1] = chosen[0];
+    for(int i = 0; i < Count; i++){
+        glm::vec3 d = Points[i].Position - Points[chosen[0]].Position;
+        if(glm::dot(d, d) > best){
+            best = glm::dot(d, d);
+            chosen[1] = i;
+        }
+    }
+
+    best = -1.f;
+    chosen[2] = chosen[0];
+    for(int i = 0; i < Count; i++){
+        float area = glm::length(glm::cross(Points[chosen[1]].Position - Points[chosen[0]].Position, Points[i].Position - Points[chosen[0]].Position));
+        if(area > best){
+            best = area;
+            chosen[2] = i;
+        }
+    }
+
+    //Furthest outside the triangle, its area with each edge adds up past the triangle's own
+    best = -1.f;
+    chosen[3] = chosen[0];
+    for(int i = 0; i < Count; i++){
+        if(i == chosen[0] || i == chosen[1] || i == chosen[2])
+            continue;
+
+        float area = 0.f;
+        for(int e = 0; e < 3; e++){
+            const glm::vec3& a = Points[chosen[e]].Position;
+            const glm::vec3& b = Points[chosen[(e + 1) % 3]].Position;
+            area += glm::length(glm::cross(b - a, Points[i].Position - a));
+        }
+
+        if(area > best){
+            best = area;
+            chosen[3] = i;
+        }
+    }
+
+    ContactPoint kept[MAX_CONTACT_POINTS];
+    for(int i = 0; i < MAX_CONTACT_POINTS; i++){
+        kept[i] = Points[chosen[i]];
+    }
+    for(int i = 0; i < MAX_CONTACT_POINTS; i++){
+        Points[i] = kept[i];
+    }
+
+    return MAX_CONTACT_POINTS;
+}
+
+//Incident face clipped against the sides of the reference face, Normal is the reference face's outward normal
+static int FaceContact(const OrientedBox& Reference, int Axis, const glm::vec3& Normal, const OrientedBox& Incident, ContactManifold& Manifold){
+    //Incident face is the one facing most against the reference normal
+    int incidentAxis = 0;
+    float most = -1.f;
+
+    for(int i = 0; i < 3; i++){
+        float d = std::abs(glm::dot(Incident.Axes[i], Normal));
+        if(d > most){
+            most = d;
+            incidentAxis = i;
+        }
+    }
+
+    float sign = (glm::dot(Incident.Axes[incidentAxis], Normal) > 0.f) ? -1.f : 1.f;
+    glm::vec3 faceCenter = Incident.Center + Incident.Axes[incidentAxis] * (sign * Incident.HalfSize[incidentAxis]);
+    glm::vec3 u = Incident.Axes[(incidentAxis + 1) % 3] * Incident.HalfSize[(incidentAxis + 1) % 3];
+    glm::vec3 v = Incident.Axes[(incidentAxis + 2) % 3] * Incident.HalfSize[(incidentAxis + 2) % 3];
+
+    glm::vec3 polygon[MAX_CLIP_POINTS] = {faceCenter + u + v, faceCenter - u + v, faceCenter - u - v, faceCenter + u - v};
+    glm::vec3 clipped[MAX_CLIP_POINTS];
+    int count = 4;
+
+    //Four side planes of the reference face
+    for(int side = 1; side <= 2 && count; side++){
+        const glm::vec3& axis = Reference.Axes[(Axis + side) % 3];
+        float extent = Reference.HalfSize[(Axis + side) % 3];
+        float center = glm::dot(axis, Reference.Center);
+
+        count = ClipPolygon(polygon, count, axis, center + extent, clipped);
+        count = ClipPolygon(clipped, count, -axis, -center + extent, polygon);
+    }
+
+    float faceOffset = glm::dot(Normal, Reference.Center) + Reference.HalfSize[Axis];
+
+    ContactPoint points[MAX_CLIP_POINTS];
+    int found = 0;
+
+    for(int i = 0; i < count; i++){
+        float separation = glm::dot(Normal, polygon[i]) - faceOffset;
+        if(separation > CONTACT_MARGIN)
+            continue;
+
+        //Clipping coincident faces leaves corners twice
+        bool duplicate = false;
+        for(int j = 0; j < found && !duplicate; j++){
+            glm::vec3 d = points[j].Position - (polygon[i] - Normal * (separation * 0.5f));
+            duplicate = glm::dot(d, d) < 1e-6f;
+        }
+        if(duplicate)
+            continue;
+
+        points[found] = ContactPoint{};
+        points[found].Depth = -separation;
+        points[found].Position = polygon[i] - Normal * (separation * 0.5f);
+        found++;
+    }
+
+    found = ReducePoints(points, found);
+
+    for(int i = 0; i < found; i++){
+        Manifold.Points[i] = points[i];
+    }
+    Manifold.PointCount = found;
+
+    return found;
+}
+
+//Separating axis test over the 15 axes, a face axis clips faces and an edge axis gives one point between the edges
+static int BoxBox(const OrientedBox& A, const OrientedBox& B, ContactManifold& Manifold){
+    glm::vec3 offset = B.Center - A.Center;
+
+    float bestFace = FLT_MAX;
+    int faceAxis = -1;
+
+    for(int i = 0; i < 6; i++){
+        const glm::vec3& axis = (i < 3) ? A.Axes[i] : B.Axes[i - 3];
+
+        float penetration = Penetration(A, B, offset, axis);
+        if(penetration < -CONTACT_MARGIN)
+            return 0;
+
+        if(penetration < bestFace){
+            bestFace = penetration;
+            faceAxis = i;
+        }
+    }
+
+    float bestEdge = FLT_MAX;
+    int edgeA = -1;
+    int edgeB = -1;
+    glm::vec3 edgeNormal(0.f);
+
+    for(int i = 0; i < 3; i++){
+        for(int j = 0; j < 3; j++){
+            glm::vec3 axis = glm::cross(A.Axes[i], B.Axes[j]);
+            float length = glm::length(axis);
+
+            //Parallel edges, the face axes already cover it
+            if(length < 1e-5f)
+                continue;
+
+            axis /= length;
+
+            float penetration = Penetration(A, B, offset, axis);
+            if(penetration < -CONTACT_MARGIN)
+                return 0;
+
+            if(penetration < bestEdge){
+                bestEdge = penetration;
+                edgeA = i;
+                edgeB = j;
+                edgeNormal = axis;
+            }
+        }
+    }
+
+    if(edgeA >= 0 && bestEdge < (bestFace * EDGE_RELATIVE_TOLERANCE) - EDGE_ABSOLUTE_TOLERANCE){
+        glm::vec3 normal = (glm::dot(edgeNormal, offset) < 0.f) ? -edgeNormal : edgeNormal;
+
+        //The edge of each box furthest toward the other
+        glm::vec3 pointA = A.Center;
+        glm::vec3 pointB = B.Center;
+
+        for(int k = 0; k < 3; k++){
+            if(k != edgeA)
+                pointA += A.Axes[k] * (A.HalfSize[k] * ((glm::dot(A.Axes[k], normal) > 0.f) ? 1.f : -1.f));
+            if(k != edgeB)
+                pointB += B.Axes[k] * (B.HalfSize[k] * ((glm::dot(B.Axes[k], normal) > 0.f) ? -1.f : 1.f));
+        }
+
+        //Closest points of the two edge lines
+        const glm::vec3& directionA = A.Axes[edgeA];
+        const glm::vec3& directionB = B.Axes[edgeB];
+        glm::vec3 w = pointA - pointB;
+
+        float d = glm::dot(directionA, directionB);
+        float e = glm::dot(directionA, w);
+        float f = glm::dot(directionB, w);
+        float denominator = 1.f - (d * d);
+
+        float s = (denominator > 1e-6f) ? ((d * f) - e) / denominator : 0.f;
+        s = std::clamp(s, -A.HalfSize[edgeA], A.HalfSize[edgeA]);
+        float t = std::clamp(f + (s * d), -B.HalfSize[edgeB], B.HalfSize[edgeB]);
+
+        Manifold.Normal = normal;
+        Manifold.Points[0] = ContactPoint{};
+        Manifold.Points[0].Depth = bestEdge;
+        Manifold.Points[0].Position = ((pointA + directionA * s) + (pointB + directionB * t)) * 0.5f;
+        Manifold.PointCount = 1;
+
+        return 1;
+    }
+
+    if(faceAxis < 3){
+        glm::vec3 normal = A.Axes[faceAxis];
+        if(glm::dot(normal, offset) < 0.f)
+            normal = -normal;
+
+        Manifold.Normal = normal;
+        return FaceContact(A, faceAxis, normal, B, Manifold);
+    }
+
+    //B's face, its outward normal points back at A
+    glm::vec3 normal = B.Axes[faceAxis - 3];
+    if(glm::dot(normal, offset) > 0.f)
+        normal = -normal;
+
+    Manifold.Normal = -normal;
+    return FaceContact(B, faceAxis - 3, normal, A, Manifold);
+}
+
+//A mesh collider's placement, Inverse takes world space back to the space its BVH was built in
+struct MeshFrame{
+    const TriangleMesh* Shape;
+    glm::mat3 Linear;
+    glm::vec3 Translation;
+    glm::mat3 Inverse;
+};
+
+static bool GetMeshFrame(MeshCollider* Collider, MeshFrame& Frame){
+    Frame.Shape = &Collider->GetShape();
+    if(Frame.Shape->Empty())
+        return false;
+
+    Collider->WorldTransform(Frame.Linear, Frame.Translation);
+
+    //A zero scale flattens it past inverting
+    if(std::abs(glm::determinant(Frame.Linear)) < 1e-12f)
+        return false;
+
+    Frame.Inverse = glm::inverse(Frame.Linear);
+
+    return true;
+}
+
+static inline void WorldTriangle(const MeshFrame& Frame, int Index, glm::vec3* Out){
+    Frame.Shape->Triangle(Index, Out[0], Out[1], Out[2]);
+
+    for(int i = 0; i < 3; i++){
+        Out[i] = (Frame.Linear * Out[i]) + Frame.Translation;
+    }
+}
+
+//World box grown by the margin, then into the mesh's space
+static inline AABB LocalQueryBox(const MeshFrame& Frame, AABB World){
+    World.min -= glm::vec3(CONTACT_MARGIN);
+    World.max += glm::vec3(CONTACT_MARGIN);
+
+    return World.transformed(Frame.Inverse, -(Frame.Inverse * Frame.Translation));
+}
+
+//Two sided, the unit normal facing Toward, false for a degenerate triangle
+static inline bool TriangleNormal(const glm::vec3* Triangle, const glm::vec3& Toward, glm::vec3& Normal){
+    Normal = glm::cross(Triangle[1] - Triangle[0], Triangle[2] - Triangle[0]);
+
+    float length = glm::length(Normal);
+    if(length < 1e-12f)
+        return false;
+
+    Normal /= length;
+    if(glm::dot(Normal, Toward - Triangle[0]) < 0.f)
+        Normal = -Normal;
+
+    return true;
+}
+
+//Welds points left twice by triangles sharing an edge, then keeps the best four
+static int FinishMeshManifold(const std::vector<ContactPoint>& Points, ContactManifold& Manifold){
+    std::vector<ContactPoint> kept;
+    kept.reserve(Points.size());
+
+    for(auto i = Points.begin(); i != Points.end(); i++){
+        bool duplicate = false;
+        for(auto j = kept.begin(); j != kept.end() && !duplicate; j++){
+            glm::vec3 d = j->Position - i->Position;
+            duplicate = glm::dot(d, d) < 1e-6f;
+        }
+
+        if(!duplicate)
+            kept.push_back(*i);
+    }
+
+    int found = ReducePoints(kept.data(), (int)kept.size());
+
+    for(int i = 0; i < found; i++){
+        Manifold.Points[i] = kept[i];
+    }
+    Manifold.PointCount = found;
+
+    return found;
+}
+
+//Deepest triangle under the sphere, Normal points from the mesh to the sphere
+static int MeshSphere(const MeshFrame& Frame, const glm::vec3& Center, float Radius, glm::vec3& Normal, ContactPoint& Point){
+    AABB box = {};
+    box.min = Center - glm::vec3(Radius);
+    box.max = Center + glm::vec3(Radius);
+
+    float best = -FLT_MAX;
+
+    Frame.Shape->Hierarchy().Query(LocalQueryBox(Frame, box), [&](int Index){
+        glm::vec3 triangle[3];
+        WorldTriangle(Frame, Index, triangle);
+
+        glm::vec3 closest = ClosestPointOnTriangle(Center, triangle[0], triangle[1], triangle[2]);
+        glm::vec3 d = Center - closest;
+        float distance2 = glm::dot(d, d);
+
+        if(distance2 > (Radius + CONTACT_MARGIN) * (Radius + CONTACT_MARGIN))
+            return true;
+
+        float distance = std::sqrt(distance2);
+        glm::vec3 normal;
+
+        //Centre on the triangle, out along its face
+        if(distance > 1e-6f)
+            normal = d / distance;
+        else if(!TriangleNormal(triangle, triangle[0] + glm::cross(triangle[1] - triangle[0], triangle[2] - triangle[0]), normal))
+            return true;
+
+        float depth = Radius - distance;
+        if(depth > best){
+            best = depth;
+            Normal = normal;
+
+            Point = ContactPoint{};
+            Point.Depth = depth;
+            Point.Position = (closest + (Center - normal * Radius)) * 0.5f;
+        }
+
+        return true;
+    });
+
+    return best > -FLT_MAX;
+}
+
+//Overlap of the triangle and box on a unit Axis, Sign is 1 when the box is on its positive side
+static inline float TriangleBoxPenetration(const glm::vec3* Triangle, const OrientedBox& Box, const glm::vec3& Axis, float& Sign){
+    float minimum = FLT_MAX;
+    float maximum = -FLT_MAX;
+
+    for(int i = 0; i < 3; i++){
+        float d = glm::dot(Triangle[i], Axis);
+        minimum = std::min(minimum, d);
+        maximum = std::max(maximum, d);
+    }
+
+    float center = glm::dot(Box.Center, Axis);
+    float radius = 0.f;
+    for(int i = 0; i < 3; i++){
+        radius += Box.HalfSize[i] * std::abs(glm::dot(Box.Axes[i], Axis));
+    }
+
+    float above = maximum - (center - radius);
+    float below = (center + radius) - minimum;
+
+    Sign = (above <= below) ? 1.f : -1.f;
+    return std::min(above, below);
+}
+
+//Separating axis test over the triangle's face, the box's faces and the 9 edge pairs. Normal points from the triangle
+//to the box, the face wins near ties so boxes slide over the edges between triangles
+static bool TriangleBox(const glm::vec3* Triangle, const OrientedBox& Box, glm::vec3& Normal, float& Depth){
+    glm::vec3 face;
+    if(!TriangleNormal(Triangle, Box.Center, face))
+        return false;
+
+    float sign;
+    float bestFace = TriangleBoxPenetration(Triangle, Box, face, sign);
+    if(bestFace < -CONTACT_MARGIN)
+        return false;
+
+    glm::vec3 faceNormal = face * sign;
+
+    float bestOther = FLT_MAX;
+    glm::vec3 otherNormal(0.f);
+
+    const glm::vec3 edges[3] = {Triangle[1] - Triangle[0], Triangle[2] - Triangle[1], Triangle[0] - Triangle[2]};
+
+    for(int i = 0; i < 3; i++){
+        for(int j = -1; j < 3; j++){
+            //-1 is the box's own face
+            glm::vec3 axis = (j < 0) ? Box.Axes[i] : glm::cross(Box.Axes[i], edges[j]);
+            float length = glm::length(axis);
+
+            if(length < 1e-5f)
+                continue;
+
+            axis /= length;
+
+            float penetration = TriangleBoxPenetration(Triangle, Box, axis, sign);
+            if(penetration < -CONTACT_MARGIN)
+                return false;
+
+            if(penetration < bestOther){
+                bestOther = penetration;
+                otherNormal = axis * sign;
+            }
+        }
+    }
+
+    if(bestOther < (bestFace * EDGE_RELATIVE_TOLERANCE) - EDGE_ABSOLUTE_TOLERANCE){
+        Normal = otherNormal;
+        Depth = bestOther;
+    }
+    else{
+        Normal = faceNormal;
+        Depth = bestFace;
+    }
+
+    return true;
+}
+
+//The part of the triangle inside the box grown by the margin
+static int ClipTriangleToBox(const glm::vec3* Triangle, const OrientedBox& Box, glm::vec3* Out){
+    glm::vec3 clipped[MAX_CLIP_POINTS];
+    int count = 3;
+
+    for(int i = 0; i < 3; i++){
+        Out[i] = Triangle[i];
+    }
+
+    for(int i = 0; i < 3 && count; i++){
+        float center = glm::dot(Box.Axes[i], Box.Center);
+        float extent = Box.HalfSize[i] + CONTACT_MARGIN;
+
+        count = ClipPolygon(Out, count, Box.Axes[i], center + extent, clipped);
+        count = ClipPolygon(clipped, count, -Box.Axes[i], -center + extent, Out);
+    }
+
+    return count;
+}
+
+//Normal points from the mesh to the box
+static int MeshBox(const MeshFrame& Frame, const OrientedBox& Box, ContactManifold& Manifold){
+    AABB box = {};
+    glm::vec3 extent(0.f);
+
+    for(int i = 0; i < 3; i++){
+        extent[i] = std::abs(Box.Axes[0][i]) * Box.HalfSize.x + std::abs(Box.Axes[1][i]) * Box.HalfSize.y + std::abs(Box.Axes[2][i]) * Box.HalfSize.z;
+    }
+
+    box.min = Box.Center - extent;
+    box.max = Box.Center + extent;
+
+    //Triangles touching the box, the deepest one sets the normal
+    struct Touch{
+        int Index;
+        glm::vec3 Face; //Facing the box
+    };
+
+    std::vector<Touch> touching;
+    float best = -FLT_MAX;
+    size_t deepest = 0;
+    glm::vec3 normal(0.f);
+
+    Frame.Shape->Hierarchy().Query(LocalQueryBox(Frame, box), [&](int Index){
+        glm::vec3 triangle[3];
+        WorldTriangle(Frame, Index, triangle);
+
+        glm::vec3 triangleNormal;
+        float depth;
+        if(!TriangleBox(triangle, Box, triangleNormal, depth))
+            return true;
+
+        Touch touch = {Index, glm::vec3(0.f)};
+        TriangleNormal(triangle, Box.Center, touch.Face);
+        touching.push_back(touch);
+
+        if(depth > best){
+            best = depth;
+            deepest = touching.size() - 1;
+            normal = triangleNormal;
+        }
+
+        return true;
+    });
+
+    if(touching.empty())
+        return 0;
+
+    //Box support along the normal, each point's depth is measured from it
+    float support = glm::dot(normal, Box.Center);
+    for(int i = 0; i < 3; i++){
+        support -= Box.HalfSize[i] * std::abs(glm::dot(Box.Axes[i], normal));
+    }
+
+    std::vector<ContactPoint> points;
+
+    for(auto i = touching.begin(); i != touching.end(); i++){
+        if(glm::dot(i->Face, normal) < MESH_NORMAL_TOLERANCE && i != touching.begin() + deepest)
+            continue;
+
+        glm::vec3 triangle[3];
+        WorldTriangle(Frame, i->Index, triangle);
+
+        glm::vec3 polygon[MAX_CLIP_POINTS];
+        int count = ClipTriangleToBox(triangle, Box, polygon);
+
+        for(int p = 0; p < count; p++){
+            float depth = glm::dot(normal, polygon[p]) - support;
+            if(depth < -CONTACT_MARGIN)
+                continue;
+
+            ContactPoint point = {};
+            point.Depth = depth;
+            point.Position = polygon[p] - normal * (depth * 0.5f);
+            points.push_back(point);
+        }
+    }
+
+    //Only edge contacts, one point where the box is deepest against the mesh
+    if(points.empty()){
+        ContactPoint point = {};
+        point.Depth = best;
+        point.Position = Box.Center;
+
+        for(int i = 0; i < 3; i++){
+            point.Position -= Box.Axes[i] * (Box.HalfSize[i] * ((glm::dot(Box.Axes[i], normal) > 0.f) ? 1.f : -1.f));
+        }
+
+        point.Position += normal * (best * 0.5f);
+        points.push_back(point);
+    }
+
+    Manifold.Normal = normal;
+
+    return FinishMeshManifold(points, Manifold);
+}
+
+//Overlap of two triangles on a unit Axis, Sign is 1 when B is on A's positive side
+static inline float TrianglePairPenetration(const glm::vec3* A, const glm::vec3* B, const glm::vec3& Axis, float& Sign){
+    float minA = FLT_MAX, maxA = -FLT_MAX;
+    float minB = FLT_MAX, maxB = -FLT_MAX;
+
+    for(int i = 0; i < 3; i++){
+        float a = glm::dot(A[i], Axis);
+        float b = glm::dot(B[i], Axis);
+
+        minA = std::min(minA, a);
+        maxA = std::max(maxA, a);
+        minB = std::min(minB, b);
+        maxB = std::max(maxB, b);
+    }
+
+    float above = maxA - minB;
+    float below = maxB - minA;
+
+    Sign = (above <= below) ? 1.f : -1.f;
+    return std::min(above, below);
+}
+
+//Points of one triangle pair, Normal from A to B. The triangle facing the normal more is the reference, the other is
+//clipped to the prism over it
+static int TrianglePair(const glm::vec3* A, const glm::vec3* B, std::vector<ContactPoint>& Points, glm::vec3& Normal, float& Depth){
+    glm::vec3 centerA = (A[0] + A[1] + A[2]) / 3.f;
+    glm::vec3 centerB = (B[0] + B[1] + B[2]) / 3.f;
+
+    glm::vec3 faceA = glm::cross(A[1] - A[0], A[2] - A[0]);
+    glm::vec3 faceB = glm::cross(B[1] - B[0], B[2] - B[0]);
+    if(glm::length(faceA) < 1e-12f || glm::length(faceB) < 1e-12f)
+        return 0;
+
+    faceA = glm::normalize(faceA);
+    faceB = glm::normalize(faceB);
+
+    const glm::vec3 edgesA[3] = {A[1] - A[0], A[2] - A[1], A[0] - A[2]};
+    const glm::vec3 edgesB[3] = {B[1] - B[0], B[2] - B[1], B[0] - B[2]};
+
+    float bestFace = FLT_MAX;
+    float bestEdge = FLT_MAX;
+    glm::vec3 faceNormal(0.f), edgeNormal(0.f);
+    float sign;
+
+    for(int i = 0; i < 2; i++){
+        const glm::vec3& axis = i ? faceB : faceA;
+
+        float penetration = TrianglePairPenetration(A, B, axis, sign);
+        if(penetration < -CONTACT_MARGIN)
+            return 0;
+
+        if(penetration < bestFace){
+            bestFace = penetration;
+            faceNormal = axis * sign;
+        }
+    }
+
+    //Edge pairs, then the edges within each plane which only separate (near) coplanar triangles
+    for(int i = 0; i < 15; i++){
+        glm::vec3 axis;
+        if(i < 9)
+            axis = glm::cross(edgesA[i / 3], edgesB[i % 3]);
+        else if(i < 12)
+            axis = glm::cross(faceA, edgesA[i - 9]);
+        else
+            axis = glm::cross(faceB, edgesB[i - 12]);
+
+        float length = glm::length(axis);
+        if(length < 1e-5f)
+            continue;
+
+        axis /= length;
+
+        float penetration = TrianglePairPenetration(A, B, axis, sign);
+        if(penetration < -CONTACT_MARGIN)
+            return 0;
+
+        if(penetration < bestEdge){
+            bestEdge = penetration;
+            edgeNormal = axis * sign;
+        }
+    }
+
+    bool edge = bestEdge < (bestFace * EDGE_RELATIVE_TOLERANCE) - EDGE_ABSOLUTE_TOLERANCE;
+    Normal = edge ? edgeNormal : faceNormal;
+    Depth = edge ? bestEdge : bestFace;
+
+    //Reference face and the triangle clipped against its three sides
+    bool referenceA = std::abs(glm::dot(faceA, Normal)) >= std::abs(glm::dot(faceB, Normal));
+    const glm::vec3* reference = referenceA ? A : B;
+    const glm::vec3* incident = referenceA ? B : A;
+    glm::vec3 referenceFace = referenceA ? faceA : faceB;
+    glm::vec3 referenceCenter = referenceA ? centerA : centerB;
+
+    glm::vec3 polygon[MAX_CLIP_POINTS] = {incident[0], incident[1], incident[2]};
+    glm::vec3 clipped[MAX_CLIP_POINTS];
+    int count = 3;
+
+    for(int i = 0; i < 3 && count; i++){
+        glm::vec3 side = glm::cross(reference[(i + 1) % 3] - reference[i], referenceFace);
+        float length = glm::length(side);
+        if(length < 1e-12f)
+            continue;
+
+        side /= length;
+        if(glm::dot(side, referenceCenter - reference[i]) > 0.f)
+            side = -side;
+
+        count = ClipPolygon(polygon, count, side, glm::dot(side, reference[i]) + CONTACT_MARGIN, clipped);
+        std::copy(clipped, clipped + count, polygon);
+    }
+
+    //Depth along the normal from the reference's furthest point toward the other
+    float surface = referenceA ? -FLT_MAX : FLT_MAX;
+    for(int i = 0; i < 3; i++){
+        float d = glm::dot(Normal, reference[i]);
+        surface = referenceA ? std::max(surface, d) : std::min(surface, d);
+    }
+
+    int found = 0;
+
+    for(int i = 0; i < count; i++){
+        float d = glm::dot(Normal, polygon[i]);
+        float depth = std::min(referenceA ? (surface - d) : (d - surface), Depth);
+        if(depth < -CONTACT_MARGIN)
+            continue;
+
+        ContactPoint point = {};
+        point.Depth = depth;
+        point.Position = polygon[i] + Normal * ((referenceA ? 0.5f : -0.5f) * depth);
+        Points.push_back(point);
+        found++;
+    }
+
+    //Crossing edges, halfway between the centres
+    if(!found){
+        ContactPoint point = {};
+        point.Depth = Depth;
+        point.Position = (centerA + centerB) * 0.5f;
+        Points.push_back(point);
+        found++;
+    }
+
+    return found;
+}
+
+//Normal points from A to B
+static int MeshMesh(const MeshFrame& A, const MeshFrame& B, ContactManifold& Manifold){
+    struct Touch{
+        glm::vec3 Normal;
+        size_t First;
+        size_t Count;
+    };
+
+    std::vector<Touch> touching;
+    std::vector<ContactPoint> candidates;
+    float best = -FLT_MAX;
+    glm::vec3 normal(0.f);
+
+    //B's space into A's for the walk
+    glm::mat3 linear = A.Inverse * B.Linear;
+    glm::vec3 translation = A.Inverse * (B.Translation - A.Translation);
+
+    A.Shape->Hierarchy().QueryPairs(B.Shape->Hierarchy(), linear, translation, [&](int IndexA, int IndexB){
+        glm::vec3 triangleA[3], triangleB[3];
+        WorldTriangle(A, IndexA, triangleA);
+        WorldTriangle(B, IndexB, triangleB);
+
+        Touch touch = {glm::vec3(0.f), candidates.size(), 0};
+        float depth;
+
+        touch.Count = TrianglePair(triangleA, triangleB, candidates, touch.Normal, depth);
+        if(!touch.Count)
+            return true;
+
+        touching.push_back(touch);
+
+        if(depth > best){
+            best = depth;
+            normal = touch.Normal;
+        }
+
+        return true;
+    });
+
+    if(touching.empty())
+        return 0;
+
+    std::vector<ContactPoint> points;
+
+    for(auto i = touching.begin(); i != touching.end(); i++){
+        if(glm::dot(i->Normal, normal) < MESH_NORMAL_TOLERANCE)
+            continue;
+
+        points.insert(points.end(), candidates.begin() + i->First, candidates.begin() + i->First + i->Count);
+    }
+
+    Manifold.Normal = normal;
+
+    return FinishMeshManifold(points, Manifold);
+}
+
+int UnifiedEngine::Collide(Collider* A, Collider* B, ContactManifold& Manifold){
+    Manifold.PointCount = 0;
+
+    ColliderType typeA = A->GetType();
+    ColliderType typeB = B->GetType();
+
+    if(typeA == COLLIDER_BOX && typeB == COLLIDER_BOX){
+        OrientedBox boxA, boxB;
+        if(!((BoxCollider*)A)->WorldBox(boxA) || !((BoxCollider*)B)->WorldBox(boxB))
+            return 0;
+
+        return BoxBox(boxA, boxB, Manifold);
+    }
+
+    if(typeA == COLLIDER_SPHERE && typeB == COLLIDER_SPHERE){
+        glm::vec3 centerA, centerB;
+        float radiusA, radiusB;
+        ((SphericalCollider*)A)->WorldSphere(centerA, radiusA);
+        ((SphericalCollider*)B)->WorldSphere(centerB, radiusB);
+
+        return SphereSphere(centerA, radiusA, centerB, radiusB, Manifold);
+    }
+
+    if((typeA == COLLIDER_BOX && typeB == COLLIDER_SPHERE) || (typeA == COLLIDER_SPHERE && typeB == COLLIDER_BOX)){
+        bool boxFirst = typeA == COLLIDER_BOX;
+        BoxCollider* box = (BoxCollider*)(boxFirst ? A : B);
+        SphericalCollider* sphere = (SphericalCollider*)(boxFirst ? B : A);
+
+        OrientedBox obb;
+        if(!box->WorldBox(obb))
+            return 0;
+
+        glm::vec3 center;
+        float radius;
+        sphere->WorldSphere(center, radius);
+
+        glm::vec3 normal;
+        if(!BoxSphere(obb, center, radius, normal, Manifold.Points[0]))
+            return 0;
+
+        //Box to sphere, flipped when the sphere is A
+        Manifold.Normal = boxFirst ? normal : -normal;
+        Manifold.PointCount = 1;
+
+        return 1;
+    }
+
+    if(typeA == COLLIDER_MESH && typeB == COLLIDER_MESH){
+        MeshFrame frameA, frameB;
+        if(!GetMeshFrame((MeshCollider*)A, frameA) || !GetMeshFrame((MeshCollider*)B, frameB))
+            return 0;
+
+        return MeshMesh(frameA, frameB, Manifold);
+    }
+
+    if(typeA == COLLIDER_MESH || typeB == COLLIDER_MESH){
+        bool meshFirst = typeA == COLLIDER_MESH;
+        Collider* other = meshFirst ? B : A;
+
+        MeshFrame frame;
+        if(!GetMeshFrame((MeshCollider*)(meshFirst ? A : B), frame))
+            return 0;
+
+        int found = 0;
+
+        if(other->GetType() == COLLIDER_SPHERE){
+            glm::vec3 center;
+            float radius;
+            ((SphericalCollider*)other)->WorldSphere(center, radius);
+
+            found = MeshSphere(frame, center, radius, Manifold.Normal, Manifold.Points[0]);
+            Manifold.PointCount = found;
+        }
+        else if(other->GetType() == COLLIDER_BOX){
+            OrientedBox obb;
+            if(!((BoxCollider*)other)->WorldBox(obb))
+                return 0;
+
+            found = MeshBox(frame, obb, Manifold);
+        }
+
+        //Mesh to the other shape, flipped when the mesh is B
+        if(!meshFirst)
+            Manifold.Normal = -Manifold.Normal;
+
+        return found;
+    }
+
+    return 0;
+}
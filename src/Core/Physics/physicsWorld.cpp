@@ -0,0 +1,920 @@
+#include <Unified-Engine/Core/Physics/physicsWorld.h>
+#include <Unified-Engine/Core/Physics/timeOfImpact.h>
+#include <Unified-Engine/Objects/Components/collider.h>
+#include <Unified-Engine/Objects/Components/rigidbody.h>
+#include <Unified-Engine/Objects/gameObject.h>
+#include <Unified-Engine/Objects/scriptObject.h>
+#include <Unified-Engine/Core/threadPool.h>
+#include <Unified-Engine/Debug/profiler.h>
+#include <Unified-Engine/debug.h>
+#include <GLM/geometric.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cfloat>
+#include <cmath>
+
+using namespace UnifiedEngine;
+
+PhysicsWorld* UnifiedEngine::__GLOBAL_PHYSICS_WORLD = nullptr;
+
+//Contact points closer than this to last step's keep its impulses
+constexpr float CONTACT_MATCH_DISTANCE = 0.05f;
+
+//Fewer awake manifolds than this are solved on the calling thread, handing out the islands would cost more
+constexpr size_t PARALLEL_SOLVE_MIN_MANIFOLDS = 64;
+
+static inline uint64_t ManifoldKey(int ProxyA, int ProxyB){
+    return ((uint64_t)(uint32_t)ProxyA << 32) | (uint32_t)ProxyB;
+}
+
+//Nothing on this side will move this step, so a pair of them can keep last step's manifold
+static inline bool IsResting(const Collider* collider){
+    const RigidBody* body = collider->GetBody();
+
+    if(!body)
+        return true;
+    if(body->Mass <= 0)
+        return body->Velocity == glm::vec3(0.f);
+
+    return body->IsSleeping();
+}
+
+//Friction meets in the middle, static geometry takes the body's own values
+static void MixMaterials(ContactManifold& Manifold){
+    const RigidBody* a = Manifold.A->GetBody();
+    const RigidBody* b = Manifold.B->GetBody();
+
+    float frictionA = a ? a->FrictionCoefficient() : -1.f;
+    float frictionB = b ? b->FrictionCoefficient() : -1.f;
+    if(frictionA < 0.f)
+        frictionA = frictionB;
+    if(frictionB < 0.f)
+        frictionB = frictionA;
+
+    Manifold.Friction = std::sqrt(frictionA * frictionB);
+    Manifold.Restitution = std::max(a ? a->Restitution : 0.f, b ? b->Restitution : 0.f);
+}
+
+PhysicsWorld::PhysicsWorld(AABBTree* SceneTree)
+    : QueryTree(SceneTree ? SceneTree : &LocalQueryTree)
+{
+
+}
+PhysicsWorld::~PhysicsWorld(){
+
+}
+
+//Grown by the contact margin so surfaces just apart still pair
+static inline AABB ProxyBounds(Collider* collider){
+    AABB bounds = collider->WorldBounds();
+    bounds.min -= glm::vec3(CONTACT_MARGIN * 0.5f);
+    bounds.max += glm::vec3(CONTACT_MARGIN * 0.5f);
+
+    return bounds;
+}
+
+int PhysicsWorld::AddCollider(Collider* collider){
+    AABB bounds = ProxyBounds(collider);
+
+    collider->Body = collider->Parent ? (RigidBody*)collider->Parent->GetCompoentOfType(OBJECT_RIGID_BODY) : nullptr;
+
+    //The tree's own margin keeps most moves from touching it
+    if(collider->QueryProxy < 0)
+        collider->QueryProxy = this->QueryTree->CreateProxy(bounds, (ObjectComponent*)collider);
+    else
+        this->QueryTree->MoveProxy(collider->QueryProxy, bounds);
+
+    if(collider->Proxy < 0)
+        collider->Proxy = this->Broadphase.CreateProxy(bounds, collider);
+    else
+        return this->Broadphase.MoveProxy(collider->Proxy, bounds);
+
+    return 0;
+}
+
+int PhysicsWorld::RemoveCollider(Collider* collider){
+    if(collider->Proxy < 0)
+        return 0;
+
+    this->DropContacts(collider, nullptr);
+
+    if(collider->QueryProxy >= 0)
+        this->QueryTree->DestroyProxy(collider->QueryProxy);
+    collider->QueryProxy = -1;
+
+    //It ends its touches without exit events, and queued ones can't reach it any more
+    for(size_t i = 0; i < this->Touching.size();){
+        if(this->Touching[i].A == collider || this->Touching[i].B == collider)
+            this->Touching.erase(this->Touching.begin() + i);
+        else
+            i++;
+    }
+
+    for(auto i = this->Events.begin(); i != this->Events.end(); i++){
+        if((*i).Data.Self == collider || (*i).Data.Other == collider)
+            (*i).Data.Self = nullptr;
+    }
+
+    int result = this->Broadphase.DestroyProxy(collider->Proxy);
+    collider->Proxy = -1;
+
+    return result;
+}
+
+int PhysicsWorld::AddBody(RigidBody* body){
+    if(body->SolverIndex >= 0)
+        return 0;
+
+    body->SolverIndex = (int)this->Bodies.size();
+    this->Bodies.push_back(body);
+
+    return 0;
+}
+
+int PhysicsWorld::RemoveBody(RigidBody* body){
+    if(body->SolverIndex < 0)
+        return 0;
+
+    this->DropContacts(nullptr, body);
+
+    //Last body takes its place
+    int index = body->SolverIndex;
+    this->Bodies[index] = this->Bodies.back();
+    this->Bodies[index]->SolverIndex = index;
+    this->Bodies.pop_back();
+
+    body->SolverIndex = -1;
+    body->Wake();
+
+    return 0;
+}
+
+void PhysicsWorld::DropContacts(Collider* collider, RigidBody* body){
+    //Whatever rested on it has to fall
+    for(size_t i = 0; i < this->Manifolds.size();){
+        ContactManifold& manifold = this->Manifolds[i];
+
+        bool onA = (manifold.A == collider) || (body && manifold.A->Body == body);
+        bool onB = (manifold.B == collider) || (body && manifold.B->Body == body);
+
+        if(!onA && !onB){
+            i++;
+            continue;
+        }
+
+        Collider* other = onA ? manifold.B : manifold.A;
+        if(other->Body && other->Body != body)
+            other->Body->Wake();
+
+        this->Manifolds[i] = this->Manifolds.back();
+        this->Manifolds.pop_back();
+        this->ManifoldKeys[i] = this->ManifoldKeys.back();
+        this->ManifoldKeys.pop_back();
+    }
+}
+
+void PhysicsWorld::FindContacts(){
+    //Last step's manifolds, looked up for warm starting
+    std::swap(this->Manifolds, this->OldManifolds);
+    std::swap(this->ManifoldKeys, this->OldManifoldKeys);
+    this->Manifolds.clear();
+    this->ManifoldKeys.clear();
+
+    //Keys were taken when they were made, the colliders may be gone since
+    this->OldManifoldIndex.clear();
+    for(size_t i = 0; i < this->OldManifoldKeys.size(); i++){
+        this->OldManifoldIndex[this->OldManifoldKeys[i]] = i;
+    }
+
+    this->TriggerPairs.clear();
+
+    for(auto i = this->PairList.begin(); i != this->PairList.end(); i++){
+        Collider* a = (*i).A;
+        Collider* b = (*i).B;
+
+        //Overlap only, any rigid body (Moving or not) can set one off
+        if(a->IsTrigger || b->IsTrigger){
+            if(!a->Body && !b->Body)
+                continue;
+
+            ContactManifold manifold = {};
+            bool overlapping;
+
+            //Neither moved, so whatever they were last step still holds
+            if(IsResting(a) && IsResting(b)){
+                uint64_t key = ManifoldKey(std::min(a->Proxy, b->Proxy), std::max(a->Proxy, b->Proxy));
+                auto found = std::lower_bound(this->Touching.begin(), this->Touching.end(), key, [](const TouchingPair& Pair, uint64_t Key){return Pair.Key < Key;});
+
+                overlapping = found != this->Touching.end() && (*found).Key == key;
+            }
+            else
+                overlapping = Collide(a, b, manifold) > 0;
+
+            if(overlapping)
+                this->TriggerPairs.push_back(*i);
+
+            continue;
+        }
+
+        int bodyA = (a->Body && a->Body->Mass > 0) ? a->Body->SolverIndex : -1;
+        int bodyB = (b->Body && b->Body->Mass > 0) ? b->Body->SolverIndex : -1;
+
+        //Nothing here can move
+        if(bodyA < 0 && bodyB < 0)
+            continue;
+
+        uint64_t key = ManifoldKey(a->Proxy, b->Proxy);
+        auto found = this->OldManifoldIndex.find(key);
+
+        //Asleep against asleep or static, the old manifold still holds and keeps the island together
+        if(IsResting(a) && IsResting(b)){
+            if(found != this->OldManifoldIndex.end() && this->OldManifolds[found->second].A == a && this->OldManifolds[found->second].B == b){
+                this->Manifolds.push_back(this->OldManifolds[found->second]);
+                this->Manifolds.back().BodyA = bodyA;
+                this->Manifolds.back().BodyB = bodyB;
+                this->ManifoldKeys.push_back(key);
+            }
+            continue;
+        }
+
+        ContactManifold manifold = {};
+        manifold.A = a;
+        manifold.B = b;
+
+        if(!Collide(a, b, manifold))
+            continue;
+
+        manifold.BodyA = bodyA;
+        manifold.BodyB = bodyB;
+
+        //Touched by something awake
+        if(a->Body && a->Body->IsSleeping())
+            a->Body->Wake();
+        if(b->Body && b->Body->IsSleeping())
+            b->Body->Wake();
+
+        MixMaterials(manifold);
+
+        //Points that barely moved keep their impulses
+        if(found != this->OldManifoldIndex.end()){
+            const ContactManifold& old = this->OldManifolds[found->second];
+
+            if(old.A == a && old.B == b && glm::dot(old.Normal, manifold.Normal) > 0.95f){
+                for(int p = 0; p < manifold.PointCount; p++){
+                    ContactPoint& point = manifold.Points[p];
+                    float nearest = CONTACT_MATCH_DISTANCE * CONTACT_MATCH_DISTANCE;
+
+                    for(int q = 0; q < old.PointCount; q++){
+                        glm::vec3 d = old.Points[q].Position - point.Position;
+                        if(glm::dot(d, d) < nearest){
+                            nearest = glm::dot(d, d);
+                            point.NormalImpulse = old.Points[q].NormalImpulse;
+                            point.TangentImpulse[0] = old.Points[q].TangentImpulse[0];
+                            point.TangentImpulse[1] = old.Points[q].TangentImpulse[1];
+                        }
+                    }
+                }
+            }
+        }
+
+        this->Manifolds.push_back(manifold);
+        this->ManifoldKeys.push_back(key);
+    }
+}
+
+int PhysicsWorld::FindIsland(int Body){
+    //Path halving
+    while(this->IslandParent[Body] != Body){
+        this->IslandParent[Body] = this->IslandParent[this->IslandParent[Body]];
+        Body = this->IslandParent[Body];
+    }
+
+    return Body;
+}
+
+void PhysicsWorld::BuildIslands(){
+    size_t count = this->Bodies.size();
+
+    this->IslandParent.resize(count);
+    for(size_t i = 0; i < count; i++){
+        this->IslandParent[i] = (int)i;
+    }
+
+    //Static geometry joins nothing, a floor would make one island of everything on it
+    for(auto i = this->Manifolds.begin(); i != this->Manifolds.end(); i++){
+        if((*i).BodyA < 0 || (*i).BodyB < 0)
+            continue;
+
+        int rootA = this->FindIsland((*i).BodyA);
+        int rootB = this->FindIsland((*i).BodyB);
+
+        if(rootA != rootB)
+            this->IslandParent[std::max(rootA, rootB)] = std::min(rootA, rootB);
+    }
+
+    //Roots number the islands, then a counting pass lays each island's bodies and manifolds out together
+    std::vector<int> island(count, -1);
+    this->Islands.clear();
+
+    for(size_t i = 0; i < count; i++){
+        int root = this->FindIsland((int)i);
+
+        if(island[root] < 0){
+            island[root] = (int)this->Islands.size();
+            this->Islands.push_back(PhysicsIsland{});
+        }
+
+        island[i] = island[root];
+        PhysicsIsland& current = this->Islands[island[i]];
+        current.BodyCount++;
+        current.Awake |= !this->Bodies[i]->IsSleeping();
+    }
+
+    for(auto i = this->Manifolds.begin(); i != this->Manifolds.end(); i++){
+        this->Islands[island[((*i).BodyA >= 0) ? (*i).BodyA : (*i).BodyB]].ManifoldCount++;
+    }
+
+    size_t bodyStart = 0;
+    size_t manifoldStart = 0;
+    for(auto i = this->Islands.begin(); i != this->Islands.end(); i++){
+        (*i).BodyStart = bodyStart;
+        (*i).ManifoldStart = manifoldStart;
+        bodyStart += (*i).BodyCount;
+        manifoldStart += (*i).ManifoldCount;
+
+        //Counts again as the ranges fill
+        (*i).BodyCount = 0;
+        (*i).ManifoldCount = 0;
+    }
+
+    this->IslandBodies.resize(count);
+    this->IslandManifolds.resize(this->Manifolds.size());
+
+    for(size_t i = 0; i < count; i++){
+        PhysicsIsland& current = this->Islands[island[i]];
+        this->IslandBodies[current.BodyStart + current.BodyCount++] = (int)i;
+
+        //One awake body wakes its whole island
+        if(current.Awake && this->Bodies[i]->IsSleeping())
+            this->Bodies[i]->Wake();
+    }
+
+    for(auto i = this->Manifolds.begin(); i != this->Manifolds.end(); i++){
+        PhysicsIsland& current = this->Islands[island[((*i).BodyA >= 0) ? (*i).BodyA : (*i).BodyB]];
+        this->IslandManifolds[current.ManifoldStart + current.ManifoldCount++] = &(*i);
+    }
+}
+
+void PhysicsWorld::Solve(float DeltaTime){
+    this->SolverBodies.resize(this->Bodies.size());
+
+    for(size_t i = 0; i < this->Bodies.size(); i++){
+        RigidBody* body = this->Bodies[i];
+        SolverBody& solver = this->SolverBodies[i];
+
+        if(body->IsSleeping())
+            continue;
+
+        body->UpdateMassProperties();
+
+        solver.Velocity = body->Velocity;
+        solver.AngularVelocity = body->AngularVelocity;
+        solver.InverseMass = body->InverseMass();
+        solver.InverseInertia = body->InverseInertia();
+        solver.Center = body->Parent->transform.Position;
+    }
+
+    //Islands share no bodies, so each can be solved on its own thread
+    std::vector<const PhysicsIsland*> awake;
+    size_t manifolds = 0;
+
+    for(auto i = this->Islands.begin(); i != this->Islands.end(); i++){
+        if(!(*i).Awake || !(*i).ManifoldCount)
+            continue;
+
+        awake.push_back(&(*i));
+        manifolds += (*i).ManifoldCount;
+    }
+
+    //Biggest first so one large island doesn't start last
+    std::sort(awake.begin(), awake.end(), [](const PhysicsIsland* A, const PhysicsIsland* B){return A->ManifoldCount > B->ManifoldCount;});
+
+    auto solve = [this, &awake, DeltaTime](size_t Begin, size_t End){
+        for(size_t i = Begin; i < End; i++){
+            SolveContactGroup(this->IslandManifolds.data() + awake[i]->ManifoldStart, awake[i]->ManifoldCount, this->SolverBodies.data(), DeltaTime, this->Settings);
+        }
+    };
+
+    if(__GLOBAL_THREAD_POOL && awake.size() > 1 && manifolds >= PARALLEL_SOLVE_MIN_MANIFOLDS)
+        __GLOBAL_THREAD_POOL->ParallelFor(awake.size(), 1, solve);
+    else
+        solve(0, awake.size());
+
+    for(size_t i = 0; i < this->Bodies.size(); i++){
+        if(this->Bodies[i]->IsSleeping())
+            continue;
+
+        this->Bodies[i]->Velocity = this->SolverBodies[i].Velocity;
+        this->Bodies[i]->AngularVelocity = this->SolverBodies[i].AngularVelocity;
+    }
+}
+
+void PhysicsWorld::UpdateSleeping(float DeltaTime){
+    this->SleepingCount = 0;
+
+    float limit = this->SleepVelocity * this->SleepVelocity;
+
+    for(auto i = this->Islands.begin(); i != this->Islands.end(); i++){
+        if(!(*i).Awake){
+            this->SleepingCount += (*i).BodyCount;
+            continue;
+        }
+
+        //The island sleeps once its most recently moving body has rested long enough
+        float rested = FLT_MAX;
+
+        for(size_t j = (*i).BodyStart; j < (*i).BodyStart + (*i).BodyCount; j++){
+            RigidBody* body = this->Bodies[this->IslandBodies[j]];
+
+            bool resting = body->CanSleep && body->Mass > 0 && glm::dot(body->Velocity, body->Velocity) < limit && glm::dot(body->AngularVelocity, body->AngularVelocity) < limit;
+
+            body->SleepTimer = resting ? body->SleepTimer + DeltaTime : 0.f;
+            rested = std::min(rested, body->SleepTimer);
+        }
+
+        if(this->SleepTime <= 0.f || rested < this->SleepTime)
+            continue;
+
+        for(size_t j = (*i).BodyStart; j < (*i).BodyStart + (*i).BodyCount; j++){
+            RigidBody* body = this->Bodies[this->IslandBodies[j]];
+
+            body->Sleeping = true;
+            body->Velocity = glm::vec3(0.f);
+            body->AngularVelocity = glm::vec3(0.f);
+            body->SleepPosition = body->Parent->transform.Position;
+        }
+
+        (*i).Awake = false;
+        this->SleepingCount += (*i).BodyCount;
+    }
+}
+
+void PhysicsWorld::SweepBullets(float DeltaTime){
+    this->Bullets.clear();
+
+    for(auto i = this->Bodies.begin(); i != this->Bodies.end(); i++){
+        RigidBody* body = (*i);
+        if(!body->Bullet || body->IsSleeping())
+            continue;
+
+        this->Bullets.push_back(body);
+
+        glm::vec3 motion = body->Velocity * DeltaTime * body->PositionLock;
+
+        for(auto c = body->Parent->Components.begin(); c != body->Parent->Components.end(); c++){
+            if((*c)->type != OBJECT_COLLIDER || ((Collider*)(*c))->Proxy < 0)
+                continue;
+
+            Collider* collider = (Collider*)(*c);
+
+            AABB bounds = collider->WorldBounds();
+            bounds.min += glm::min(motion, glm::vec3(0.f)) - glm::vec3(CONTACT_MARGIN * 0.5f);
+            bounds.max += glm::max(motion, glm::vec3(0.f)) + glm::vec3(CONTACT_MARGIN * 0.5f);
+
+            this->Broadphase.MoveProxy(collider->Proxy, bounds);
+        }
+    }
+
+    this->BulletCount = this->Bullets.size();
+}
+
+void PhysicsWorld::SyncProxies(){
+    //Colliders only re-register once a frame, a frame taking several steps would pair the later ones against old boxes
+    for(size_t i = 0; i < this->Broadphase.Capacity(); i++){
+        Collider* collider = (Collider*)this->Broadphase.Data((int)i);
+        if(!collider)
+            continue;
+
+        AABB bounds = ProxyBounds(collider);
+
+        this->Broadphase.MoveProxy((int)i, bounds);
+        if(collider->QueryProxy >= 0)
+            this->QueryTree->MoveProxy(collider->QueryProxy, bounds);
+    }
+}
+
+void PhysicsWorld::AdvanceBullets(float DeltaTime){
+    for(auto i = this->Bullets.begin(); i != this->Bullets.end(); i++){
+        RigidBody* body = (*i);
+
+        float remaining = DeltaTime;
+        bool blocked = false;
+
+        for(unsigned step = 0; step < this->BulletSubsteps && !blocked; step++){
+            glm::vec3 motion = body->Velocity * remaining * body->PositionLock;
+
+            //Earliest hit among what its swept proxies paired with
+            float first = FLT_MAX;
+            ColliderPair hit = {nullptr, nullptr};
+
+            for(auto p = this->BulletPairs.begin(); p != this->BulletPairs.end(); p++){
+                if((*p).A->IsTrigger || (*p).B->IsTrigger)
+                    continue;
+
+                float fraction;
+                if((*p).A->Body == body && TimeOfImpact((*p).A, motion, (*p).B, fraction) && fraction < first){
+                    first = fraction;
+                    hit = (*p);
+                }
+            }
+
+            if(!hit.A)
+                break;
+
+            //Up to the hit, stopping short by half the contact margin so the contact finds them touching
+            float length = glm::length(motion);
+            float travel = first - ((length > 1e-6f) ? std::min(first, (CONTACT_MARGIN * 0.5f) / length) : first);
+
+            body->IntegratePosition(remaining * travel);
+            remaining -= remaining * first;
+
+            ContactManifold manifold = {};
+            manifold.A = hit.A;
+            manifold.B = hit.B;
+
+            //Nothing to push off (A corner the sweep rounded), it waits there for the next step
+            if(!Collide(hit.A, hit.B, manifold)){
+                blocked = true;
+                break;
+            }
+
+            //Solved on its own with whatever it hit, static geometry holds still
+            RigidBody* target = (hit.B->Body && hit.B->Body != body && hit.B->Body->Mass > 0) ? hit.B->Body : nullptr;
+
+            //Touched by something awake
+            if(target && target->IsSleeping())
+                target->Wake();
+
+            manifold.BodyA = 0;
+            manifold.BodyB = target ? 1 : -1;
+            MixMaterials(manifold);
+
+            RigidBody* solved[2] = {body, target};
+            SolverBody solvers[2] = {};
+
+            for(int k = 0; k < 2 && solved[k]; k++){
+                solved[k]->UpdateMassProperties();
+
+                solvers[k].Velocity = solved[k]->Velocity;
+                solvers[k].AngularVelocity = solved[k]->AngularVelocity;
+                solvers[k].InverseMass = solved[k]->InverseMass();
+                solvers[k].InverseInertia = solved[k]->InverseInertia();
+                solvers[k].Center = solved[k]->Parent->transform.Position;
+            }
+
+            ContactManifold* manifolds = &manifold;
+            SolveContactGroup(&manifolds, 1, solvers, DeltaTime, this->Settings);
+
+            for(int k = 0; k < 2 && solved[k]; k++){
+                solved[k]->Velocity = solvers[k].Velocity;
+                solved[k]->AngularVelocity = solvers[k].AngularVelocity;
+            }
+
+            //Out of substeps, the new velocity hasn't been swept
+            blocked = step + 1 >= this->BulletSubsteps;
+        }
+
+        if(!blocked && remaining > 0.f)
+            body->IntegratePosition(remaining);
+    }
+}
+
+int PhysicsWorld::Step(float DeltaTime){
+    if(DeltaTime <= 0.f)
+        return 0;
+
+    {
+        Debug::ProfileScope profile("Physics Integrate");
+
+        for(auto i = this->Bodies.begin(); i != this->Bodies.end(); i++){
+            RigidBody* body = (*i);
+
+            //Pushed or moved by hand since it fell asleep
+            if(body->IsSleeping() && (body->Velocity != glm::vec3(0.f) || body->AngularVelocity != glm::vec3(0.f) || body->Acceleration != glm::vec3(0.f) || body->Parent->transform.Position != body->SleepPosition))
+                body->Wake();
+
+            if(!body->IsSleeping())
+                body->IntegrateVelocity(DeltaTime);
+        }
+    }
+
+    {
+        Debug::ProfileScope profile("Physics Broadphase");
+
+        this->SyncProxies();
+
+        //Velocities are known now, so bullets pair with everything along the way
+        this->SweepBullets(DeltaTime);
+
+        this->Broadphase.Update();
+
+        this->PairList.clear();
+        this->BulletPairs.clear();
+
+        const std::vector<BroadphasePair>& pairs = this->Broadphase.Pairs();
+        for(auto i = pairs.begin(); i != pairs.end(); i++){
+            Collider* a = (Collider*)this->Broadphase.Data((*i).ProxyA);
+            Collider* b = (Collider*)this->Broadphase.Data((*i).ProxyB);
+
+            if(a->Parent != b->Parent)
+                this->PairList.push_back(ColliderPair{a, b});
+        }
+
+        //Contacts are solved in pair order, which has to come out the same however the boxes got here
+        if(this->Deterministic){
+            std::sort(this->PairList.begin(), this->PairList.end(), [](const ColliderPair& A, const ColliderPair& B){
+                return ManifoldKey(A.A->Proxy, A.B->Proxy) < ManifoldKey(B.A->Proxy, B.B->Proxy);
+            });
+        }
+
+        for(auto i = this->PairList.begin(); i != this->PairList.end(); i++){
+            Collider* a = (*i).A;
+            Collider* b = (*i).B;
+
+            if(a->Body && a->Body->Bullet && !a->Body->IsSleeping())
+                this->BulletPairs.push_back(ColliderPair{a, b});
+            if(b->Body && b->Body->Bullet && !b->Body->IsSleeping())
+                this->BulletPairs.push_back(ColliderPair{b, a});
+        }
+    }
+
+    {
+        Debug::ProfileScope profile("Physics Narrowphase");
+        this->FindContacts();
+    }
+
+    {
+        Debug::ProfileScope profile("Physics Islands");
+        this->BuildIslands();
+    }
+
+    {
+        Debug::ProfileScope profile("Physics Solver");
+        auto start = std::chrono::steady_clock::now();
+
+        this->Solve(DeltaTime);
+
+        this->SolverMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    {
+        Debug::ProfileScope profile("Physics Integrate");
+
+        for(auto i = this->Bodies.begin(); i != this->Bodies.end(); i++){
+            if(!(*i)->IsSleeping() && !(*i)->Bullet)
+                (*i)->IntegratePosition(DeltaTime);
+        }
+    }
+
+    {
+        Debug::ProfileScope profile("Physics Bullets");
+        this->AdvanceBullets(DeltaTime);
+    }
+
+    {
+        Debug::ProfileScope profile("Physics Integrate");
+        this->UpdateSleeping(DeltaTime);
+    }
+
+    this->ColliderCount = this->Broadphase.Count();
+    this->PairCount = this->PairList.size();
+    this->IslandCount = this->Islands.size();
+    this->ContactCount = 0;
+    for(auto i = this->Manifolds.begin(); i != this->Manifolds.end(); i++){
+        this->ContactCount += (*i).PointCount;
+    }
+
+    this->QueueEvents();
+
+    this->StepIndex++;
+
+    if(this->Deterministic || this->HashRecord || this->HashExpected){
+        this->LastStateHash = this->StateHash();
+
+        uint64_t index = this->StepIndex - this->HashStart - 1;
+
+        if(this->HashRecord)
+            this->HashRecord->push_back(this->LastStateHash);
+
+        if(this->HashExpected && this->DivergedStep < 0 && index < this->HashExpected->size() && (*this->HashExpected)[index] != this->LastStateHash){
+            this->DivergedStep = (int64_t)index;
+            WARN("Physics replay diverged at step ", index);
+        }
+    }
+
+    return 0;
+}
+
+int PhysicsWorld::Advance(float FrameTime){
+    int steps = 0;
+
+    if(!this->Deterministic){
+        if(FrameTime > 0.f && this->Step(FrameTime) == 0)
+            steps = 1;
+    }
+    else if(this->FixedTimeStep > 0.f){
+        this->Accumulator += std::max(FrameTime, 0.f);
+
+        while(this->Accumulator >= this->FixedTimeStep && (unsigned)steps < this->MaxStepsPerFrame){
+            this->Step(this->FixedTimeStep);
+            this->Accumulator -= this->FixedTimeStep;
+            steps++;
+        }
+
+        //Behind by more than a frame's worth, catching up would only make the next frame slower
+        if(this->Accumulator >= this->FixedTimeStep)
+            this->Accumulator = std::fmod(this->Accumulator, this->FixedTimeStep);
+    }
+
+    this->DispatchEvents();
+
+    return steps;
+}
+
+//One event for each side, as that side sees it
+static void PushEvents(std::vector<CollisionEvent>& Events, CollisionEventType Type, const TouchingPair& Pair, const ContactManifold* Manifold){
+    Collision collision = {};
+    collision.Self = Pair.A;
+    collision.Other = Pair.B;
+
+    if(Manifold){
+        collision.Normal = -Manifold->Normal;
+
+        for(int p = 0; p < Manifold->PointCount; p++){
+            collision.Point += Manifold->Points[p].Position;
+            collision.Impulse += Manifold->Points[p].NormalImpulse;
+        }
+        collision.Point /= (float)std::max(Manifold->PointCount, 1);
+    }
+
+    Events.push_back(CollisionEvent{Type, collision});
+
+    std::swap(collision.Self, collision.Other);
+    collision.Normal = -collision.Normal;
+    Events.push_back(CollisionEvent{Type, collision});
+}
+
+void PhysicsWorld::QueueEvents(){
+    this->NextTouching.clear();
+
+    for(size_t i = 0; i < this->Manifolds.size(); i++){
+        if(this->Manifolds[i].PointCount > 0)
+            this->NextTouching.push_back(TouchingPair{this->ManifoldKeys[i], this->Manifolds[i].A, this->Manifolds[i].B, false, (int)i});
+    }
+
+    for(auto i = this->TriggerPairs.begin(); i != this->TriggerPairs.end(); i++){
+        this->NextTouching.push_back(TouchingPair{ManifoldKey(std::min((*i).A->Proxy, (*i).B->Proxy), std::max((*i).A->Proxy, (*i).B->Proxy)), (*i).A, (*i).B, true, -1});
+    }
+
+    std::sort(this->NextTouching.begin(), this->NextTouching.end(), [](const TouchingPair& A, const TouchingPair& B){return A.Key < B.Key;});
+
+    //Both sorted, walked together like a merge
+    size_t a = 0, b = 0;
+    while(a < this->Touching.size() || b < this->NextTouching.size()){
+        bool old = b >= this->NextTouching.size() || (a < this->Touching.size() && this->Touching[a].Key < this->NextTouching[b].Key);
+        bool fresh = a >= this->Touching.size() || (b < this->NextTouching.size() && this->NextTouching[b].Key < this->Touching[a].Key);
+
+        if(old){
+            const TouchingPair& pair = this->Touching[a++];
+            PushEvents(this->Events, pair.Trigger ? TRIGGER_EXIT : COLLISION_EXIT, pair, nullptr);
+            continue;
+        }
+
+        const TouchingPair& pair = this->NextTouching[b++];
+        if(!fresh)
+            a++;
+
+        const ContactManifold* contact = (pair.Manifold >= 0) ? &this->Manifolds[pair.Manifold] : nullptr;
+
+        if(fresh)
+            PushEvents(this->Events, pair.Trigger ? TRIGGER_ENTER : COLLISION_ENTER, pair, contact);
+        else
+            PushEvents(this->Events, pair.Trigger ? TRIGGER_STAY : COLLISION_STAY, pair, contact);
+    }
+
+    std::swap(this->Touching, this->NextTouching);
+}
+
+static void Deliver(ScriptableObject* Script, const CollisionEvent& Event){
+    switch(Event.Type){
+    case COLLISION_ENTER: Script->OnCollisionEnter(Event.Data); break;
+    case COLLISION_STAY: Script->OnCollisionStay(Event.Data); break;
+    case COLLISION_EXIT: Script->OnCollisionExit(Event.Data); break;
+    case TRIGGER_ENTER: Script->OnTriggerEnter(Event.Data); break;
+    case TRIGGER_STAY: Script->OnTriggerStay(Event.Data); break;
+    case TRIGGER_EXIT: Script->OnTriggerExit(Event.Data); break;
+    }
+}
+
+int PhysicsWorld::OwnerKey(Collider* collider){
+    if(!collider->Parent)
+        return collider->Proxy;
+
+    int key = collider->Proxy;
+    for(auto c = collider->Parent->Components.begin(); c != collider->Parent->Components.end(); c++){
+        if((*c)->type == OBJECT_COLLIDER && ((Collider*)(*c))->Proxy >= 0)
+            key = std::min(key, ((Collider*)(*c))->Proxy);
+    }
+
+    return key;
+}
+
+void PhysicsWorld::DispatchEvents(){
+    //Colliders removed since their step
+    this->Events.erase(std::remove_if(this->Events.begin(), this->Events.end(), [](const CollisionEvent& Event){return !Event.Data.Self;}), this->Events.end());
+
+    if(this->Events.empty())
+        return;
+
+    for(auto i = this->Events.begin(); i != this->Events.end(); i++){
+        (*i).Owner = OwnerKey((*i).Data.Self);
+    }
+
+    //By object, then collider. Proxies rather than pointers so the order is the same every run
+    std::sort(this->Events.begin(), this->Events.end(), [](const CollisionEvent& A, const CollisionEvent& B){
+        if(A.Owner != B.Owner)
+            return A.Owner < B.Owner;
+        if(A.Data.Self->Proxy != B.Data.Self->Proxy)
+            return A.Data.Self->Proxy < B.Data.Self->Proxy;
+        if(A.Type != B.Type)
+            return A.Type < B.Type;
+        return A.Data.Other->Proxy < B.Data.Other->Proxy;
+    });
+
+    //Each object's run of events goes through its scripts once. A script removing a collider blanks its events
+    for(size_t start = 0; start < this->Events.size();){
+        int owner = this->Events[start].Owner;
+        ObjectComponent* object = nullptr;
+
+        size_t end = start;
+        while(end < this->Events.size() && this->Events[end].Owner == owner){
+            if(!object && this->Events[end].Data.Self)
+                object = this->Events[end].Data.Self->Parent;
+            end++;
+        }
+
+        if(object){
+            for(auto c = object->Components.begin(); c != object->Components.end(); c++){
+                if((*c)->type != OBJECT_SCRIPTABLE_OBJECT || !(*c)->Enabled)
+                    continue;
+
+                for(size_t i = start; i < end; i++){
+                    if(this->Events[i].Data.Self)
+                        Deliver((ScriptableObject*)(*c), this->Events[i]);
+                }
+            }
+        }
+
+        start = end;
+    }
+
+    this->Events.clear();
+}
+
+static inline void HashBytes(uint64_t& Hash, const void* Data, size_t Size){
+    const unsigned char* bytes = (const unsigned char*)Data;
+
+    for(size_t i = 0; i < Size; i++){
+        Hash ^= bytes[i];
+        Hash *= 0x100000001B3ull;
+    }
+}
+
+uint64_t PhysicsWorld::StateHash() const{
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    for(auto i = this->Bodies.begin(); i != this->Bodies.end(); i++){
+        RigidBody* body = (*i);
+        Transform& transform = body->Parent->transform;
+        unsigned char sleeping = body->IsSleeping() ? 1 : 0;
+
+        HashBytes(hash, &transform.Position, sizeof(glm::vec3));
+        HashBytes(hash, &transform.Quaternion(), sizeof(glm::quat));
+        HashBytes(hash, &body->Velocity, sizeof(glm::vec3));
+        HashBytes(hash, &body->AngularVelocity, sizeof(glm::vec3));
+        HashBytes(hash, &sleeping, sizeof(sleeping));
+    }
+
+    return hash;
+}
+
+void PhysicsWorld::RecordHashes(std::vector<uint64_t>* Log){
+    this->HashRecord = Log;
+    this->HashStart = this->StepIndex;
+}
+
+void PhysicsWorld::VerifyHashes(const std::vector<uint64_t>* Expected){
+    this->HashExpected = Expected;
+    this->HashStart = this->StepIndex;
+    this->DivergedStep = -1;
+}
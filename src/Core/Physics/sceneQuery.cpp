@@ -0,0 +1,483 @@
+#include <Unified-Engine/Core/Physics/physicsWorld.h>
+#include <Unified-Engine/Core/Physics/timeOfImpact.h>
+#include <Unified-Engine/Core/Physics/triangleMesh.h>
+#include <Unified-Engine/Objects/Components/collider.h>
+#include <Unified-Engine/Core/threadPool.h>
+#include <GLM/common.hpp>
+#include <GLM/geometric.hpp>
+#include <GLM/matrix.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace UnifiedEngine;
+
+//Rays handed to each worker of a batch
+constexpr size_t RAYCAST_BATCH_GRAIN = 64;
+
+//The tree can be the scene tree, only collider proxies count
+static inline Collider* QueriedCollider(const AABBTree* Tree, int Proxy){
+    ObjectComponent* object = (ObjectComponent*)Tree->Data(Proxy);
+    return (object->type == OBJECT_COLLIDER) ? (Collider*)object : nullptr;
+}
+
+static inline bool InLayers(const Collider* collider, uint32_t LayerMask){
+    return collider->Layer < 32 && (LayerMask & (1u << collider->Layer)) != 0;
+}
+
+static inline glm::vec3 ClosestPointOnBox(const glm::vec3& Point, const OrientedBox& Box){
+    glm::vec3 local = glm::transpose(Box.Axes) * (Point - Box.Center);
+    return Box.Center + Box.Axes * glm::clamp(local, -Box.HalfSize, Box.HalfSize);
+}
+
+static bool RaySphere(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, const glm::vec3& Center, float Radius, float& Distance, glm::vec3& Normal){
+    glm::vec3 offset = Origin - Center;
+    float c = glm::dot(offset, offset) - (Radius * Radius);
+
+    if(c <= 0.f){
+        Distance = 0.f;
+        Normal = -Direction;
+        return true;
+    }
+
+    float b = glm::dot(offset, Direction);
+    float discriminant = (b * b) - c;
+    if(b > 0.f || discriminant < 0.f)
+        return false;
+
+    float t = -b - std::sqrt(discriminant);
+    if(t > MaxDistance)
+        return false;
+
+    Distance = std::max(t, 0.f);
+    Normal = glm::normalize(Origin + (Direction * Distance) - Center);
+    return true;
+}
+
+//Slab test in the box's space, the last axis entered gives the normal
+static bool RayBox(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, const OrientedBox& Box, float& Distance, glm::vec3& Normal){
+    glm::mat3 toLocal = glm::transpose(Box.Axes);
+    glm::vec3 origin = toLocal * (Origin - Box.Center);
+    glm::vec3 direction = toLocal * Direction;
+
+    float enter = 0.f;
+    float exit = MaxDistance;
+    int axis = -1;
+    float side = 0.f;
+
+    for(int i = 0; i < 3; i++){
+        if(std::abs(direction[i]) < 1e-12f){
+            if(origin[i] < -Box.HalfSize[i] || origin[i] > Box.HalfSize[i])
+                return false;
+            continue;
+        }
+
+        float inverse = 1.f / direction[i];
+        float first = (-Box.HalfSize[i] - origin[i]) * inverse;
+        float second = (Box.HalfSize[i] - origin[i]) * inverse;
+        float sign = -1.f;
+
+        if(first > second){
+            std::swap(first, second);
+            sign = 1.f;
+        }
+
+        if(first > enter){
+            enter = first;
+            axis = i;
+            side = sign;
+        }
+        exit = std::min(exit, second);
+
+        if(enter > exit)
+            return false;
+    }
+
+    Distance = enter;
+    Normal = (axis < 0) ? -Direction : Box.Axes[axis] * side;
+    return true;
+}
+
+//Two sided Moller-Trumbore, t along Direction
+static bool RayTriangle(const glm::vec3& Origin, const glm::vec3& Direction, const glm::vec3& A, const glm::vec3& B, const glm::vec3& C, float& Distance){
+    glm::vec3 ab = B - A;
+    glm::vec3 ac = C - A;
+    glm::vec3 p = glm::cross(Direction, ac);
+
+    float determinant = glm::dot(ab, p);
+    if(std::abs(determinant) < 1e-12f)
+        return false;
+
+    float inverse = 1.f / determinant;
+    glm::vec3 offset = Origin - A;
+
+    float u = glm::dot(offset, p) * inverse;
+    if(u < 0.f || u > 1.f)
+        return false;
+
+    glm::vec3 q = glm::cross(offset, ab);
+    float v = glm::dot(Direction, q) * inverse;
+    if(v < 0.f || u + v > 1.f)
+        return false;
+
+    Distance = glm::dot(ac, q) * inverse;
+    return Distance >= 0.f;
+}
+
+//The ray is moved into the mesh's space, where lengths are scaled, so distances are converted both ways
+static bool RayMesh(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, MeshCollider* Mesh, float& Distance, glm::vec3& Normal){
+    const TriangleMesh& shape = Mesh->GetShape();
+    if(shape.Empty())
+        return false;
+
+    glm::mat3 linear;
+    glm::vec3 translation;
+    Mesh->WorldTransform(linear, translation);
+
+    if(std::abs(glm::determinant(linear)) < 1e-12f)
+        return false;
+
+    glm::mat3 inverse = glm::inverse(linear);
+    glm::vec3 origin = inverse * (Origin - translation);
+    glm::vec3 direction = inverse * Direction;
+
+    float scale = glm::length(direction);
+    if(scale < 1e-12f)
+        return false;
+
+    glm::vec3 unit = direction / scale;
+    float best = MaxDistance;
+    int hit = -1;
+
+    shape.Hierarchy().RayCast(origin, unit, (MaxDistance < FLT_MAX / scale) ? MaxDistance * scale : FLT_MAX, [&](int Index, float Max){
+        glm::vec3 a, b, c;
+        shape.Triangle(Index, a, b, c);
+
+        float t;
+        if(RayTriangle(origin, direction, a, b, c, t) && t <= best){
+            best = t;
+            hit = Index;
+            return (best < FLT_MAX / scale) ? best * scale : FLT_MAX;
+        }
+
+        return Max;
+    });
+
+    if(hit < 0)
+        return false;
+
+    glm::vec3 a, b, c;
+    shape.Triangle(hit, a, b, c);
+
+    //Normals go through the inverse transpose to stay perpendicular under scale
+    Normal = glm::transpose(inverse) * glm::cross(b - a, c - a);
+    float length = glm::length(Normal);
+    Normal = (length > 1e-12f) ? Normal / length : -Direction;
+
+    if(glm::dot(Normal, Direction) > 0.f)
+        Normal = -Normal;
+
+    Distance = best;
+    return true;
+}
+
+static bool RayCollider(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, Collider* collider, float& Distance, glm::vec3& Normal){
+    switch(collider->GetType()){
+    case COLLIDER_SPHERE:{
+        glm::vec3 center;
+        float radius;
+        ((SphericalCollider*)collider)->WorldSphere(center, radius);
+
+        return RaySphere(Origin, Direction, MaxDistance, center, radius, Distance, Normal);
+    }
+    case COLLIDER_BOX:{
+        OrientedBox box;
+        if(!((BoxCollider*)collider)->WorldBox(box))
+            return false;
+
+        return RayBox(Origin, Direction, MaxDistance, box, Distance, Normal);
+    }
+    case COLLIDER_MESH:
+        return RayMesh(Origin, Direction, MaxDistance, (MeshCollider*)collider, Distance, Normal);
+    }
+
+    return false;
+}
+
+//Closest point of a collider's surface (Or inside it) to Point, within Radius for meshes
+static bool ClosestPointOnCollider(Collider* collider, const glm::vec3& Point, float Radius, glm::vec3& Out){
+    switch(collider->GetType()){
+    case COLLIDER_SPHERE:{
+        glm::vec3 center;
+        float radius;
+        ((SphericalCollider*)collider)->WorldSphere(center, radius);
+
+        glm::vec3 offset = Point - center;
+        float length = glm::length(offset);
+        Out = (length > radius) ? center + (offset * (radius / length)) : Point;
+        return true;
+    }
+    case COLLIDER_BOX:{
+        OrientedBox box;
+        if(!((BoxCollider*)collider)->WorldBox(box))
+            return false;
+
+        Out = ClosestPointOnBox(Point, box);
+        return true;
+    }
+    case COLLIDER_MESH:{
+        MeshCollider* mesh = (MeshCollider*)collider;
+        const TriangleMesh& shape = mesh->GetShape();
+
+        glm::mat3 linear;
+        glm::vec3 translation;
+        mesh->WorldTransform(linear, translation);
+
+        if(std::abs(glm::determinant(linear)) < 1e-12f)
+            return false;
+
+        AABB around = {};
+        around.min = Point - glm::vec3(Radius);
+        around.max = Point + glm::vec3(Radius);
+
+        glm::mat3 inverse = glm::inverse(linear);
+        float best = FLT_MAX;
+
+        shape.Hierarchy().Query(around.transformed(inverse, -(inverse * translation)), [&](int Index){
+            glm::vec3 a, b, c;
+            shape.Triangle(Index, a, b, c);
+
+            glm::vec3 closest = ClosestPointOnTriangle(Point, (linear * a) + translation, (linear * b) + translation, (linear * c) + translation);
+            glm::vec3 offset = closest - Point;
+
+            float distance = glm::dot(offset, offset);
+            if(distance < best){
+                best = distance;
+                Out = closest;
+            }
+
+            return true;
+        });
+
+        return best <= Radius * Radius;
+    }
+    }
+
+    return false;
+}
+
+bool PhysicsWorld::Raycast(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, RaycastHit& Hit, uint32_t LayerMask) const{
+    Hit = RaycastHit{};
+
+    float length = glm::length(Direction);
+    if(length < 1e-12f || MaxDistance < 0.f)
+        return false;
+
+    glm::vec3 direction = Direction / length;
+
+    this->QueryTree->RayCast(Origin, direction, MaxDistance, [&](int Proxy, float Max){
+        Collider* collider = QueriedCollider(this->QueryTree, Proxy);
+        if(!collider || !InLayers(collider, LayerMask))
+            return Max;
+
+        float distance;
+        glm::vec3 normal;
+        if(!RayCollider(Origin, direction, Max, collider, distance, normal))
+            return Max;
+
+        Hit.HitCollider = collider;
+        Hit.Object = collider->Parent;
+        Hit.Point = Origin + (direction * distance);
+        Hit.Normal = normal;
+        Hit.Distance = distance;
+
+        return distance;
+    });
+
+    return Hit.HitCollider != nullptr;
+}
+
+size_t PhysicsWorld::RaycastAll(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, std::vector<RaycastHit>& Hits, uint32_t LayerMask) const{
+    Hits.clear();
+
+    float length = glm::length(Direction);
+    if(length < 1e-12f || MaxDistance < 0.f)
+        return 0;
+
+    glm::vec3 direction = Direction / length;
+
+    this->QueryTree->RayCast(Origin, direction, MaxDistance, [&](int Proxy, float Max){
+        Collider* collider = QueriedCollider(this->QueryTree, Proxy);
+        if(!collider || !InLayers(collider, LayerMask))
+            return Max;
+
+        RaycastHit hit;
+        if(!RayCollider(Origin, direction, Max, collider, hit.Distance, hit.Normal))
+            return Max;
+
+        hit.HitCollider = collider;
+        hit.Object = collider->Parent;
+        hit.Point = Origin + (direction * hit.Distance);
+        Hits.push_back(hit);
+
+        return Max;
+    });
+
+    std::sort(Hits.begin(), Hits.end(), [](const RaycastHit& A, const RaycastHit& B){
+        return A.Distance < B.Distance;
+    });
+
+    return Hits.size();
+}
+
+bool PhysicsWorld::SphereCast(const glm::vec3& Origin, float Radius, const glm::vec3& Direction, float MaxDistance, RaycastHit& Hit, uint32_t LayerMask) const{
+    Hit = RaycastHit{};
+
+    float length = glm::length(Direction);
+    if(length < 1e-12f || Radius < 0.f || !(MaxDistance >= 0.f && MaxDistance < FLT_MAX))
+        return false;
+
+    glm::vec3 direction = Direction / length;
+    glm::vec3 motion = direction * MaxDistance;
+
+    AABB swept = {};
+    swept.min = glm::min(Origin, Origin + motion) - glm::vec3(Radius);
+    swept.max = glm::max(Origin, Origin + motion) + glm::vec3(Radius);
+
+    float best = 1.f;
+
+    this->QueryTree->Query(swept, [&](int Proxy){
+        Collider* collider = QueriedCollider(this->QueryTree, Proxy);
+        if(!collider || !InLayers(collider, LayerMask))
+            return true;
+
+        float fraction;
+        if(SweepSphere(Origin, Radius, motion, collider, fraction) && fraction <= best){
+            best = fraction;
+            Hit.HitCollider = collider;
+        }
+
+        return true;
+    });
+
+    if(!Hit.HitCollider)
+        return false;
+
+    Hit.Object = Hit.HitCollider->Parent;
+    Hit.Distance = best * MaxDistance;
+
+    //Where the sphere stops, touching the surface
+    glm::vec3 center = Origin + (direction * Hit.Distance);
+    if(!ClosestPointOnCollider(Hit.HitCollider, center, Radius * 1.01f + 1e-4f, Hit.Point))
+        Hit.Point = center + (direction * Radius);
+
+    Hit.Normal = center - Hit.Point;
+    float separation = glm::length(Hit.Normal);
+    Hit.Normal = (separation > 1e-6f) ? Hit.Normal / separation : -direction;
+
+    return true;
+}
+
+size_t PhysicsWorld::OverlapBox(const OrientedBox& Box, std::vector<Collider*>& Out, uint32_t LayerMask) const{
+    Out.clear();
+
+    AABB bounds = {};
+    bounds.min = -Box.HalfSize;
+    bounds.max = Box.HalfSize;
+    bounds = bounds.transformed(Box.Axes, Box.Center);
+
+    this->QueryTree->Query(bounds, [&](int Proxy){
+        Collider* collider = QueriedCollider(this->QueryTree, Proxy);
+        if(!collider || !InLayers(collider, LayerMask))
+            return true;
+
+        bool touching = false;
+
+        switch(collider->GetType()){
+        case COLLIDER_SPHERE:{
+            glm::vec3 center;
+            float radius;
+            ((SphericalCollider*)collider)->WorldSphere(center, radius);
+
+            glm::vec3 offset = ClosestPointOnBox(center, Box) - center;
+            touching = glm::dot(offset, offset) <= radius * radius;
+            break;
+        }
+        case COLLIDER_BOX:{
+            OrientedBox box;
+            touching = ((BoxCollider*)collider)->WorldBox(box) && BoxesOverlap(Box, box);
+            break;
+        }
+        case COLLIDER_MESH:{
+            MeshCollider* mesh = (MeshCollider*)collider;
+            const TriangleMesh& shape = mesh->GetShape();
+
+            glm::mat3 linear;
+            glm::vec3 translation;
+            mesh->WorldTransform(linear, translation);
+
+            if(std::abs(glm::determinant(linear)) < 1e-12f)
+                break;
+
+            glm::mat3 inverse = glm::inverse(linear);
+
+            shape.Hierarchy().Query(bounds.transformed(inverse, -(inverse * translation)), [&](int Index){
+                glm::vec3 a, b, c;
+                shape.Triangle(Index, a, b, c);
+
+                touching = BoxTriangleOverlap(Box, (linear * a) + translation, (linear * b) + translation, (linear * c) + translation);
+                return !touching;
+            });
+            break;
+        }
+        }
+
+        if(touching)
+            Out.push_back(collider);
+
+        return true;
+    });
+
+    return Out.size();
+}
+
+size_t PhysicsWorld::OverlapSphere(const glm::vec3& Center, float Radius, std::vector<Collider*>& Out, uint32_t LayerMask) const{
+    Out.clear();
+    if(Radius < 0.f)
+        return 0;
+
+    AABB bounds = {};
+    bounds.min = Center - glm::vec3(Radius);
+    bounds.max = Center + glm::vec3(Radius);
+
+    this->QueryTree->Query(bounds, [&](int Proxy){
+        Collider* collider = QueriedCollider(this->QueryTree, Proxy);
+        if(!collider || !InLayers(collider, LayerMask))
+            return true;
+
+        glm::vec3 closest;
+        if(!ClosestPointOnCollider(collider, Center, Radius, closest))
+            return true;
+
+        glm::vec3 offset = closest - Center;
+        if(glm::dot(offset, offset) <= Radius * Radius)
+            Out.push_back(collider);
+
+        return true;
+    });
+
+    return Out.size();
+}
+
+void PhysicsWorld::RaycastBatch(const RayQuery* Rays, size_t Count, RaycastHit* Hits, uint32_t LayerMask) const{
+    auto job = [&](size_t Begin, size_t End){
+        for(size_t i = Begin; i < End; i++){
+            this->Raycast(Rays[i].Origin, Rays[i].Direction, Rays[i].MaxDistance, Hits[i], LayerMask);
+        }
+    };
+
+    if(__GLOBAL_THREAD_POOL && Count > RAYCAST_BATCH_GRAIN)
+        __GLOBAL_THREAD_POOL->ParallelFor(Count, RAYCAST_BATCH_GRAIN, job);
+    else
+        job(0, Count);
+}
@@ -0,0 +1,239 @@
+#include <Unified-Engine/Core/Physics/sweepAndPrune.h>
+#include <Unified-Engine/Core/Spatial/aabbBatch.h>
+#include <Unified-Engine/debug.h>
+#include <algorithm>
+
+using namespace UnifiedEngine;
+
+//Equal values put mins first, so touching boxes overlap the same way AABB::intersects says they do
+static inline bool EndpointLess(float aValue, uint32_t aTag, float bValue, uint32_t bTag){
+    return aValue < bValue || (aValue == bValue && !(aTag & 1) && (bTag & 1));
+}
+
+SweepAndPrune::SweepAndPrune(){
+
+}
+SweepAndPrune::~SweepAndPrune(){
+
+}
+
+int SweepAndPrune::CreateProxy(const AABB& Box, void* Data){
+    int proxy;
+
+    if(this->FreeProxies.size()){
+        proxy = this->FreeProxies.back();
+        this->FreeProxies.pop_back();
+    }
+    else{
+        proxy = (int)this->Proxies.size();
+        this->Proxies.push_back(Proxy{});
+    }
+
+    this->Proxies[proxy].Box = Box;
+    this->Proxies[proxy].Data = Data;
+    this->Proxies[proxy].Alive = true;
+
+    //Sorted into place on the next update
+    for(int axis = 0; axis < 3; axis++){
+        this->Axes[axis].push_back(Endpoint{Box.min[axis], (uint32_t)proxy << 1});
+        this->Axes[axis].push_back(Endpoint{Box.max[axis], ((uint32_t)proxy << 1) | 1});
+    }
+
+    return proxy;
+}
+
+int SweepAndPrune::DestroyProxy(int Proxy){
+    if(Proxy < 0 || Proxy >= (int)this->Proxies.size() || !this->Proxies[Proxy].Alive){
+        FAULT("NOT A PROXY: ", Proxy);
+        return -1;
+    }
+
+    this->Proxies[Proxy].Alive = false;
+    this->Proxies[Proxy].Data = nullptr;
+    this->DeadProxies.push_back(Proxy);
+
+    return 0;
+}
+
+int SweepAndPrune::MoveProxy(int Proxy, const AABB& Box){
+    if(Proxy < 0 || Proxy >= (int)this->Proxies.size() || !this->Proxies[Proxy].Alive){
+        FAULT("NOT A PROXY: ", Proxy);
+        return -1;
+    }
+
+    this->Proxies[Proxy].Box = Box;
+
+    return 0;
+}
+
+bool SweepAndPrune::Overlaps(int A, int B) const{
+    return this->Proxies[A].Box.intersects(&this->Proxies[B].Box);
+}
+
+void SweepAndPrune::AddPair(int A, int B){
+    uint64_t key = PairKey(A, B);
+    if(this->PairIndex.count(key))
+        return;
+
+    this->PairIndex[key] = this->PairList.size();
+    this->PairList.push_back(BroadphasePair{std::min(A, B), std::max(A, B)});
+}
+
+void SweepAndPrune::RemovePair(int A, int B){
+    auto found = this->PairIndex.find(PairKey(A, B));
+    if(found == this->PairIndex.end())
+        return;
+
+    //Last pair fills the hole
+    size_t index = found->second;
+    this->PairIndex.erase(found);
+
+    if(index != this->PairList.size() - 1){
+        this->PairList[index] = this->PairList.back();
+        this->PairIndex[PairKey(this->PairList[index].ProxyA, this->PairList[index].ProxyB)] = index;
+    }
+    this->PairList.pop_back();
+}
+
+void SweepAndPrune::Purge(){
+    if(this->DeadProxies.empty())
+        return;
+
+    //Removing from a sorted list keeps it sorted, only the count of sorted endpoints shrinks
+    size_t sorted = 0;
+
+    for(int axis = 0; axis < 3; axis++){
+        std::vector<Endpoint>& endpoints = this->Axes[axis];
+        size_t out = 0;
+
+        for(size_t i = 0; i < endpoints.size(); i++){
+            if(!this->Proxies[endpoints[i].Owner()].Alive)
+                continue;
+
+            if(axis == 0 && i < this->Sorted)
+                sorted++;
+            endpoints[out++] = endpoints[i];
+        }
+        endpoints.resize(out);
+    }
+
+    this->Sorted = sorted;
+
+    size_t out = 0;
+    for(size_t i = 0; i < this->PairList.size(); i++){
+        const BroadphasePair& pair = this->PairList[i];
+
+        if(!this->Proxies[pair.ProxyA].Alive || !this->Proxies[pair.ProxyB].Alive)
+            continue;
+
+        this->PairList[out++] = pair;
+    }
+    this->PairList.resize(out);
+
+    this->PairIndex.clear();
+    for(size_t i = 0; i < this->PairList.size(); i++){
+        this->PairIndex[PairKey(this->PairList[i].ProxyA, this->PairList[i].ProxyB)] = i;
+    }
+
+    this->FreeProxies.insert(this->FreeProxies.end(), this->DeadProxies.begin(), this->DeadProxies.end());
+    this->DeadProxies.clear();
+}
+
+void SweepAndPrune::SortAxis(int Axis){
+    std::vector<Endpoint>& endpoints = this->Axes[Axis];
+
+    for(size_t i = 1; i < endpoints.size(); i++){
+        Endpoint moving = endpoints[i];
+        size_t j = i;
+
+        while(j > 0 && EndpointLess(moving.Value, moving.Tag, endpoints[j - 1].Value, endpoints[j - 1].Tag)){
+            const Endpoint& passed = endpoints[j - 1];
+
+            if(!moving.IsMax() && passed.IsMax()){
+                //Starts before the other ends, overlapping on this axis
+                if(moving.Owner() != passed.Owner() && this->Overlaps(moving.Owner(), passed.Owner()))
+                    this->AddPair(moving.Owner(), passed.Owner());
+            }
+            else if(moving.IsMax() && !passed.IsMax()){
+                //Ends before the other starts, apart on this axis
+                this->RemovePair(moving.Owner(), passed.Owner());
+            }
+
+            endpoints[j] = passed;
+            j--;
+            this->Swaps++;
+        }
+
+        endpoints[j] = moving;
+    }
+}
+
+void SweepAndPrune::Rebuild(){
+    for(int axis = 0; axis < 3; axis++){
+        std::sort(this->Axes[axis].begin(), this->Axes[axis].end(), [](const Endpoint& a, const Endpoint& b){
+            return EndpointLess(a.Value, a.Tag, b.Value, b.Tag);
+        });
+    }
+
+    this->PairList.clear();
+    this->PairIndex.clear();
+
+    //Sweep x, anything still open when a box starts overlaps it on x. Open boxes sit in a batch so each start tests them all at once
+    std::vector<int> open;
+    AABBBatch openBoxes;
+    std::vector<uint32_t> hits;
+    const std::vector<Endpoint>& endpoints = this->Axes[0];
+
+    for(size_t i = 0; i < endpoints.size(); i++){
+        int owner = endpoints[i].Owner();
+
+        if(endpoints[i].IsMax()){
+            size_t found = std::find(open.begin(), open.end(), owner) - open.begin();
+            open[found] = open.back();
+            open.pop_back();
+            openBoxes.RemoveSwap(found);
+            continue;
+        }
+
+        hits.resize(std::max(hits.size(), open.size()));
+        size_t count = openBoxes.Overlaps(this->Proxies[owner].Box, 0, open.size(), hits.data());
+
+        for(size_t j = 0; j < count; j++){
+            this->AddPair(owner, open[hits[j]]);
+        }
+
+        open.push_back(owner);
+        openBoxes.Add(this->Proxies[owner].Box);
+    }
+}
+
+int SweepAndPrune::Update(){
+    this->Swaps = 0;
+    this->Rebuilt = false;
+
+    this->Purge();
+
+    //Endpoints take the latest boxes, then insertion sort walks each one to where it now belongs
+    for(int axis = 0; axis < 3; axis++){
+        for(auto i = this->Axes[axis].begin(); i != this->Axes[axis].end(); i++){
+            const AABB& box = this->Proxies[(*i).Owner()].Box;
+            (*i).Value = (*i).IsMax() ? box.max[axis] : box.min[axis];
+        }
+    }
+
+    //Lots of new proxies would each swap past most of the list
+    size_t added = this->Axes[0].size() - this->Sorted;
+    if(added > this->Sorted){
+        this->Rebuild();
+        this->Rebuilt = true;
+    }
+    else{
+        for(int axis = 0; axis < 3; axis++){
+            this->SortAxis(axis);
+        }
+    }
+
+    this->Sorted = this->Axes[0].size();
+
+    return 0;
+}
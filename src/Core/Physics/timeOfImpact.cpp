@@ -0,0 +1,485 @@
+#include <Unified-Engine/Core/Physics/timeOfImpact.h>
+#include <Unified-Engine/Objects/Components/collider.h>
+#include <GLM/common.hpp>
+#include <GLM/geometric.hpp>
+#include <GLM/matrix.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace UnifiedEngine;
+
+//A convex shape the separating axes can project, an oriented box or a triangle
+struct SweepShape{
+    const OrientedBox* Box = nullptr;
+    const glm::vec3* Triangle = nullptr;
+};
+
+static inline void Project(const SweepShape& Shape, const glm::vec3& Axis, float& Min, float& Max){
+    if(Shape.Box){
+        float center = glm::dot(Shape.Box->Center, Axis);
+        float radius = 0.f;
+
+        for(int i = 0; i < 3; i++){
+            radius += Shape.Box->HalfSize[i] * std::abs(glm::dot(Shape.Box->Axes[i], Axis));
+        }
+
+        Min = center - radius;
+        Max = center + radius;
+        return;
+    }
+
+    Min = Max = glm::dot(Shape.Triangle[0], Axis);
+    for(int i = 1; i < 3; i++){
+        float d = glm::dot(Shape.Triangle[i], Axis);
+        Min = std::min(Min, d);
+        Max = std::max(Max, d);
+    }
+}
+
+//Narrows [Enter, Exit] to the times A, moving by Motion, overlaps B along Axis. False once they can't meet
+static inline bool SweepAxis(const SweepShape& A, const SweepShape& B, const glm::vec3& Motion, const glm::vec3& Axis, float& Enter, float& Exit){
+    float minA, maxA, minB, maxB;
+    Project(A, Axis, minA, maxA);
+    Project(B, Axis, minB, maxB);
+
+    float speed = glm::dot(Motion, Axis);
+
+    //Not moving along it, they overlap on it the whole time or never
+    if(std::abs(speed) < 1e-12f)
+        return maxA >= minB && maxB >= minA;
+
+    float t0 = (minB - maxA) / speed;
+    float t1 = (maxB - minA) / speed;
+    if(t0 > t1)
+        std::swap(t0, t1);
+
+    Enter = std::max(Enter, t0);
+    Exit = std::min(Exit, t1);
+
+    return Enter <= Exit;
+}
+
+//Candidate separating axes of a box and a box or triangle, unnormalised and some may be zero (Parallel edges)
+static int SeparatingAxes(const OrientedBox& Moving, const SweepShape& Other, glm::vec3* Axes){
+    glm::vec3* axes = Axes;
+    glm::vec3 edges[3];
+    int count = 0;
+
+    for(int i = 0; i < 3; i++){
+        axes[count++] = Moving.Axes[i];
+    }
+
+    if(Other.Box){
+        for(int i = 0; i < 3; i++){
+            axes[count++] = Other.Box->Axes[i];
+            edges[i] = Other.Box->Axes[i];
+        }
+    }
+    else{
+        const glm::vec3* triangle = Other.Triangle;
+
+        edges[0] = triangle[1] - triangle[0];
+        edges[1] = triangle[2] - triangle[1];
+        edges[2] = triangle[0] - triangle[2];
+        axes[count++] = glm::cross(edges[0], edges[1]);
+    }
+
+    for(int i = 0; i < 3; i++){
+        for(int j = 0; j < 3; j++){
+            axes[count++] = glm::cross(Moving.Axes[i], edges[j]);
+        }
+    }
+
+    return count;
+}
+
+//Separating axes over time, the box and the other shape touch once every axis overlaps
+static bool SweepConvex(const OrientedBox& Moving, const glm::vec3& Motion, const SweepShape& Other, float& Fraction){
+    SweepShape moving = {&Moving, nullptr};
+
+    glm::vec3 axes[15];
+    int count = SeparatingAxes(Moving, Other, axes);
+
+    float enter = -FLT_MAX;
+    float exit = FLT_MAX;
+
+    for(int i = 0; i < count; i++){
+        //Parallel edges, the face axes already cover it
+        if(glm::dot(axes[i], axes[i]) < 1e-12f)
+            continue;
+
+        if(!SweepAxis(moving, Other, Motion, axes[i], enter, exit))
+            return false;
+    }
+
+    //Touching at the start, or not within this motion
+    if(enter <= 0.f || enter > 1.f)
+        return false;
+
+    Fraction = enter;
+    return true;
+}
+
+//Standing still every axis has to overlap
+static bool ConvexOverlap(const OrientedBox& Box, const SweepShape& Other){
+    SweepShape box = {&Box, nullptr};
+
+    glm::vec3 axes[15];
+    int count = SeparatingAxes(Box, Other, axes);
+
+    float enter = -FLT_MAX;
+    float exit = FLT_MAX;
+
+    for(int i = 0; i < count; i++){
+        if(!SweepAxis(box, Other, glm::vec3(0.f), axes[i], enter, exit))
+            return false;
+    }
+
+    return true;
+}
+
+bool UnifiedEngine::BoxesOverlap(const OrientedBox& A, const OrientedBox& B){
+    return ConvexOverlap(A, SweepShape{&B, nullptr});
+}
+
+bool UnifiedEngine::BoxTriangleOverlap(const OrientedBox& Box, const glm::vec3& A, const glm::vec3& B, const glm::vec3& C){
+    const glm::vec3 triangle[3] = {A, B, C};
+    return ConvexOverlap(Box, SweepShape{nullptr, triangle});
+}
+
+//A point against a sphere, false when it starts inside or misses
+static bool SweepPointSphere(const glm::vec3& Start, const glm::vec3& Motion, const glm::vec3& Center, float Radius, float& Fraction){
+    glm::vec3 m = Start - Center;
+
+    float a = glm::dot(Motion, Motion);
+    float b = glm::dot(m, Motion);
+    float c = glm::dot(m, m) - (Radius * Radius);
+
+    if(c <= 0.f || b >= 0.f || a < 1e-12f)
+        return false;
+
+    float discriminant = (b * b) - (a * c);
+    if(discriminant < 0.f)
+        return false;
+
+    float t = (-b - std::sqrt(discriminant)) / a;
+    if(t > 1.f)
+        return false;
+
+    Fraction = std::max(t, 0.f);
+    return true;
+}
+
+//A point against the side of the capsule around the segment P to Q, its ends are left to SweepPointSphere
+static bool SweepPointCylinder(const glm::vec3& Start, const glm::vec3& Motion, const glm::vec3& P, const glm::vec3& Q, float Radius, float& Fraction){
+    glm::vec3 e = Q - P;
+    float ee = glm::dot(e, e);
+    if(ee < 1e-12f)
+        return false;
+
+    //Both taken across the segment
+    glm::vec3 m = Start - P;
+    glm::vec3 mp = m - e * (glm::dot(m, e) / ee);
+    glm::vec3 dp = Motion - e * (glm::dot(Motion, e) / ee);
+
+    float a = glm::dot(dp, dp);
+    float b = glm::dot(mp, dp);
+    float c = glm::dot(mp, mp) - (Radius * Radius);
+
+    if(c <= 0.f || b >= 0.f || a < 1e-12f)
+        return false;
+
+    float discriminant = (b * b) - (a * c);
+    if(discriminant < 0.f)
+        return false;
+
+    float t = (-b - std::sqrt(discriminant)) / a;
+    if(t > 1.f)
+        return false;
+
+    float s = glm::dot(m + Motion * t, e) / ee;
+    if(s < 0.f || s > 1.f)
+        return false;
+
+    Fraction = t;
+    return true;
+}
+
+//Its face first, the edges and corners only when the face is missed
+static bool SweepSphereTriangle(const glm::vec3& Center, float Radius, const glm::vec3& Motion, const glm::vec3* Triangle, float& Fraction){
+    glm::vec3 d = Center - ClosestPointOnTriangle(Center, Triangle[0], Triangle[1], Triangle[2]);
+    if(glm::dot(d, d) <= Radius * Radius)
+        return false;
+
+    float best = FLT_MAX;
+    float t;
+
+    glm::vec3 face = glm::cross(Triangle[1] - Triangle[0], Triangle[2] - Triangle[0]);
+    float length = glm::length(face);
+
+    if(length > 1e-12f){
+        glm::vec3 normal = face / length;
+        float distance = glm::dot(normal, Center - Triangle[0]);
+        float speed = glm::dot(normal, Motion);
+
+        if(distance < 0.f){
+            normal = -normal;
+            distance = -distance;
+            speed = -speed;
+        }
+
+        if(speed < 0.f){
+            t = (distance - Radius) / -speed;
+            glm::vec3 p = Center + (Motion * t) - (normal * Radius);
+
+            //Inside when on the inner side of all three edges
+            bool inside = true;
+            for(int i = 0; i < 3 && inside; i++){
+                inside = glm::dot(glm::cross(Triangle[(i + 1) % 3] - Triangle[i], p - Triangle[i]), face) >= 0.f;
+            }
+
+            if(inside && t >= 0.f && t <= 1.f)
+                best = t;
+        }
+    }
+
+    if(best == FLT_MAX){
+        for(int i = 0; i < 3; i++){
+            if(SweepPointCylinder(Center, Motion, Triangle[i], Triangle[(i + 1) % 3], Radius, t))
+                best = std::min(best, t);
+            if(SweepPointSphere(Center, Motion, Triangle[i], Radius, t))
+                best = std::min(best, t);
+        }
+    }
+
+    if(best > 1.f)
+        return false;
+
+    Fraction = best;
+    return true;
+}
+
+//Slab test, false when it starts inside
+static bool SweepPointAABB(const glm::vec3& Start, const glm::vec3& Motion, const AABB& Box, float& Fraction){
+    bool inside = true;
+    for(int i = 0; i < 3 && inside; i++){
+        inside = Start[i] >= Box.min[i] && Start[i] <= Box.max[i];
+    }
+
+    if(inside)
+        return false;
+
+    return Box.intersectsRay(Start, 1.f / Motion, 1.f, Fraction);
+}
+
+bool UnifiedEngine::SweepAABB(const AABB& Moving, const glm::vec3& Motion, const AABB& Other, float& Fraction){
+    glm::vec3 half = (Moving.max - Moving.min) * 0.5f;
+
+    AABB grown = Other;
+    grown.min -= half;
+    grown.max += half;
+
+    return SweepPointAABB(Moving.center(), Motion, grown, Fraction);
+}
+
+bool UnifiedEngine::SweepSphere(const glm::vec3& Center, float Radius, const glm::vec3& Motion, const AABB& Other, float& Fraction){
+    AABB grown = Other;
+    grown.min -= glm::vec3(Radius);
+    grown.max += glm::vec3(Radius);
+
+    return SweepPointAABB(Center, Motion, grown, Fraction);
+}
+
+//Exact in the box's space, its faces pushed out by the radius then the rounded edges and corners
+static bool SweepSphereBox(const glm::vec3& Center, float Radius, const glm::vec3& Motion, const OrientedBox& Box, float& Fraction){
+    glm::mat3 toLocal = glm::transpose(Box.Axes);
+    glm::vec3 start = toLocal * (Center - Box.Center);
+    glm::vec3 motion = toLocal * Motion;
+    const glm::vec3& half = Box.HalfSize;
+
+    glm::vec3 d = start - glm::clamp(start, -half, half);
+    if(glm::dot(d, d) <= Radius * Radius)
+        return false;
+
+    float best = FLT_MAX;
+    float t;
+
+    for(int i = 0; i < 3; i++){
+        AABB face = {};
+        face.min = -half;
+        face.max = half;
+        face.min[i] -= Radius;
+        face.max[i] += Radius;
+
+        if(SweepPointAABB(start, motion, face, t))
+            best = std::min(best, t);
+    }
+
+    for(int i = 0; i < 8; i++){
+        glm::vec3 corner((i & 1) ? half.x : -half.x, (i & 2) ? half.y : -half.y, (i & 4) ? half.z : -half.z);
+
+        if(SweepPointSphere(start, motion, corner, Radius, t))
+            best = std::min(best, t);
+
+        //Each edge once, from the corner on its negative end
+        for(int axis = 0; axis < 3; axis++){
+            if(i & (1 << axis))
+                continue;
+
+            glm::vec3 other = corner;
+            other[axis] = half[axis];
+
+            if(SweepPointCylinder(start, motion, corner, other, Radius, t))
+                best = std::min(best, t);
+        }
+    }
+
+    if(best > 1.f)
+        return false;
+
+    Fraction = best;
+    return true;
+}
+
+//A mesh's bounds carried through its transform, which only rotates and scales so it stays a box
+static bool MeshBox(MeshCollider* Collider, OrientedBox& Out){
+    const TriangleMesh& shape = Collider->GetShape();
+    if(shape.Empty())
+        return false;
+
+    glm::mat3 linear;
+    glm::vec3 translation;
+    Collider->WorldTransform(linear, translation);
+
+    glm::vec3 half = (shape.Bounds().max - shape.Bounds().min) * 0.5f;
+
+    for(int i = 0; i < 3; i++){
+        float scale = glm::length(linear[i]);
+        if(scale < 1e-12f)
+            return false;
+
+        Out.Axes[i] = linear[i] / scale;
+        Out.HalfSize[i] = half[i] * scale;
+    }
+
+    Out.Center = linear * shape.Bounds().center() + translation;
+
+    return true;
+}
+
+//The moving shape is a sphere or a box, swept into any collider
+static bool SweepInto(bool Sphere, const glm::vec3& Center, float Radius, const OrientedBox& Box, const AABB& Bounds, const glm::vec3& Motion, Collider* Other, float& Fraction){
+    AABB otherBounds = Other->WorldBounds();
+    if(otherBounds.min.x > otherBounds.max.x)
+        return false;
+
+    //The swept boxes have to meet first
+    float broad;
+    if(!Bounds.intersects(&otherBounds) && !SweepAABB(Bounds, Motion, otherBounds, broad))
+        return false;
+
+    switch(Other->GetType()){
+    case COLLIDER_SPHERE:{
+        glm::vec3 otherCenter;
+        float otherRadius;
+        ((SphericalCollider*)Other)->WorldSphere(otherCenter, otherRadius);
+
+        if(Sphere)
+            return SweepPointSphere(Center, Motion, otherCenter, Radius + otherRadius, Fraction);
+
+        //The sphere moving back into the box takes as long
+        return SweepSphereBox(otherCenter, otherRadius, -Motion, Box, Fraction);
+    }
+    case COLLIDER_BOX:{
+        OrientedBox otherBox;
+        if(!((BoxCollider*)Other)->WorldBox(otherBox))
+            return false;
+
+        if(Sphere)
+            return SweepSphereBox(Center, Radius, Motion, otherBox, Fraction);
+
+        return SweepConvex(Box, Motion, SweepShape{&otherBox, nullptr}, Fraction);
+    }
+    case COLLIDER_MESH:{
+        MeshCollider* mesh = (MeshCollider*)Other;
+        const TriangleMesh& shape = mesh->GetShape();
+
+        glm::mat3 linear;
+        glm::vec3 translation;
+        mesh->WorldTransform(linear, translation);
+
+        if(std::abs(glm::determinant(linear)) < 1e-12f)
+            return false;
+
+        //Triangles the whole sweep could reach
+        AABB swept = Bounds;
+        swept.min += glm::min(Motion, glm::vec3(0.f));
+        swept.max += glm::max(Motion, glm::vec3(0.f));
+
+        glm::mat3 inverse = glm::inverse(linear);
+        float best = FLT_MAX;
+
+        shape.Hierarchy().Query(swept.transformed(inverse, -(inverse * translation)), [&](int Index){
+            glm::vec3 triangle[3];
+            shape.Triangle(Index, triangle[0], triangle[1], triangle[2]);
+
+            for(int i = 0; i < 3; i++){
+                triangle[i] = (linear * triangle[i]) + translation;
+            }
+
+            float t;
+            bool hit = Sphere ? SweepSphereTriangle(Center, Radius, Motion, triangle, t) : SweepConvex(Box, Motion, SweepShape{nullptr, triangle}, t);
+
+            if(hit)
+                best = std::min(best, t);
+
+            return true;
+        });
+
+        if(best > 1.f)
+            return false;
+
+        Fraction = best;
+        return true;
+    }
+    }
+
+    return false;
+}
+
+bool UnifiedEngine::SweepSphere(const glm::vec3& Center, float Radius, const glm::vec3& Motion, Collider* Other, float& Fraction){
+    AABB bounds = {};
+    bounds.min = Center - glm::vec3(Radius);
+    bounds.max = Center + glm::vec3(Radius);
+
+    return SweepInto(true, Center, Radius, OrientedBox{}, bounds, Motion, Other, Fraction);
+}
+
+bool UnifiedEngine::TimeOfImpact(Collider* Moving, const glm::vec3& Motion, Collider* Other, float& Fraction){
+    AABB bounds = Moving->WorldBounds();
+    if(bounds.min.x > bounds.max.x)
+        return false;
+
+    OrientedBox box = {};
+
+    switch(Moving->GetType()){
+    case COLLIDER_SPHERE:{
+        glm::vec3 center;
+        float radius;
+        ((SphericalCollider*)Moving)->WorldSphere(center, radius);
+
+        return SweepInto(true, center, radius, box, bounds, Motion, Other, Fraction);
+    }
+    case COLLIDER_BOX:
+        if(!((BoxCollider*)Moving)->WorldBox(box))
+            return false;
+        break;
+    case COLLIDER_MESH:
+        if(!MeshBox((MeshCollider*)Moving, box))
+            return false;
+        break;
+    }
+
+    return SweepInto(false, glm::vec3(0.f), 0.f, box, bounds, Motion, Other, Fraction);
+}
@@ -0,0 +1,180 @@
+#include <Unified-Engine/Core/Physics/triangleMesh.h>
+#include <GLM/geometric.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace UnifiedEngine;
+
+TriangleMesh::TriangleMesh(){
+
+}
+TriangleMesh::TriangleMesh(const Mesh& mesh){
+    this->Build(mesh);
+}
+TriangleMesh::~TriangleMesh(){
+
+}
+
+void TriangleMesh::Clear(){
+    this->Positions.clear();
+    this->Indices.clear();
+    this->LocalBounds = AABB{};
+    this->Tree.Clear();
+}
+
+int TriangleMesh::Build(const Mesh& mesh){
+    this->Clear();
+
+    if(mesh.vertices.empty())
+        return -1;
+
+    this->Positions.resize(mesh.vertices.size());
+    for(size_t i = 0; i < mesh.vertices.size(); i++){
+        this->Positions[i] = mesh.vertices[i].position;
+    }
+
+    //Drawn without indices, every three vertices are a triangle
+    if(mesh.indices.empty()){
+        size_t count = mesh.vertices.size() - (mesh.vertices.size() % 3);
+        for(size_t i = 0; i < count; i++){
+            this->Indices.push_back((uint32_t)i);
+        }
+    }
+    else{
+        this->AddIndices(mesh);
+    }
+
+    if(this->Indices.empty()){
+        this->Positions.clear();
+        return -1;
+    }
+
+    std::vector<AABB> boxes(this->TriangleCount());
+
+    for(size_t i = 0; i < boxes.size(); i++){
+        boxes[i].expand(this->Positions[this->Indices[(i * 3)]]);
+        boxes[i].expand(this->Positions[this->Indices[(i * 3) + 1]]);
+        boxes[i].expand(this->Positions[this->Indices[(i * 3) + 2]]);
+
+        this->LocalBounds.merge(boxes[i]);
+    }
+
+    return this->Tree.Build(boxes);
+}
+
+void TriangleMesh::AddIndices(const Mesh& mesh){
+    //Full detail only, lower LODs follow it in the same buffer
+    size_t first = 0;
+    size_t count = mesh.indices.size();
+
+    if(!mesh.LODs.empty()){
+        first = mesh.LODs[0].FirstIndex;
+        count = std::min((size_t)mesh.LODs[0].IndexCount, mesh.indices.size() - std::min(first, mesh.indices.size()));
+    }
+
+    count -= count % 3;
+
+    this->Indices.reserve(count);
+    for(size_t i = first; i < first + count; i += 3){
+        //Skips triangles pointing past the vertices
+        if(mesh.indices[i] >= this->Positions.size() || mesh.indices[i + 1] >= this->Positions.size() || mesh.indices[i + 2] >= this->Positions.size())
+            continue;
+
+        this->Indices.push_back(mesh.indices[i]);
+        this->Indices.push_back(mesh.indices[i + 1]);
+        this->Indices.push_back(mesh.indices[i + 2]);
+    }
+}
+
+void TriangleMesh::Triangle(size_t Index, glm::vec3& A, glm::vec3& B, glm::vec3& C) const{
+    A = this->Positions[this->Indices[(Index * 3)]];
+    B = this->Positions[this->Indices[(Index * 3) + 1]];
+    C = this->Positions[this->Indices[(Index * 3) + 2]];
+}
+
+//Projections of both triangles on Axis overlap, touching counts
+static inline bool OverlapOnAxis(const glm::vec3* A, const glm::vec3* B, const glm::vec3& Axis){
+    float minA = FLT_MAX, maxA = -FLT_MAX;
+    float minB = FLT_MAX, maxB = -FLT_MAX;
+
+    for(int i = 0; i < 3; i++){
+        float a = glm::dot(A[i], Axis);
+        float b = glm::dot(B[i], Axis);
+
+        minA = std::min(minA, a);
+        maxA = std::max(maxA, a);
+        minB = std::min(minB, b);
+        maxB = std::max(maxB, b);
+    }
+
+    return maxA >= minB && maxB >= minA;
+}
+
+bool UnifiedEngine::TrianglesIntersect(const glm::vec3& A0, const glm::vec3& A1, const glm::vec3& A2, const glm::vec3& B0, const glm::vec3& B1, const glm::vec3& B2){
+    const glm::vec3 a[3] = {A0, A1, A2};
+    const glm::vec3 b[3] = {B0, B1, B2};
+    const glm::vec3 edgesA[3] = {A1 - A0, A2 - A1, A0 - A2};
+    const glm::vec3 edgesB[3] = {B1 - B0, B2 - B1, B0 - B2};
+
+    glm::vec3 normalA = glm::cross(edgesA[0], edgesA[1]);
+    glm::vec3 normalB = glm::cross(edgesB[0], edgesB[1]);
+
+    //A zero axis (Degenerate triangle, parallel edges) separates nothing and passes on its own
+    if(!OverlapOnAxis(a, b, normalA) || !OverlapOnAxis(a, b, normalB))
+        return false;
+
+    for(int i = 0; i < 3; i++){
+        for(int j = 0; j < 3; j++){
+            if(!OverlapOnAxis(a, b, glm::cross(edgesA[i], edgesB[j])))
+                return false;
+        }
+    }
+
+    //Edges within each plane, only able to separate when the planes are (near) the same one
+    for(int i = 0; i < 3; i++){
+        if(!OverlapOnAxis(a, b, glm::cross(normalA, edgesA[i])) || !OverlapOnAxis(a, b, glm::cross(normalB, edgesB[i])))
+            return false;
+    }
+
+    return true;
+}
+
+glm::vec3 UnifiedEngine::ClosestPointOnTriangle(const glm::vec3& Point, const glm::vec3& A, const glm::vec3& B, const glm::vec3& C){
+    //Voronoi regions of the vertices, then the edges, then the face
+    glm::vec3 ab = B - A;
+    glm::vec3 ac = C - A;
+    glm::vec3 ap = Point - A;
+
+    float d1 = glm::dot(ab, ap);
+    float d2 = glm::dot(ac, ap);
+    if(d1 <= 0.f && d2 <= 0.f)
+        return A;
+
+    glm::vec3 bp = Point - B;
+    float d3 = glm::dot(ab, bp);
+    float d4 = glm::dot(ac, bp);
+    if(d3 >= 0.f && d4 <= d3)
+        return B;
+
+    float vc = (d1 * d4) - (d3 * d2);
+    if(vc <= 0.f && d1 >= 0.f && d3 <= 0.f)
+        return A + ab * (d1 / (d1 - d3));
+
+    glm::vec3 cp = Point - C;
+    float d5 = glm::dot(ab, cp);
+    float d6 = glm::dot(ac, cp);
+    if(d6 >= 0.f && d5 <= d6)
+        return C;
+
+    float vb = (d5 * d2) - (d1 * d6);
+    if(vb <= 0.f && d2 >= 0.f && d6 <= 0.f)
+        return A + ac * (d2 / (d2 - d6));
+
+    float va = (d3 * d6) - (d5 * d4);
+    if(va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+        return B + (C - B) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+    float denominator = 1.f / (va + vb + vc);
+    return A + (ab * (vb * denominator)) + (ac * (vc * denominator));
+}
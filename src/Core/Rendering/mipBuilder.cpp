@@ -0,0 +1,423 @@
+#include <Unified-Engine/Core/Rendering/mipBuilder.h>
+#include <Unified-Engine/Core/threadPool.h>
+#include <Unified-Engine/Utility/simd.h>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+using namespace UnifiedEngine;
+
+namespace {
+    //Taps relative to 2x for destination texel x, the same in both directions
+    struct MipKernel{
+        int First;
+        int Count;
+        float Weights[8];
+    };
+
+    double BesselI0(double x){
+        double sum = 1.0;
+        double term = 1.0;
+
+        for(int k = 1; k < 32; k++){
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    MipKernel MakeKernel(MipFilter Filter){
+        MipKernel kernel = {};
+
+        if(Filter == MIP_FILTER_BOX){
+            kernel.First = 0;
+            kernel.Count = 2;
+            kernel.Weights[0] = 0.5f;
+            kernel.Weights[1] = 0.5f;
+            return kernel;
+        }
+
+        //Windowed sinc over two destination texels either side
+        constexpr double alpha = 4.0;
+        constexpr double pi = 3.14159265358979323846;
+
+        kernel.First = -3;
+        kernel.Count = 8;
+
+        double total = 0;
+        double weights[8];
+        for(int k = 0; k < 8; k++){
+            //Source texel centre to destination texel centre, in destination texels
+            double t = ((kernel.First + k) - 0.5) / 2.0;
+            double sinc = (t == 0) ? 1.0 : std::sin(pi * t) / (pi * t);
+            double window = BesselI0(alpha * std::sqrt(std::max(0.0, 1.0 - ((t / 2.0) * (t / 2.0))))) / BesselI0(alpha);
+
+            weights[k] = sinc * window;
+            total += weights[k];
+        }
+
+        for(int k = 0; k < 8; k++)
+            kernel.Weights[k] = weights[k] / total;
+
+        return kernel;
+    }
+
+    const MipKernel& GetKernel(MipFilter Filter){
+        static const MipKernel box = MakeKernel(MIP_FILTER_BOX);
+        static const MipKernel kaiser = MakeKernel(MIP_FILTER_KAISER);
+
+        return (Filter == MIP_FILTER_BOX) ? box : kaiser;
+    }
+
+    //Byte to float and back, with or without the sRGB curve
+    struct ColourTables{
+        float ToLinear[256];
+        uint8_t ToSRGB[4096];
+        float Identity[256];
+    };
+
+    const ColourTables& GetTables(){
+        static const ColourTables tables = [](){
+            ColourTables t;
+
+            for(int i = 0; i < 256; i++){
+                double c = i / 255.0;
+                t.ToLinear[i] = (float)((c <= 0.04045) ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+                t.Identity[i] = (float)c;
+            }
+            for(int i = 0; i < 4096; i++){
+                double l = i / 4095.0;
+                double c = (l <= 0.0031308) ? l * 12.92 : (1.055 * std::pow(l, 1.0 / 2.4)) - 0.055;
+                t.ToSRGB[i] = (uint8_t)std::clamp((int)((c * 255.0) + 0.5), 0, 255);
+            }
+
+            return t;
+        }();
+
+        return tables;
+    }
+
+    //Dest[i] += Src[i] * Weight
+    void AccumulateScalar(float* Dest, const float* Src, float Weight, size_t Count){
+        for(size_t i = 0; i < Count; i++)
+            Dest[i] += Src[i] * Weight;
+    }
+
+#if defined(UE_SIMD_SSE2)
+    void AccumulateSSE2(float* Dest, const float* Src, float Weight, size_t Count){
+        __m128 weight = _mm_set1_ps(Weight);
+        size_t i = 0;
+
+        for(; i + 4 <= Count; i += 4)
+            _mm_storeu_ps(Dest + i, _mm_add_ps(_mm_loadu_ps(Dest + i), _mm_mul_ps(_mm_loadu_ps(Src + i), weight)));
+
+        AccumulateScalar(Dest + i, Src + i, Weight, Count - i);
+    }
+
+    UE_TARGET_AVX2 void AccumulateAVX2(float* Dest, const float* Src, float Weight, size_t Count){
+        __m256 weight = _mm256_set1_ps(Weight);
+        size_t i = 0;
+
+        for(; i + 8 <= Count; i += 8)
+            _mm256_storeu_ps(Dest + i, _mm256_fmadd_ps(_mm256_loadu_ps(Src + i), weight, _mm256_loadu_ps(Dest + i)));
+
+        AccumulateScalar(Dest + i, Src + i, Weight, Count - i);
+    }
+#endif
+
+#if defined(UE_SIMD_NEON)
+    void AccumulateNEON(float* Dest, const float* Src, float Weight, size_t Count){
+        size_t i = 0;
+
+        for(; i + 4 <= Count; i += 4)
+            vst1q_f32(Dest + i, vmlaq_n_f32(vld1q_f32(Dest + i), vld1q_f32(Src + i), Weight));
+
+        AccumulateScalar(Dest + i, Src + i, Weight, Count - i);
+    }
+#endif
+
+    void Accumulate(float* Dest, const float* Src, float Weight, size_t Count){
+#if defined(UE_SIMD_SSE2)
+        if(CPUSupportsAVX2())
+            AccumulateAVX2(Dest, Src, Weight, Count);
+        else
+            AccumulateSSE2(Dest, Src, Weight, Count);
+#elif defined(UE_SIMD_NEON)
+        AccumulateNEON(Dest, Src, Weight, Count);
+#else
+        AccumulateScalar(Dest, Src, Weight, Count);
+#endif
+    }
+
+    //Horizontal pass, Line holds RGBA floats for source texels [LineStart, LineEnd) of one row
+    void FilterRowScalar(float* Dest, const float* Line, int LineStart, int LineEnd, int X0, int X1, const MipKernel& Kernel){
+        for(int x = X0; x < X1; x++){
+            float* out = Dest + ((x - X0) * 4);
+            out[0] = out[1] = out[2] = out[3] = 0;
+
+            for(int k = 0; k < Kernel.Count; k++){
+                const float* in = Line + ((std::clamp((2 * x) + Kernel.First + k, LineStart, LineEnd - 1) - LineStart) * 4);
+
+                for(int c = 0; c < 4; c++)
+                    out[c] += in[c] * Kernel.Weights[k];
+            }
+        }
+    }
+
+#if defined(UE_SIMD_SSE2)
+    //One texel per register
+    void FilterRowSSE2(float* Dest, const float* Line, int LineStart, int LineEnd, int X0, int X1, const MipKernel& Kernel){
+        for(int x = X0; x < X1; x++){
+            __m128 sum = _mm_setzero_ps();
+
+            for(int k = 0; k < Kernel.Count; k++){
+                const float* in = Line + ((std::clamp((2 * x) + Kernel.First + k, LineStart, LineEnd - 1) - LineStart) * 4);
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(in), _mm_set1_ps(Kernel.Weights[k])));
+            }
+
+            _mm_storeu_ps(Dest + ((x - X0) * 4), sum);
+        }
+    }
+
+    //Two texels per register
+    UE_TARGET_AVX2 void FilterRowAVX2(float* Dest, const float* Line, int LineStart, int LineEnd, int X0, int X1, const MipKernel& Kernel){
+        int x = X0;
+
+        for(; x + 2 <= X1; x += 2){
+            __m256 sum = _mm256_setzero_ps();
+
+            for(int k = 0; k < Kernel.Count; k++){
+                const float* a = Line + ((std::clamp((2 * x) + Kernel.First + k, LineStart, LineEnd - 1) - LineStart) * 4);
+                const float* b = Line + ((std::clamp((2 * x) + 2 + Kernel.First + k, LineStart, LineEnd - 1) - LineStart) * 4);
+
+                __m256 texels = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(a)), _mm_loadu_ps(b), 1);
+                sum = _mm256_fmadd_ps(texels, _mm256_set1_ps(Kernel.Weights[k]), sum);
+            }
+
+            _mm256_storeu_ps(Dest + ((x - X0) * 4), sum);
+        }
+
+        if(x < X1)
+            FilterRowSSE2(Dest + ((x - X0) * 4), Line, LineStart, LineEnd, x, X1, Kernel);
+    }
+#endif
+
+#if defined(UE_SIMD_NEON)
+    void FilterRowNEON(float* Dest, const float* Line, int LineStart, int LineEnd, int X0, int X1, const MipKernel& Kernel){
+        for(int x = X0; x < X1; x++){
+            float32x4_t sum = vdupq_n_f32(0);
+
+            for(int k = 0; k < Kernel.Count; k++){
+                const float* in = Line + ((std::clamp((2 * x) + Kernel.First + k, LineStart, LineEnd - 1) - LineStart) * 4);
+                sum = vmlaq_n_f32(sum, vld1q_f32(in), Kernel.Weights[k]);
+            }
+
+            vst1q_f32(Dest + ((x - X0) * 4), sum);
+        }
+    }
+#endif
+
+    void FilterRow(float* Dest, const float* Line, int LineStart, int LineEnd, int X0, int X1, const MipKernel& Kernel){
+#if defined(UE_SIMD_SSE2)
+        if(CPUSupportsAVX2())
+            FilterRowAVX2(Dest, Line, LineStart, LineEnd, X0, X1, Kernel);
+        else
+            FilterRowSSE2(Dest, Line, LineStart, LineEnd, X0, X1, Kernel);
+#elif defined(UE_SIMD_NEON)
+        FilterRowNEON(Dest, Line, LineStart, LineEnd, X0, X1, Kernel);
+#else
+        FilterRowScalar(Dest, Line, LineStart, LineEnd, X0, X1, Kernel);
+#endif
+    }
+
+    //Source texels [Start, End) that destination texels [X0, X1) read
+    void SourceRange(const MipKernel& Kernel, int X0, int X1, int SrcSize, int& Start, int& End){
+        Start = std::clamp((2 * X0) + Kernel.First, 0, SrcSize - 1);
+        End = std::clamp((2 * (X1 - 1)) + Kernel.First + Kernel.Count - 1, 0, SrcSize - 1) + 1;
+    }
+
+    //Destination rows [Y0, Y1) of the columns [X0, X1)
+    void DownsampleRows(const uint8_t* Src, int SrcSize, uint8_t* Dest, int DestSize, int X0, int X1, int Y0, int Y1, const MipSettings& Settings){
+        const MipKernel& kernel = GetKernel(Settings.Filter);
+        const ColourTables& tables = GetTables();
+        const float* toFloat = Settings.GammaCorrect ? tables.ToLinear : tables.Identity;
+
+        //Already premultiplied levels are filtered as they are
+        bool premultiply = Settings.PremultipliedAlpha && !Settings.OutputPremultiplied;
+
+        int columnStart, columnEnd, rowStart, rowEnd;
+        SourceRange(kernel, X0, X1, SrcSize, columnStart, columnEnd);
+        SourceRange(kernel, Y0, Y1, SrcSize, rowStart, rowEnd);
+
+        int width = X1 - X0;
+        std::vector<float> line((size_t)(columnEnd - columnStart) * 4);
+        std::vector<float> filtered((size_t)(rowEnd - rowStart) * width * 4);
+        std::vector<float> sum((size_t)width * 4);
+
+        //Horizontal pass over every source row the vertical pass needs
+        for(int y = rowStart; y < rowEnd; y++){
+            const uint8_t* row = Src + ((((size_t)y * SrcSize) + columnStart) * 4);
+
+            for(int x = 0; x < columnEnd - columnStart; x++){
+                const uint8_t* texel = row + (x * 4);
+                float* out = &line[x * 4];
+                float alpha = texel[3] / 255.f;
+                float scale = premultiply ? alpha : 1.f;
+
+                out[0] = toFloat[texel[0]] * scale;
+                out[1] = toFloat[texel[1]] * scale;
+                out[2] = toFloat[texel[2]] * scale;
+                out[3] = alpha;
+            }
+
+            FilterRow(&filtered[(size_t)(y - rowStart) * width * 4], &line[0], columnStart, columnEnd, X0, X1, kernel);
+        }
+
+        //Vertical pass and back to bytes
+        for(int y = Y0; y < Y1; y++){
+            std::fill(sum.begin(), sum.end(), 0.f);
+
+            for(int k = 0; k < kernel.Count; k++){
+                int source = std::clamp((2 * y) + kernel.First + k, rowStart, rowEnd - 1);
+                Accumulate(&sum[0], &filtered[(size_t)(source - rowStart) * width * 4], kernel.Weights[k], sum.size());
+            }
+
+            uint8_t* out = Dest + ((((size_t)y * DestSize) + X0) * 4);
+
+            for(int x = 0; x < width; x++){
+                float* texel = &sum[x * 4];
+                float alpha = std::clamp(texel[3], 0.f, 1.f);
+                float scale = (premultiply && alpha > 0.f) ? 1.f / alpha : 1.f;
+
+                for(int c = 0; c < 3; c++){
+                    float value = std::clamp(texel[c] * scale, 0.f, 1.f);
+                    out[(x * 4) + c] = Settings.GammaCorrect ? tables.ToSRGB[(int)((value * 4095.f) + 0.5f)] : (uint8_t)((value * 255.f) + 0.5f);
+                }
+                out[(x * 4) + 3] = (uint8_t)((alpha * 255.f) + 0.5f);
+            }
+        }
+    }
+}
+
+int UnifiedEngine::MipLevelCount(int Size){
+    int levels = 1;
+
+    while(Size > 1){
+        Size >>= 1;
+        levels++;
+    }
+
+    return levels;
+}
+
+size_t UnifiedEngine::MipChainOffset(int Size, int Level){
+    size_t offset = 0;
+
+    for(int i = 0; i < Level; i++){
+        size_t size = std::max(Size >> i, 1);
+        offset += size * size * 4;
+    }
+
+    return offset;
+}
+
+int UnifiedEngine::PremultiplyAlpha(uint8_t* Pixels, size_t Count){
+    size_t i = 0;
+
+#if defined(UE_SIMD_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rounding = _mm_set1_epi16(128);
+    const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0); //Keep alpha itself
+
+    for(; i + 4 <= Count; i += 4){
+        __m128i texels = _mm_loadu_si128((const __m128i*)(Pixels + (i * 4)));
+        __m128i low = _mm_unpacklo_epi8(texels, zero);
+        __m128i high = _mm_unpackhi_epi8(texels, zero);
+
+        //Broadcast each texel's alpha over its four lanes
+        __m128i lowAlpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(low, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i highAlpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(high, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+        //x * a / 255 rounded: t = x * a + 128, (t + (t >> 8)) >> 8
+        __m128i lowProduct = _mm_add_epi16(_mm_mullo_epi16(low, lowAlpha), rounding);
+        __m128i highProduct = _mm_add_epi16(_mm_mullo_epi16(high, highAlpha), rounding);
+        lowProduct = _mm_srli_epi16(_mm_add_epi16(lowProduct, _mm_srli_epi16(lowProduct, 8)), 8);
+        highProduct = _mm_srli_epi16(_mm_add_epi16(highProduct, _mm_srli_epi16(highProduct, 8)), 8);
+
+        low = _mm_or_si128(_mm_and_si128(alphaLanes, low), _mm_andnot_si128(alphaLanes, lowProduct));
+        high = _mm_or_si128(_mm_and_si128(alphaLanes, high), _mm_andnot_si128(alphaLanes, highProduct));
+
+        _mm_storeu_si128((__m128i*)(Pixels + (i * 4)), _mm_packus_epi16(low, high));
+    }
+#elif defined(UE_SIMD_NEON)
+    for(; i + 8 <= Count; i += 8){
+        uint8x8x4_t texels = vld4_u8(Pixels + (i * 4));
+
+        for(int c = 0; c < 3; c++){
+            uint16x8_t product = vaddq_u16(vmull_u8(texels.val[c], texels.val[3]), vdupq_n_u16(128));
+            texels.val[c] = vshrn_n_u16(vaddq_u16(product, vshrq_n_u16(product, 8)), 8);
+        }
+
+        vst4_u8(Pixels + (i * 4), texels);
+    }
+#endif
+
+    for(; i < Count; i++){
+        uint8_t* texel = Pixels + (i * 4);
+
+        for(int c = 0; c < 3; c++){
+            int product = (texel[c] * texel[3]) + 128;
+            texel[c] = (product + (product >> 8)) >> 8;
+        }
+    }
+
+    return 0;
+}
+
+glm::ivec4 UnifiedEngine::DownsampleRegion(const uint8_t* Src, int SrcSize, uint8_t* Dest, glm::ivec4 Region, const MipSettings& Settings){
+    if(SrcSize <= 1 || Region.z <= Region.x || Region.w <= Region.y){
+        return glm::ivec4(0);
+    }
+
+    const MipKernel& kernel = GetKernel(Settings.Filter);
+    int destSize = SrcSize / 2;
+
+    //Every destination texel whose taps touch the region
+    int lastTap = kernel.First + kernel.Count - 1;
+    glm::ivec4 written(
+        std::clamp((int)std::ceil((Region.x - lastTap) / 2.0), 0, destSize),
+        std::clamp((int)std::ceil((Region.y - lastTap) / 2.0), 0, destSize),
+        std::clamp((int)std::floor((Region.z - 1 - kernel.First) / 2.0) + 1, 0, destSize),
+        std::clamp((int)std::floor((Region.w - 1 - kernel.First) / 2.0) + 1, 0, destSize)
+    );
+
+    if(written.z <= written.x || written.w <= written.y){
+        return glm::ivec4(0);
+    }
+
+    auto rows = [&](size_t Begin, size_t End){
+        DownsampleRows(Src, SrcSize, Dest, destSize, written.x, written.z, written.y + (int)Begin, written.y + (int)End, Settings);
+    };
+
+    size_t height = written.w - written.y;
+
+    if(__GLOBAL_THREAD_POOL)
+        __GLOBAL_THREAD_POOL->ParallelFor(height, 16, rows);
+    else
+        rows(0, height);
+
+    return written;
+}
+
+int UnifiedEngine::BuildMipChain(uint8_t* Chain, int Size, const MipSettings& Settings){
+    int levels = MipLevelCount(Size);
+
+    for(int level = 1; level < levels; level++){
+        int srcSize = std::max(Size >> (level - 1), 1);
+
+        DownsampleRegion(Chain + MipChainOffset(Size, level - 1), srcSize, Chain + MipChainOffset(Size, level), glm::ivec4(0, 0, srcSize, srcSize), Settings);
+    }
+
+    return 0;
+}
@@ -5,7 +5,7 @@
 namespace UnifiedEngine
 {
     // Standard shaders
-    const char* STANDARD_VERTEXT_SHADER_CODE = "#version 460\n\nlayout (location = 0) in vec3 vertex_position;\nlayout (location = 1) in vec3 vertex_color;\nlayout (location = 2) in vec2 vertex_texcoord;\nlayout (location = 3) in vec3 vertex_normal;\n\nout vec3 vs_position;\nout vec3 vs_color;\nout vec2 vs_texcoord;\nout vec3 vs_normal;\n\nuniform mat4 ModelMatrix;\nuniform mat4 ViewMatrix;\nuniform mat4 ProjectionMatrix;\n\nvoid main(){\n	vs_position = vec4(ModelMatrix * vec4(vertex_position, 1.f)).xyz;\n	vs_color = vertex_color;\n	vs_texcoord = vec2(vertex_texcoord.x, vertex_texcoord.y * -1.f);\n	vs_normal = mat3(ModelMatrix) * vertex_normal;\n\n	gl_Position = ProjectionMatrix * ViewMatrix * ModelMatrix * vec4(vertex_position, 1.f);\n}";
+    const char* STANDARD_VERTEXT_SHADER_CODE = "#version 460\n\nlayout (location = 0) in vec3 vertex_position;\nlayout (location = 1) in vec3 vertex_color;\nlayout (location = 2) in vec2 vertex_texcoord;\nlayout (location = 3) in vec3 vertex_normal;\n\nout vec3 vs_position;\nout vec3 vs_color;\nout vec2 vs_texcoord;\nout vec3 vs_normal;\n\nuniform mat4 ModelMatrix;\nuniform mat4 ViewMatrix;\nuniform mat4 ProjectionMatrix;\n\n//Compact vertices (See VertexLayout in mesh.h), 0 is uncompressed\nuniform int VertexLayout;\nuniform vec3 MeshOffset;\nuniform vec3 MeshScale;\n\nvec3 DecodeNormal(vec3 n){\n	if(VertexLayout == 0) return n;\n\n	//Octahedral, unfold the lower half\n	vec3 o = vec3(n.xy, 1.f - abs(n.x) - abs(n.y));\n	float t = max(-o.z, 0.f);\n	o.x += (o.x >= 0.f) ? -t : t;\n	o.y += (o.y >= 0.f) ? -t : t;\n	return normalize(o);\n}\n\nvoid main(){\n	vec3 position = (VertexLayout == 0) ? vertex_position : MeshOffset + (vertex_position * MeshScale);\n\n	vs_position = vec4(ModelMatrix * vec4(position, 1.f)).xyz;\n	vs_color = vertex_color;\n	vs_texcoord = vec2(vertex_texcoord.x, vertex_texcoord.y * -1.f);\n	vs_normal = mat3(ModelMatrix) * DecodeNormal(vertex_normal);\n\n	gl_Position = ProjectionMatrix * ViewMatrix * ModelMatrix * vec4(position, 1.f);\n}";
     const char* STANDARD_FRAGMENT_SHADER_CODE = "#version 460\n\n in vec3 vs_position;\n in vec3 vs_color;\n in vec2 vs_texcoord;\n in vec3 vs_normal;\n\n out vec4 fs_color;\n\n uniform vec3 CameraPosition;\n uniform vec3 CameraFront;\n\nvoid main(){\n	//Final\n	fs_color = vec4(vs_color, 1.f);\n\n	if(fs_color.a==0.0) discard;\n	\n	// fs_color = vec4(1.f, 1.f, 1.f, 1.f);\n}";
 
     const char* STANDARD_VERTEX_UI_SHADER_CODE = "#version 460\nlayout (location = 0) in vec3 vertex_position;\nlayout (location = 1) in vec4 vertex_color;\nlayout (location = 2) in vec2 vertex_texcoord;\nout vec3 vs_position;\nout vec4 vs_color;\nout vec2 vs_texcoord;\nvoid main(){\nvs_position = vertex_position;\nvs_color = vertex_color;\nvs_texcoord = vertex_texcoord;\ngl_Position = vec4(vertex_position,1.0);\n}";
@@ -0,0 +1,206 @@
+#include <Unified-Engine/Core/Rendering/staticBatch.h>
+#include <Unified-Engine/Objects/Components/material.h>
+#include <Unified-Engine/debug.h>
+#include <GLM/matrix.hpp>
+#include <GLM/geometric.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+using namespace UnifiedEngine;
+
+StaticBatcher* UnifiedEngine::__GLOBAL_STATIC_BATCHER = nullptr;
+
+//Objects only share a batch when they draw with the same program and atlas page in the same cell
+struct BatchKey{
+    Shader* Program;
+    int Page;
+    int Cell[3];
+
+    bool operator<(const BatchKey& other) const{
+        return std::tie(Program, Page, Cell[0], Cell[1], Cell[2]) < std::tie(other.Program, other.Page, other.Cell[0], other.Cell[1], other.Cell[2]);
+    }
+};
+
+//Page of the first texture material, -1 without one
+static int MaterialPage(ShaderObject* shader){
+    for (auto i = shader->Children.begin(); i != shader->Children.end(); i++){
+        if((*i)->type != OBJECT_MATERIAL)
+            continue;
+
+        Texture2DMaterial* material = dynamic_cast<Texture2DMaterial*>(*i);
+        if(material && material->texture)
+            return material->texture->Page;
+    }
+
+    return -1;
+}
+
+StaticBatcher::StaticBatcher(float CellSize)
+    : CellSize(CellSize)
+{
+
+}
+StaticBatcher::~StaticBatcher(){
+    this->Release();
+}
+
+int StaticBatcher::Add(GameObject* Object){
+    if(Object->Static && std::find(this->Members.begin(), this->Members.end(), Object) == this->Members.end()){
+        this->Members.push_back(Object);
+        this->Dirty = true;
+    }
+
+    for (auto i = Object->Children.begin(); i != Object->Children.end(); i++){
+        if((*i)->type == OBJECT_GAME_OBJECT)
+            this->Add((GameObject*)(*i));
+    }
+
+    return 0;
+}
+
+int StaticBatcher::Remove(GameObject* Object){
+    auto found = std::find(this->Members.begin(), this->Members.end(), Object);
+    if(found != this->Members.end()){
+        this->Members.erase(found);
+        Object->Batched = false;
+        this->Dirty = true;
+    }
+
+    for (auto i = Object->Children.begin(); i != Object->Children.end(); i++){
+        if((*i)->type == OBJECT_GAME_OBJECT)
+            this->Remove((GameObject*)(*i));
+    }
+
+    return 0;
+}
+
+int StaticBatcher::Update(){
+    if(!this->Dirty)
+        return 0;
+
+    this->Dirty = false;
+
+    return this->Bake();
+}
+
+int StaticBatcher::Render(const glm::mat4& ViewProjection){
+    Frustum frustum(ViewProjection);
+
+    this->DrawCalls = 0;
+
+    this->Tree.Query(frustum, [this](int Item){
+        this->Batches[Item].Object->Render();
+        this->DrawCalls++;
+        return true;
+    });
+
+    this->Culled = this->Batches.size() - this->DrawCalls;
+
+    return 0;
+}
+
+int StaticBatcher::Release(){
+    for (auto i = this->Members.begin(); i != this->Members.end(); i++){
+        (*i)->Batched = false;
+    }
+
+    for (auto i = this->Batches.begin(); i != this->Batches.end(); i++){
+        delete (*i).Object;
+    }
+    this->Batches.clear();
+    this->Tree.Clear();
+
+    return 0;
+}
+
+int StaticBatcher::Bake(){
+    this->Release();
+
+    //Sort members into batches by what they draw with and where their bounds' centre falls
+    std::map<BatchKey, std::vector<GameObject*>> groups;
+
+    for (auto i = this->Members.begin(); i != this->Members.end(); i++){
+        GameObject* object = *i;
+
+        if(!object->shader || object->mesh.vertices.empty())
+            continue;
+
+        if(!object->mesh.GeneratedAABB)
+            object->mesh.GeneratedAABB = computeBounds(&object->mesh);
+
+        const AABB& box = *object->mesh.GeneratedAABB;
+        glm::vec3 center = glm::vec3(object->ModelMatrix * glm::vec4((box.min + box.max) * 0.5f, 1.f));
+
+        BatchKey key = {object->shader->shader, MaterialPage(object->shader), {}};
+        for(int k = 0; k < 3; k++){
+            key.Cell[k] = (int)std::floor(center[k] / this->CellSize);
+        }
+
+        groups[key].push_back(object);
+    }
+
+    for (auto i = groups.begin(); i != groups.end(); i++){
+        Mesh combined = {};
+        bool compact = true;
+
+        for (auto j = i->second.begin(); j != i->second.end(); j++){
+            const Mesh& mesh = (*j)->mesh;
+            glm::mat4 model = (*j)->ModelMatrix;
+            glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+
+            GLuint base = (GLuint)combined.vertices.size();
+
+            for (auto v = mesh.vertices.begin(); v != mesh.vertices.end(); v++){
+                Vertex vertex = *v;
+                vertex.position = glm::vec3(model * glm::vec4(vertex.position, 1.f));
+                if(glm::dot(vertex.normal, vertex.normal) > 0.f)
+                    vertex.normal = glm::normalize(normalMatrix * vertex.normal);
+                combined.vertices.push_back(vertex);
+            }
+
+            //Full detail only, batches have no LODs
+            size_t first = mesh.LODs.size() ? mesh.LODs.front().FirstIndex : 0;
+            size_t count = mesh.LODs.size() ? mesh.LODs.front().IndexCount : mesh.indices.size();
+
+            if(mesh.indices.empty()){
+                for(GLuint k = 0; k < mesh.vertices.size(); k++){
+                    combined.indices.push_back(base + k);
+                }
+            }
+            else{
+                for(size_t k = first; k < first + count; k++){
+                    combined.indices.push_back(base + mesh.indices[k]);
+                }
+            }
+
+            compact = compact && mesh.Layout != VERTEX_LAYOUT_FULL;
+            (*j)->Batched = true;
+        }
+
+        //Compact members stay compact, quantized to the cell instead of each object
+        combined.Layout = compact ? VERTEX_LAYOUT_COMPACT : VERTEX_LAYOUT_FULL;
+        combined.GeneratedAABB = computeBounds(&combined);
+
+        AABB bounds = *combined.GeneratedAABB;
+
+        GameObject* batch = new GameObject(std::move(combined), i->second.front()->shader);
+        batch->Name = "StaticBatch";
+        batch->AutoLOD = false;
+        batch->Spatial = false;
+        batch->Update();
+
+        this->Batches.push_back(Batch{batch, bounds});
+    }
+
+    std::vector<AABB> bounds;
+    for (auto i = this->Batches.begin(); i != this->Batches.end(); i++){
+        bounds.push_back((*i).Bounds);
+    }
+    this->Tree.Build(bounds);
+
+    LOG("BAKED ", this->Members.size(), " STATIC OBJECTS INTO ", this->Batches.size(), " BATCHES");
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <Unified-Engine/Core/Rendering/textureBindCache.h>
+#include <Unified-Engine/debug.h>
+
+using namespace UnifiedEngine;
+
+TextureBindCache UnifiedEngine::BindCache;
+
+//Binding state we have not seen yet (Forces the next bind through)
+static const GLuint UNKNOWN_BINDING = 0xFFFFFFFF;
+
+TextureBindCache::TextureBindCache(){
+
+}
+TextureBindCache::~TextureBindCache(){
+
+}
+
+int TextureBindCache::Setup(){
+    //Needs a context so it is done on first use
+    GLint maxUnits = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits);
+
+    if(maxUnits < 2){
+        maxUnits = 16; //Minimum the spec allows
+    }
+
+    this->Units.assign(maxUnits, UnitBindings{{UNKNOWN_BINDING, UNKNOWN_BINDING, UNKNOWN_BINDING}});
+    this->UnitOwners.assign(maxUnits, 0);
+    this->UnitLastUse.assign(maxUnits, 0);
+    this->ActiveUnit = UNKNOWN_BINDING;
+
+    return 0;
+}
+
+int TextureBindCache::TargetSlot(GLenum Target){
+    switch (Target)
+    {
+    case GL_TEXTURE_2D:
+        return 0;
+    case GL_TEXTURE_2D_ARRAY:
+        return 1;
+    case GL_TEXTURE_CUBE_MAP:
+        return 2;
+    default:
+        return -1;
+    }
+}
+
+int TextureBindCache::ActiveTexture(GLuint Unit){
+    if(this->Units.empty())
+        this->Setup();
+
+    if(this->ActiveUnit == Unit){
+        return 0;
+    }
+
+    glActiveTexture(GL_TEXTURE0 + Unit);
+    this->ActiveUnit = Unit;
+
+    return 0;
+}
+
+int TextureBindCache::Bind(GLuint Unit, GLenum Target, GLuint Texture){
+    if(this->Units.empty())
+        this->Setup();
+
+    if(Unit >= this->Units.size()){
+        FAULT("TEXTURE UNIT OUT OF RANGE: ", Unit);
+        return -1;
+    }
+
+    int slot = TargetSlot(Target);
+
+    if(slot >= 0 && this->Units[Unit].Textures[slot] == Texture){
+        this->BindsSkipped++;
+        return 0;
+    }
+
+    this->ActiveTexture(Unit);
+    glBindTexture(Target, Texture);
+    this->BindsIssued++;
+
+    if(slot >= 0)
+        this->Units[Unit].Textures[slot] = Texture;
+
+    return 0;
+}
+
+GLuint TextureBindCache::AssignUnit(GLuint Texture){
+    if(this->Units.empty())
+        this->Setup();
+
+    this->UseCounter++;
+
+    auto found = this->AssignedUnits.find(Texture);
+    if(found != this->AssignedUnits.end()){
+        this->UnitLastUse[found->second] = this->UseCounter;
+        return found->second;
+    }
+
+    //Take a free unit, otherwise the one used longest ago
+    GLuint unit = 0;
+    for(GLuint i = TEXTURE_SCRATCH_UNIT + 1; i < this->UnitOwners.size(); i++){
+        if(!this->UnitOwners[i]){
+            unit = i;
+            break;
+        }
+
+        if(!unit || this->UnitLastUse[i] < this->UnitLastUse[unit])
+            unit = i;
+    }
+
+    if(this->UnitOwners[unit])
+        this->AssignedUnits.erase(this->UnitOwners[unit]);
+
+    this->UnitOwners[unit] = Texture;
+    this->UnitLastUse[unit] = this->UseCounter;
+    this->AssignedUnits[Texture] = unit;
+
+    return unit;
+}
+
+int TextureBindCache::Forget(GLuint Texture){
+    //Deleting a texture unbinds it from every unit
+    for (auto i = this->Units.begin(); i != this->Units.end(); i++){
+        for(int j = 0; j < 3; j++){
+            if((*i).Textures[j] == Texture)
+                (*i).Textures[j] = 0;
+        }
+    }
+
+    auto found = this->AssignedUnits.find(Texture);
+    if(found != this->AssignedUnits.end()){
+        this->UnitOwners[found->second] = 0;
+        this->AssignedUnits.erase(found);
+    }
+
+    return 0;
+}
+
+int TextureBindCache::Invalidate(){
+    for (auto i = this->Units.begin(); i != this->Units.end(); i++){
+        for(int j = 0; j < 3; j++){
+            (*i).Textures[j] = UNKNOWN_BINDING;
+        }
+    }
+    this->ActiveUnit = UNKNOWN_BINDING;
+
+    return 0;
+}
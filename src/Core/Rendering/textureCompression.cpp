@@ -0,0 +1,788 @@
+#include <Unified-Engine/Core/Rendering/textureCompression.h>
+#include <Unified-Engine/Core/threadPool.h>
+#include <Unified-Engine/Utility/simd.h>
+#include <Unified-Engine/debug.h>
+#include <algorithm>
+#include <cstring>
+#include <cfloat>
+#include <cmath>
+
+using namespace UnifiedEngine;
+
+namespace {
+    //One 4x4 block split into channels so the kernels can work on 4/8 pixels at once
+    struct Block{
+        float r[16];
+        float g[16];
+        float b[16];
+        float a[16];
+    };
+
+    //Interpolation weights out of 64 for BC7 4 bit indices
+    constexpr int BC7_WEIGHTS[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    void LoadBlock(const uint8_t* Src, int x, int y, int Width, int Height, size_t Stride, Block& block){
+        //Edge blocks repeat the last row/column
+        for(int j = 0; j < 4; j++){
+            const uint8_t* row = Src + (size_t)std::min(y + j, Height - 1) * Stride;
+
+            for(int i = 0; i < 4; i++){
+                const uint8_t* pixel = row + (size_t)std::min(x + i, Width - 1) * 4;
+                int p = (j * 4) + i;
+
+                block.r[p] = pixel[0];
+                block.g[p] = pixel[1];
+                block.b[p] = pixel[2];
+                block.a[p] = pixel[3];
+            }
+        }
+    }
+
+    //Nearest palette entry for every pixel, returns the summed squared error
+    float NearestScalar(const Block& block, const float (*Palette)[4], int Count, bool Alpha, uint8_t* Indices){
+        float total = 0;
+
+        for(int p = 0; p < 16; p++){
+            float best = FLT_MAX;
+            int bestIndex = 0;
+
+            for(int c = 0; c < Count; c++){
+                float dr = block.r[p] - Palette[c][0];
+                float dg = block.g[p] - Palette[c][1];
+                float db = block.b[p] - Palette[c][2];
+                float da = Alpha ? block.a[p] - Palette[c][3] : 0.f;
+                float d = (dr * dr) + (dg * dg) + (db * db) + (da * da);
+
+                if(d < best){
+                    best = d;
+                    bestIndex = c;
+                }
+            }
+
+            Indices[p] = bestIndex;
+            total += best;
+        }
+
+        return total;
+    }
+
+#if defined(UE_SIMD_SSE2)
+    float NearestSSE2(const Block& block, const float (*Palette)[4], int Count, bool Alpha, uint8_t* Indices){
+        float total = 0;
+
+        for(int p = 0; p < 16; p += 4){
+            __m128 r = _mm_loadu_ps(block.r + p);
+            __m128 g = _mm_loadu_ps(block.g + p);
+            __m128 b = _mm_loadu_ps(block.b + p);
+            __m128 a = _mm_loadu_ps(block.a + p);
+
+            __m128 best = _mm_set1_ps(FLT_MAX);
+            __m128i bestIndex = _mm_setzero_si128();
+
+            for(int c = 0; c < Count; c++){
+                __m128 dr = _mm_sub_ps(r, _mm_set1_ps(Palette[c][0]));
+                __m128 dg = _mm_sub_ps(g, _mm_set1_ps(Palette[c][1]));
+                __m128 db = _mm_sub_ps(b, _mm_set1_ps(Palette[c][2]));
+                __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db));
+
+                if(Alpha){
+                    __m128 da = _mm_sub_ps(a, _mm_set1_ps(Palette[c][3]));
+                    d = _mm_add_ps(d, _mm_mul_ps(da, da));
+                }
+
+                __m128i closer = _mm_castps_si128(_mm_cmplt_ps(d, best));
+                best = _mm_min_ps(d, best);
+                bestIndex = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(c)), _mm_andnot_si128(closer, bestIndex));
+            }
+
+            alignas(16) int indices[4];
+            alignas(16) float errors[4];
+            _mm_store_si128((__m128i*)indices, bestIndex);
+            _mm_store_ps(errors, best);
+
+            for(int i = 0; i < 4; i++){
+                Indices[p + i] = indices[i];
+                total += errors[i];
+            }
+        }
+
+        return total;
+    }
+
+    UE_TARGET_AVX2 float NearestAVX2(const Block& block, const float (*Palette)[4], int Count, bool Alpha, uint8_t* Indices){
+        float total = 0;
+
+        for(int p = 0; p < 16; p += 8){
+            __m256 r = _mm256_loadu_ps(block.r + p);
+            __m256 g = _mm256_loadu_ps(block.g + p);
+            __m256 b = _mm256_loadu_ps(block.b + p);
+            __m256 a = _mm256_loadu_ps(block.a + p);
+
+            __m256 best = _mm256_set1_ps(FLT_MAX);
+            __m256 bestIndex = _mm256_setzero_ps();
+
+            for(int c = 0; c < Count; c++){
+                __m256 dr = _mm256_sub_ps(r, _mm256_set1_ps(Palette[c][0]));
+                __m256 dg = _mm256_sub_ps(g, _mm256_set1_ps(Palette[c][1]));
+                __m256 db = _mm256_sub_ps(b, _mm256_set1_ps(Palette[c][2]));
+                __m256 d = _mm256_fmadd_ps(db, db, _mm256_fmadd_ps(dg, dg, _mm256_mul_ps(dr, dr)));
+
+                if(Alpha){
+                    __m256 da = _mm256_sub_ps(a, _mm256_set1_ps(Palette[c][3]));
+                    d = _mm256_fmadd_ps(da, da, d);
+                }
+
+                __m256 closer = _mm256_cmp_ps(d, best, _CMP_LT_OQ);
+                best = _mm256_min_ps(d, best);
+                bestIndex = _mm256_blendv_ps(bestIndex, _mm256_set1_ps((float)c), closer);
+            }
+
+            alignas(32) int indices[8];
+            alignas(32) float errors[8];
+            _mm256_store_si256((__m256i*)indices, _mm256_cvtps_epi32(bestIndex));
+            _mm256_store_ps(errors, best);
+
+            for(int i = 0; i < 8; i++){
+                Indices[p + i] = indices[i];
+                total += errors[i];
+            }
+        }
+
+        return total;
+    }
+#endif
+
+#if defined(UE_SIMD_NEON)
+    float NearestNEON(const Block& block, const float (*Palette)[4], int Count, bool Alpha, uint8_t* Indices){
+        float total = 0;
+
+        for(int p = 0; p < 16; p += 4){
+            float32x4_t r = vld1q_f32(block.r + p);
+            float32x4_t g = vld1q_f32(block.g + p);
+            float32x4_t b = vld1q_f32(block.b + p);
+            float32x4_t a = vld1q_f32(block.a + p);
+
+            float32x4_t best = vdupq_n_f32(FLT_MAX);
+            uint32x4_t bestIndex = vdupq_n_u32(0);
+
+            for(int c = 0; c < Count; c++){
+                float32x4_t dr = vsubq_f32(r, vdupq_n_f32(Palette[c][0]));
+                float32x4_t dg = vsubq_f32(g, vdupq_n_f32(Palette[c][1]));
+                float32x4_t db = vsubq_f32(b, vdupq_n_f32(Palette[c][2]));
+                float32x4_t d = vmlaq_f32(vmlaq_f32(vmulq_f32(dr, dr), dg, dg), db, db);
+
+                if(Alpha){
+                    float32x4_t da = vsubq_f32(a, vdupq_n_f32(Palette[c][3]));
+                    d = vmlaq_f32(d, da, da);
+                }
+
+                uint32x4_t closer = vcltq_f32(d, best);
+                best = vminq_f32(d, best);
+                bestIndex = vbslq_u32(closer, vdupq_n_u32(c), bestIndex);
+            }
+
+            uint32_t indices[4];
+            float errors[4];
+            vst1q_u32(indices, bestIndex);
+            vst1q_f32(errors, best);
+
+            for(int i = 0; i < 4; i++){
+                Indices[p + i] = indices[i];
+                total += errors[i];
+            }
+        }
+
+        return total;
+    }
+#endif
+
+    float Nearest(const Block& block, const float (*Palette)[4], int Count, bool Alpha, uint8_t* Indices){
+#if defined(UE_SIMD_SSE2)
+        if(CPUSupportsAVX2())
+            return NearestAVX2(block, Palette, Count, Alpha, Indices);
+
+        return NearestSSE2(block, Palette, Count, Alpha, Indices);
+#elif defined(UE_SIMD_NEON)
+        return NearestNEON(block, Palette, Count, Alpha, Indices);
+#else
+        return NearestScalar(block, Palette, Count, Alpha, Indices);
+#endif
+    }
+
+    //End points of the block along its principal axis (Dims = 3 for RGB, 4 for RGBA)
+    void PrincipalEndpoints(const Block& block, int Dims, float Low[4], float High[4]){
+        const float* channels[4] = {block.r, block.g, block.b, block.a};
+
+        float mean[4] = {0, 0, 0, 0};
+        for(int c = 0; c < Dims; c++){
+            for(int p = 0; p < 16; p++)
+                mean[c] += channels[c][p];
+            mean[c] /= 16.f;
+        }
+
+        float covariance[4][4] = {};
+        for(int p = 0; p < 16; p++){
+            for(int i = 0; i < Dims; i++){
+                for(int j = i; j < Dims; j++)
+                    covariance[i][j] += (channels[i][p] - mean[i]) * (channels[j][p] - mean[j]);
+            }
+        }
+        for(int i = 0; i < Dims; i++){
+            for(int j = 0; j < i; j++)
+                covariance[i][j] = covariance[j][i];
+        }
+
+        //Power iteration, a handful of steps is plenty for 16 points
+        float axis[4] = {1, 1, 1, 1};
+        for(int step = 0; step < 8; step++){
+            float next[4] = {0, 0, 0, 0};
+            float length = 0;
+
+            for(int i = 0; i < Dims; i++){
+                for(int j = 0; j < Dims; j++)
+                    next[i] += covariance[i][j] * axis[j];
+                length = std::max(length, std::fabs(next[i]));
+            }
+
+            if(length < 1e-6f)
+                break;
+
+            for(int i = 0; i < Dims; i++)
+                axis[i] = next[i] / length;
+        }
+
+        float low = FLT_MAX;
+        float high = -FLT_MAX;
+        for(int p = 0; p < 16; p++){
+            float t = 0;
+            for(int c = 0; c < Dims; c++)
+                t += (channels[c][p] - mean[c]) * axis[c];
+
+            low = std::min(low, t);
+            high = std::max(high, t);
+        }
+
+        float axisLength = 0;
+        for(int c = 0; c < Dims; c++)
+            axisLength += axis[c] * axis[c];
+        axisLength = (axisLength > 0) ? axisLength : 1.f;
+
+        for(int c = 0; c < 4; c++){
+            float direction = (c < Dims) ? axis[c] / axisLength : 0.f;
+            Low[c] = std::clamp(mean[c] + (low * direction), 0.f, 255.f);
+            High[c] = std::clamp(mean[c] + (high * direction), 0.f, 255.f);
+        }
+    }
+
+    //Least squares end points for fixed indices, Weights[i] is how far index i is towards End
+    bool FitEndpoints(const Block& block, const uint8_t* Indices, const float* Weights, int Dims, float Start[4], float End[4]){
+        const float* channels[4] = {block.r, block.g, block.b, block.a};
+
+        float aa = 0, ab = 0, bb = 0;
+        float x[4] = {0, 0, 0, 0};
+        float y[4] = {0, 0, 0, 0};
+
+        for(int p = 0; p < 16; p++){
+            float w = Weights[Indices[p]];
+            float iw = 1.f - w;
+
+            aa += iw * iw;
+            ab += iw * w;
+            bb += w * w;
+
+            for(int c = 0; c < Dims; c++){
+                x[c] += iw * channels[c][p];
+                y[c] += w * channels[c][p];
+            }
+        }
+
+        float determinant = (aa * bb) - (ab * ab);
+        if(std::fabs(determinant) < 1e-6f)
+            return false;
+
+        for(int c = 0; c < Dims; c++){
+            Start[c] = std::clamp(((bb * x[c]) - (ab * y[c])) / determinant, 0.f, 255.f);
+            End[c] = std::clamp(((aa * y[c]) - (ab * x[c])) / determinant, 0.f, 255.f);
+        }
+
+        return true;
+    }
+
+    uint16_t Pack565(const float* Colour){
+        int r = std::clamp((int)((Colour[0] * 31.f / 255.f) + 0.5f), 0, 31);
+        int g = std::clamp((int)((Colour[1] * 63.f / 255.f) + 0.5f), 0, 63);
+        int b = std::clamp((int)((Colour[2] * 31.f / 255.f) + 0.5f), 0, 31);
+
+        return (r << 11) | (g << 5) | b;
+    }
+    void Unpack565(uint16_t Packed, int* Colour){
+        int r = (Packed >> 11) & 31;
+        int g = (Packed >> 5) & 63;
+        int b = Packed & 31;
+
+        Colour[0] = (r << 3) | (r >> 2);
+        Colour[1] = (g << 2) | (g >> 4);
+        Colour[2] = (b << 3) | (b >> 2);
+        Colour[3] = 255;
+    }
+
+    void PaletteBC1(uint16_t C0, uint16_t C1, int (*Palette)[4]){
+        Unpack565(C0, Palette[0]);
+        Unpack565(C1, Palette[1]);
+
+        for(int c = 0; c < 4; c++){
+            if(C0 > C1){
+                Palette[2][c] = ((2 * Palette[0][c]) + Palette[1][c]) / 3;
+                Palette[3][c] = (Palette[0][c] + (2 * Palette[1][c])) / 3;
+            }
+            else{
+                Palette[2][c] = (Palette[0][c] + Palette[1][c]) / 2;
+                Palette[3][c] = 0;
+            }
+        }
+    }
+
+    //Orders the end points for 4 colour mode and picks indices, returns the error
+    float EvaluateBC1(const Block& block, uint16_t& C0, uint16_t& C1, uint8_t* Indices){
+        if(C0 < C1)
+            std::swap(C0, C1);
+
+        int palette[4][4];
+        PaletteBC1(C0, C1, palette);
+
+        float paletteF[4][4];
+        for(int i = 0; i < 4; i++){
+            for(int c = 0; c < 4; c++)
+                paletteF[i][c] = palette[i][c];
+        }
+
+        //Equal end points decode in 3 colour mode, only index 0 is safe
+        int count = (C0 == C1) ? 1 : 4;
+
+        return Nearest(block, paletteF, count, false, Indices);
+    }
+
+    void EncodeBC1(const Block& block, uint8_t* Out){
+        float low[4], high[4];
+        PrincipalEndpoints(block, 3, low, high);
+
+        uint16_t c0 = Pack565(high);
+        uint16_t c1 = Pack565(low);
+        uint8_t indices[16];
+        float error = EvaluateBC1(block, c0, c1, indices);
+
+        //One refinement pass with the indices fixed
+        constexpr float weights[4] = {0.f, 1.f, 1.f / 3.f, 2.f / 3.f};
+        float start[4], end[4];
+
+        if(error > 0 && FitEndpoints(block, indices, weights, 3, start, end)){
+            uint16_t r0 = Pack565(start);
+            uint16_t r1 = Pack565(end);
+            uint8_t refined[16];
+            float refinedError = EvaluateBC1(block, r0, r1, refined);
+
+            if(refinedError < error){
+                c0 = r0;
+                c1 = r1;
+                std::memcpy(indices, refined, 16);
+            }
+        }
+
+        uint32_t packed = 0;
+        for(int p = 0; p < 16; p++)
+            packed |= (uint32_t)indices[p] << (p * 2);
+
+        Out[0] = c0 & 0xFF;
+        Out[1] = c0 >> 8;
+        Out[2] = c1 & 0xFF;
+        Out[3] = c1 >> 8;
+        std::memcpy(Out + 4, &packed, 4);
+    }
+
+    void PaletteAlpha(int A0, int A1, int* Palette){
+        Palette[0] = A0;
+        Palette[1] = A1;
+
+        for(int i = 2; i < 8; i++){
+            if(A0 > A1)
+                Palette[i] = (((8 - i) * A0) + ((i - 1) * A1)) / 7;
+            else if(i < 6)
+                Palette[i] = (((6 - i) * A0) + ((i - 1) * A1)) / 5;
+            else
+                Palette[i] = (i == 6) ? 0 : 255;
+        }
+    }
+
+    void EncodeAlpha(const Block& block, uint8_t* Out){
+        int a0 = 0;
+        int a1 = 255;
+        for(int p = 0; p < 16; p++){
+            a0 = std::max(a0, (int)block.a[p]);
+            a1 = std::min(a1, (int)block.a[p]);
+        }
+
+        int palette[8];
+        PaletteAlpha(a0, a1, palette);
+
+        uint64_t packed = 0;
+        if(a0 != a1){
+            for(int p = 0; p < 16; p++){
+                int best = 0;
+                int bestError = 256;
+
+                for(int i = 0; i < 8; i++){
+                    int error = std::abs((int)block.a[p] - palette[i]);
+                    if(error < bestError){
+                        bestError = error;
+                        best = i;
+                    }
+                }
+
+                packed |= (uint64_t)best << (p * 3);
+            }
+        }
+
+        Out[0] = a0;
+        Out[1] = a1;
+        for(int i = 0; i < 6; i++)
+            Out[2 + i] = (packed >> (i * 8)) & 0xFF;
+    }
+
+    //BC7 is packed least significant bit first
+    struct BitWriter{
+        uint8_t* Out;
+        int Position = 0;
+
+        void Write(uint32_t Value, int Bits){
+            for(int i = 0; i < Bits; i++, this->Position++){
+                if((Value >> i) & 1)
+                    this->Out[this->Position >> 3] |= 1 << (this->Position & 7);
+            }
+        }
+    };
+    struct BitReader{
+        const uint8_t* In;
+        int Position = 0;
+
+        uint32_t Read(int Bits){
+            uint32_t value = 0;
+            for(int i = 0; i < Bits; i++, this->Position++)
+                value |= (uint32_t)((this->In[this->Position >> 3] >> (this->Position & 7)) & 1) << i;
+            return value;
+        }
+    };
+
+    //7 bits per channel plus a shared parity bit per end point
+    void QuantizeMode6(const float* Colour, uint8_t* Quantized, int& Parity){
+        float bestError = FLT_MAX;
+
+        for(int p = 0; p < 2; p++){
+            uint8_t q[4];
+            float error = 0;
+
+            for(int c = 0; c < 4; c++){
+                q[c] = std::clamp((int)std::lround((Colour[c] - p) / 2.f), 0, 127);
+                float d = (float)((q[c] << 1) | p) - Colour[c];
+                error += d * d;
+            }
+
+            if(error < bestError){
+                bestError = error;
+                Parity = p;
+                std::memcpy(Quantized, q, 4);
+            }
+        }
+    }
+
+    float EvaluateMode6(const Block& block, const float* Start, const float* End, uint8_t (*Quantized)[4], int* Parity, uint8_t* Indices){
+        QuantizeMode6(Start, Quantized[0], Parity[0]);
+        QuantizeMode6(End, Quantized[1], Parity[1]);
+
+        float palette[16][4];
+        for(int i = 0; i < 16; i++){
+            for(int c = 0; c < 4; c++){
+                int e0 = (Quantized[0][c] << 1) | Parity[0];
+                int e1 = (Quantized[1][c] << 1) | Parity[1];
+                palette[i][c] = (((64 - BC7_WEIGHTS[i]) * e0) + (BC7_WEIGHTS[i] * e1) + 32) >> 6;
+            }
+        }
+
+        return Nearest(block, palette, 16, true, Indices);
+    }
+
+    void EncodeBC7(const Block& block, uint8_t* Out){
+        float start[4], end[4];
+        PrincipalEndpoints(block, 4, start, end);
+
+        uint8_t quantized[2][4];
+        int parity[2];
+        uint8_t indices[16];
+        float error = EvaluateMode6(block, start, end, quantized, parity, indices);
+
+        float weights[16];
+        for(int i = 0; i < 16; i++)
+            weights[i] = BC7_WEIGHTS[i] / 64.f;
+
+        if(error > 0 && FitEndpoints(block, indices, weights, 4, start, end)){
+            uint8_t refinedQuantized[2][4];
+            int refinedParity[2];
+            uint8_t refined[16];
+            float refinedError = EvaluateMode6(block, start, end, refinedQuantized, refinedParity, refined);
+
+            if(refinedError < error){
+                std::memcpy(quantized, refinedQuantized, sizeof(quantized));
+                std::memcpy(parity, refinedParity, sizeof(parity));
+                std::memcpy(indices, refined, 16);
+            }
+        }
+
+        //The first index only stores 3 bits so its top bit has to be clear
+        if(indices[0] & 8){
+            std::swap(quantized[0], quantized[1]);
+            std::swap(parity[0], parity[1]);
+            for(int p = 0; p < 16; p++)
+                indices[p] = 15 - indices[p];
+        }
+
+        std::memset(Out, 0, 16);
+        BitWriter writer{Out};
+
+        writer.Write(1 << 6, 7); //Mode 6
+        for(int c = 0; c < 4; c++){
+            writer.Write(quantized[0][c], 7);
+            writer.Write(quantized[1][c], 7);
+        }
+        writer.Write(parity[0], 1);
+        writer.Write(parity[1], 1);
+
+        writer.Write(indices[0], 3);
+        for(int p = 1; p < 16; p++)
+            writer.Write(indices[p], 4);
+    }
+
+    void DecodeBC1(const uint8_t* In, uint8_t* Pixels, size_t Stride){
+        uint16_t c0 = In[0] | (In[1] << 8);
+        uint16_t c1 = In[2] | (In[3] << 8);
+        uint32_t packed;
+        std::memcpy(&packed, In + 4, 4);
+
+        int palette[4][4];
+        PaletteBC1(c0, c1, palette);
+        if(c0 <= c1)
+            palette[3][3] = 0;
+
+        for(int p = 0; p < 16; p++){
+            uint8_t* pixel = Pixels + ((p / 4) * Stride) + ((p % 4) * 4);
+            int* colour = palette[(packed >> (p * 2)) & 3];
+
+            for(int c = 0; c < 4; c++)
+                pixel[c] = colour[c];
+        }
+    }
+
+    void DecodeAlpha(const uint8_t* In, uint8_t* Pixels, size_t Stride){
+        int palette[8];
+        PaletteAlpha(In[0], In[1], palette);
+
+        uint64_t packed = 0;
+        for(int i = 0; i < 6; i++)
+            packed |= (uint64_t)In[2 + i] << (i * 8);
+
+        for(int p = 0; p < 16; p++)
+            Pixels[((p / 4) * Stride) + ((p % 4) * 4) + 3] = palette[(packed >> (p * 3)) & 7];
+    }
+
+    int DecodeBC7(const uint8_t* In, uint8_t* Pixels, size_t Stride){
+        BitReader reader{In};
+
+        if(reader.Read(7) != (1 << 6))
+            return -1;
+
+        int endpoints[2][4];
+        for(int c = 0; c < 4; c++){
+            endpoints[0][c] = reader.Read(7);
+            endpoints[1][c] = reader.Read(7);
+        }
+
+        int parity0 = reader.Read(1);
+        int parity1 = reader.Read(1);
+        for(int c = 0; c < 4; c++){
+            endpoints[0][c] = (endpoints[0][c] << 1) | parity0;
+            endpoints[1][c] = (endpoints[1][c] << 1) | parity1;
+        }
+
+        for(int p = 0; p < 16; p++){
+            int weight = BC7_WEIGHTS[reader.Read(p ? 4 : 3)];
+            uint8_t* pixel = Pixels + ((p / 4) * Stride) + ((p % 4) * 4);
+
+            for(int c = 0; c < 4; c++)
+                pixel[c] = (((64 - weight) * endpoints[0][c]) + (weight * endpoints[1][c]) + 32) >> 6;
+        }
+
+        return 0;
+    }
+
+    bool HasExtension(const char* Name){
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+        for(GLint i = 0; i < count; i++){
+            const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+            if(extension && !std::strcmp(extension, Name))
+                return true;
+        }
+
+        return false;
+    }
+}
+
+size_t UnifiedEngine::CompressedBlockSize(TextureCompression Format){
+    switch(Format){
+        case TEXTURE_COMPRESSION_BC1:
+            return 8;
+        case TEXTURE_COMPRESSION_BC3:
+        case TEXTURE_COMPRESSION_BC7:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+size_t UnifiedEngine::CompressedImageSize(TextureCompression Format, int Width, int Height){
+    return (size_t)((Width + 3) / 4) * ((Height + 3) / 4) * CompressedBlockSize(Format);
+}
+
+GLenum UnifiedEngine::CompressedInternalFormat(TextureCompression Format){
+    switch(Format){
+        case TEXTURE_COMPRESSION_BC1:
+            return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case TEXTURE_COMPRESSION_BC3:
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TEXTURE_COMPRESSION_BC7:
+            return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        default:
+            return GL_RGBA;
+    }
+}
+
+TextureCompression UnifiedEngine::SupportedCompression(TextureCompression Requested){
+    if(Requested == TEXTURE_COMPRESSION_BC7 && !GLAD_GL_VERSION_4_2 && !HasExtension("GL_ARB_texture_compression_bptc")){
+        WARN("BC7 NOT SUPPORTED, FALLING BACK TO BC3");
+        Requested = TEXTURE_COMPRESSION_BC3;
+    }
+
+    if((Requested == TEXTURE_COMPRESSION_BC1 || Requested == TEXTURE_COMPRESSION_BC3) && !HasExtension("GL_EXT_texture_compression_s3tc")){
+        WARN("S3TC NOT SUPPORTED, ATLAS WILL NOT BE COMPRESSED");
+        Requested = TEXTURE_COMPRESSION_NONE;
+    }
+
+    return Requested;
+}
+
+int UnifiedEngine::CompressImage(TextureCompression Format, const uint8_t* Src, int Width, int Height, size_t Stride, uint8_t* Dest){
+    size_t blockSize = CompressedBlockSize(Format);
+
+    if(!blockSize || !Src || !Dest || Width <= 0 || Height <= 0){
+        FAULT("INVALID IMAGE COMPRESSION REQUEST");
+        return -1;
+    }
+
+    if(!Stride)
+        Stride = (size_t)Width * 4;
+
+    int blocksWide = (Width + 3) / 4;
+    int blocksHigh = (Height + 3) / 4;
+
+    auto encodeRows = [&](size_t Begin, size_t End){
+        Block block;
+
+        for(size_t y = Begin; y < End; y++){
+            for(int x = 0; x < blocksWide; x++){
+                uint8_t* out = Dest + (((y * blocksWide) + x) * blockSize);
+                LoadBlock(Src, x * 4, y * 4, Width, Height, Stride, block);
+
+                switch(Format){
+                    case TEXTURE_COMPRESSION_BC1:
+                        EncodeBC1(block, out);
+                        break;
+                    case TEXTURE_COMPRESSION_BC3:
+                        EncodeAlpha(block, out);
+                        EncodeBC1(block, out + 8);
+                        break;
+                    default:
+                        EncodeBC7(block, out);
+                        break;
+                }
+            }
+        }
+    };
+
+    if(__GLOBAL_THREAD_POOL)
+        __GLOBAL_THREAD_POOL->ParallelFor(blocksHigh, 8, encodeRows);
+    else
+        encodeRows(0, blocksHigh);
+
+    return 0;
+}
+
+int UnifiedEngine::DecompressImage(TextureCompression Format, const uint8_t* Src, int Width, int Height, uint8_t* Dest){
+    size_t blockSize = CompressedBlockSize(Format);
+
+    if(!blockSize || !Src || !Dest){
+        FAULT("INVALID IMAGE DECOMPRESSION REQUEST");
+        return -1;
+    }
+
+    int blocksWide = (Width + 3) / 4;
+    int blocksHigh = (Height + 3) / 4;
+    uint8_t pixels[16 * 4];
+
+    for(int y = 0; y < blocksHigh; y++){
+        for(int x = 0; x < blocksWide; x++){
+            const uint8_t* in = Src + ((((size_t)y * blocksWide) + x) * blockSize);
+
+            switch(Format){
+                case TEXTURE_COMPRESSION_BC1:
+                    DecodeBC1(in, pixels, 16);
+                    break;
+                case TEXTURE_COMPRESSION_BC3:
+                    DecodeBC1(in + 8, pixels, 16);
+                    DecodeAlpha(in, pixels, 16);
+                    break;
+                default:
+                    if(DecodeBC7(in, pixels, 16)){
+                        FAULT("ONLY BC7 MODE 6 CAN BE DECODED");
+                        return -1;
+                    }
+                    break;
+            }
+
+            //Drop the padding of edge blocks
+            for(int j = 0; j < 4 && (y * 4) + j < Height; j++){
+                int columns = std::min(4, Width - (x * 4));
+                std::memcpy(Dest + ((((size_t)(y * 4) + j) * Width) + (x * 4)) * 4, pixels + (j * 16), columns * 4);
+            }
+        }
+    }
+
+    return 0;
+}
+
+double UnifiedEngine::ComputePSNR(const uint8_t* A, const uint8_t* B, int Width, int Height, int Channels){
+    double squared = 0;
+    size_t pixels = (size_t)Width * Height;
+
+    for(size_t p = 0; p < pixels; p++){
+        for(int c = 0; c < Channels; c++){
+            double d = (double)A[(p * 4) + c] - B[(p * 4) + c];
+            squared += d * d;
+        }
+    }
+
+    double mse = squared / (double)(pixels * Channels);
+
+    if(mse <= 0)
+        return INFINITY;
+
+    return 10.0 * std::log10((255.0 * 255.0) / mse);
+}
@@ -0,0 +1,186 @@
+#include <Unified-Engine/Core/Rendering/texturePack.h>
+#include <Unified-Engine/debug.h>
+#include <filesystem>
+#include <algorithm>
+
+using namespace UnifiedEngine;
+
+static_assert(TEXTURE_PACK_PAGE_SIZE == ATLAS_PAGE_SIZE, "Cooked pages must be atlas pages");
+
+std::vector<TexturePack*> UnifiedEngine::__GLOBAL_TEXTURE_PACKS = {};
+
+TexturePack::TexturePack(){
+
+}
+TexturePack::~TexturePack(){
+    this->File.Close();
+}
+
+int TexturePack::Open(std::string FilePath, std::string Root){
+    if(this->File.Open(FilePath)){
+        return -1;
+    }
+
+    const uint8_t* bytes = this->File.Bytes();
+    size_t length = this->File.Length();
+
+    if(length < sizeof(TexturePackHeader)){
+        FAULT("TEXTURE PACK TOO SMALL: ", FilePath.c_str());
+        this->File.Close();
+        return -1;
+    }
+
+    const TexturePackHeader* header = (const TexturePackHeader*)bytes;
+
+    if(header->Magic != TEXTURE_PACK_MAGIC || header->Version != TEXTURE_PACK_VERSION){
+        FAULT("TEXTURE PACK VERSION MISMATCH, RE-COOK: ", FilePath.c_str());
+        this->File.Close();
+        return -1;
+    }
+
+    //Everything has to be inside the file before anything points into it
+    bool valid = header->PageSize == TEXTURE_PACK_PAGE_SIZE
+        && header->MipCount > 0 && (header->PageSize >> (header->MipCount - 1)) > 0
+        && header->PageStride >= TexturePackMipOffset(header->PageSize, header->MipCount)
+        && header->EntryOffset + ((uint64_t)header->EntryCount * sizeof(TexturePackEntry)) <= header->StringOffset
+        && header->StringOffset <= header->PageOffset
+        && header->PageOffset + ((uint64_t)header->PageCount * header->PageStride) <= length;
+
+    if(!valid){
+        FAULT("TEXTURE PACK IS CORRUPT: ", FilePath.c_str());
+        this->File.Close();
+        return -1;
+    }
+
+    this->Header = header;
+    this->Entries = (const TexturePackEntry*)(bytes + header->EntryOffset);
+    this->AtlasPages.assign(header->PageCount, -1);
+    this->AtlasGenerations.assign(header->PageCount, 0);
+
+    if(Root.empty())
+        Root = std::filesystem::path(FilePath).parent_path().string();
+
+    uint64_t stringsLength = header->PageOffset - header->StringOffset;
+    const char* strings = (const char*)(bytes + header->StringOffset);
+
+    for(uint32_t i = 0; i < header->EntryCount; i++){
+        const TexturePackEntry& entry = this->Entries[i];
+
+        if((uint64_t)entry.PathOffset + entry.PathLength > stringsLength || entry.Page >= header->PageCount
+            || entry.x + entry.w > header->PageSize || entry.y + entry.h > header->PageSize){
+            WARN("SKIPPING CORRUPT TEXTURE PACK ENTRY: ", i);
+            continue;
+        }
+
+        std::string path(strings + entry.PathOffset, entry.PathLength);
+        this->Lookup[GetFullPath((std::filesystem::path(Root) / path).string())] = i;
+    }
+
+    return 0;
+}
+
+int TexturePack::UploadPage(uint32_t Page){
+    int atlasPage = __GLOBAL_ATLAS->AddPage();
+
+    if(atlasPage < 0){
+        return -1;
+    }
+
+    //Cooked pages are already laid out, nothing else may be placed on them
+    __GLOBAL_ATLAS->SpaceIdentifiers[atlasPage].clear();
+    __GLOBAL_ATLAS->PageLocked[atlasPage] = 1;
+
+    const uint8_t* page = this->File.Bytes() + this->Header->PageOffset + ((uint64_t)Page * this->Header->PageStride);
+
+    for(uint32_t level = 0; level < this->Header->MipCount; level++){
+        __GLOBAL_ATLAS->UploadLevel(atlasPage, level, page + TexturePackMipOffset(this->Header->PageSize, level));
+    }
+
+    this->AtlasPages[Page] = atlasPage;
+    this->AtlasGenerations[Page] = __GLOBAL_ATLAS->PageGenerations[atlasPage];
+
+    return 0;
+}
+
+bool TexturePack::PageResident(uint32_t Page){
+    int atlasPage = this->AtlasPages[Page];
+
+    //The atlas hands emptied pages out again, after which this one has to be uploaded afresh
+    return atlasPage >= 0 && __GLOBAL_ATLAS->PageGenerations[atlasPage] == this->AtlasGenerations[Page];
+}
+
+Texture2D* TexturePack::Load(const std::string& FullPath){
+    if(!this->Contains(FullPath)){
+        return nullptr;
+    }
+
+    Texture2D* texture = new Texture2D();
+
+    if(this->Load(FullPath, texture)){
+        delete texture;
+        return nullptr;
+    }
+
+    return texture;
+}
+
+int TexturePack::Load(const std::string& FullPath, Texture2D* Into){
+    auto found = this->Lookup.find(FullPath);
+
+    if(found == this->Lookup.end()){
+        return -1;
+    }
+
+    if(!__GLOBAL_ATLAS){
+        FAULT("ERROR NO ATLAS");
+        return -1;
+    }
+
+    const TexturePackEntry& entry = this->Entries[found->second];
+
+    if(!this->PageResident(entry.Page) && this->UploadPage(entry.Page)){
+        return -1;
+    }
+
+    Into->FilePath = FullPath;
+    Into->width = entry.w;
+    Into->height = entry.h;
+
+    __GLOBAL_ATLAS->PlaceImageAt(Into, this->AtlasPages[entry.Page], glm::ivec2(entry.x, entry.y));
+
+    //UVs come from the cooked table
+    for(int i = 0; i < 4; i++){
+        Into->UVs.UV[i] = glm::vec2(entry.UV[i * 2], entry.UV[(i * 2) + 1]);
+    }
+
+    Into->State = TEXTURE_READY;
+
+    return 0;
+}
+
+bool TexturePack::Contains(const std::string& FullPath){
+    return this->Lookup.find(FullPath) != this->Lookup.end();
+}
+
+TexturePack* UnifiedEngine::MountTexturePack(std::string FilePath, std::string Root){
+    TexturePack* pack = new TexturePack();
+
+    if(pack->Open(FilePath, Root)){
+        delete pack;
+        return nullptr;
+    }
+
+    __GLOBAL_TEXTURE_PACKS.push_back(pack);
+
+    return pack;
+}
+
+Texture2D* UnifiedEngine::FindPackedTexture(const std::string& FullPath){
+    for (auto i = __GLOBAL_TEXTURE_PACKS.begin(); i != __GLOBAL_TEXTURE_PACKS.end(); i++){
+        if((*i)->Contains(FullPath)){
+            return (*i)->Load(FullPath);
+        }
+    }
+
+    return nullptr;
+}
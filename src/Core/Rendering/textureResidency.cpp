@@ -0,0 +1,171 @@
+#include <Unified-Engine/Core/Rendering/textureResidency.h>
+#include <Unified-Engine/Core/Rendering/textureStreamer.h>
+#include <Unified-Engine/Core/Rendering/texturePack.h>
+#include <Unified-Engine/debug.h>
+#include <SOIL2/SOIL2.h>
+#include <algorithm>
+#include <vector>
+
+using namespace UnifiedEngine;
+
+TextureResidency* UnifiedEngine::__GLOBAL_TEXTURE_RESIDENCY = nullptr;
+
+TextureResidency::TextureResidency(size_t Budget, unsigned EvictionFrames)
+    : Budget(Budget), EvictionFrames(EvictionFrames)
+{
+
+}
+TextureResidency::~TextureResidency(){
+    for (auto i = this->Textures.begin(); i != this->Textures.end(); i++){
+        (*i)->Resident = false;
+    }
+}
+
+int TextureResidency::Track(Texture2D* texture){
+    if(texture->Resident){
+        this->Untrack(texture);
+    }
+
+    texture->LastUsed = this->Frame;
+    texture->Resident = true;
+
+    this->Textures.push_front(texture);
+    texture->ResidencyEntry = this->Textures.begin();
+
+    return 0;
+}
+
+int TextureResidency::Untrack(Texture2D* texture){
+    if(!texture->Resident){
+        return 0;
+    }
+
+    this->Textures.erase(texture->ResidencyEntry);
+    texture->Resident = false;
+
+    return 0;
+}
+
+int TextureResidency::Touch(Texture2D* texture){
+    if(!texture->Resident){
+        return 0;
+    }
+
+    texture->LastUsed = this->Frame;
+
+    return 0;
+}
+
+int TextureResidency::Evict(Texture2D* texture){
+    if(!texture->Resident || texture->State != TEXTURE_READY){
+        return -1;
+    }
+
+    if(texture->Pinned || texture->FilePath.empty()){
+        FAULT("TEXTURE CAN NOT BE EVICTED, IT HAS NO SOURCE");
+        return -1;
+    }
+
+    this->Untrack(texture);
+    __GLOBAL_ATLAS->FreeSpace(texture);
+
+    texture->State = TEXTURE_EVICTED;
+
+    //Anything still drawing it sees the placeholder rather than whatever takes its space
+    if(__GLOBAL_TEXTURE_STREAMER){
+        __GLOBAL_TEXTURE_STREAMER->ShowPlaceholder(texture);
+    }
+    else{
+        texture->TextureID = 0;
+        texture->Page = -1;
+    }
+
+    this->Evictions++;
+
+    return 0;
+}
+
+int TextureResidency::Restore(Texture2D* texture){
+    if(texture->State != TEXTURE_EVICTED){
+        return 0;
+    }
+
+    this->Restores++;
+
+    //Cooked data is already laid out so it goes straight back
+    for (auto i = __GLOBAL_TEXTURE_PACKS.begin(); i != __GLOBAL_TEXTURE_PACKS.end(); i++){
+        if((*i)->Contains(texture->FilePath)){
+            return (*i)->Load(texture->FilePath, texture);
+        }
+    }
+
+    if(__GLOBAL_TEXTURE_STREAMER){
+        return __GLOBAL_TEXTURE_STREAMER->Reload(texture);
+    }
+
+    texture->Data = SOIL_load_image(texture->FilePath.c_str(), &texture->width, &texture->height, NULL, SOIL_LOAD_RGBA);
+
+    if(!texture->Data){
+        FAULT("COULD NOT AQUIRE DATA: ", texture->FilePath.c_str());
+        texture->State = TEXTURE_FAILED;
+        return -1;
+    }
+
+    int result = __GLOBAL_ATLAS->AddImage(texture);
+
+    SOIL_free_image_data(texture->Data);
+    texture->Data = nullptr;
+
+    return result;
+}
+
+bool TextureResidency::Evictable(Texture2D* texture){
+    return texture->Resident && !texture->Pinned && !texture->FilePath.empty() && texture->State == TEXTURE_READY && this->Frame - texture->LastUsed >= this->EvictionFrames;
+}
+
+int TextureResidency::Update(){
+    this->Frame++;
+
+    this->ResidentBytes = __GLOBAL_ATLAS->PageBytes();
+
+    if(!this->Budget || this->ResidentBytes <= this->Budget || !__GLOBAL_ATLAS->ReleasesPages()){
+        return 0;
+    }
+
+    //Pages every texture on may go, by when the newest of them was last bound
+    std::vector<std::pair<uint64_t, int>> pages;
+    for(size_t page = 0; page < __GLOBAL_ATLAS->Texture2DIdentifiers.size(); page++){
+        const std::list<Atlas_Texture_Identifier>& textures = __GLOBAL_ATLAS->Texture2DIdentifiers[page];
+        if(textures.empty())
+            continue;
+
+        uint64_t newest = 0;
+        bool evictable = true;
+        for(auto i = textures.begin(); i != textures.end() && evictable; i++){
+            newest = std::max(newest, (*i).Texture->LastUsed);
+            evictable = this->Evictable((*i).Texture);
+        }
+
+        if(evictable)
+            pages.push_back({newest, (int)page});
+    }
+
+    std::sort(pages.begin(), pages.end());
+
+    for(auto i = pages.begin(); i != pages.end() && this->ResidentBytes > this->Budget; i++){
+        //Eviction erases from the page's list
+        std::vector<Texture2D*> textures;
+        const std::list<Atlas_Texture_Identifier>& page = __GLOBAL_ATLAS->Texture2DIdentifiers[(*i).second];
+        for(auto j = page.begin(); j != page.end(); j++){
+            textures.push_back((*j).Texture);
+        }
+
+        for(auto j = textures.begin(); j != textures.end(); j++){
+            this->Evict(*j);
+        }
+
+        this->ResidentBytes = __GLOBAL_ATLAS->PageBytes();
+    }
+
+    return 0;
+}
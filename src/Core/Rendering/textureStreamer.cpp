@@ -0,0 +1,325 @@
+#include <Unified-Engine/Core/Rendering/textureStreamer.h>
+#include <Unified-Engine/Core/Rendering/texturePack.h>
+#include <Unified-Engine/Core/threadPool.h>
+#include <Unified-Engine/debug.h>
+#include <SOIL2/SOIL2.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace UnifiedEngine;
+
+TextureStreamer* UnifiedEngine::__GLOBAL_TEXTURE_STREAMER = nullptr;
+
+TextureStreamer::TextureStreamer(size_t UploadBudget)
+    : UploadBudget(UploadBudget)
+{
+    if(!__GLOBAL_ATLAS){
+        FAULT("ERROR NO ATLAS");
+    }
+    else{
+        //Magenta checker so anything still streaming is obvious
+        uint8_t checker[4 * 4 * 4];
+        for(int y = 0; y < 4; y++){
+            for(int x = 0; x < 4; x++){
+                uint8_t* pixel = checker + ((y * 4) + x) * 4;
+                bool odd = ((x / 2) + (y / 2)) % 2;
+
+                pixel[0] = 255;
+                pixel[1] = odd ? 0 : 255;
+                pixel[2] = 255;
+                pixel[3] = 255;
+            }
+        }
+
+        this->Placeholder = new Texture2D(checker, 4, 4);
+    }
+
+    //One segment per frame in flight, written to while the GPU reads the others
+    this->SegmentSize = UploadBudget;
+
+    if(GLAD_GL_VERSION_4_4){
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glGenBuffers(1, &this->PBO);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, this->PBO);
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, this->SegmentSize * 3, nullptr, flags);
+        this->Mapped = (uint8_t*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, this->SegmentSize * 3, flags);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if(!this->Mapped){
+            WARN("COULD NOT MAP TEXTURE UPLOAD BUFFER, UPLOADING DIRECTLY");
+            glDeleteBuffers(1, &this->PBO);
+            this->PBO = 0;
+        }
+    }
+}
+TextureStreamer::~TextureStreamer(){
+    //Workers hold a pointer to us
+    if(__GLOBAL_THREAD_POOL)
+        __GLOBAL_THREAD_POOL->Wait();
+
+    //Gives its space back, so it has to go while the atlas is still around
+    delete this->Placeholder;
+    this->Placeholder = nullptr;
+
+    for (auto i = this->Ready.begin(); i != this->Ready.end(); i++){
+        if((*i).Data)
+            SOIL_free_image_data((*i).Data);
+    }
+
+    for(int i = 0; i < 3; i++){
+        if(this->SegmentFences[i])
+            glDeleteSync(this->SegmentFences[i]);
+    }
+
+    if(this->PBO){
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, this->PBO);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glDeleteBuffers(1, &this->PBO);
+    }
+}
+
+int TextureStreamer::Upload(TextureStreamRequest Request){
+    Texture2D* texture = Request.Texture;
+
+    this->InFlight.erase(texture->FilePath);
+
+    if(!Request.Data){
+        FAULT("COULD NOT AQUIRE DATA: ", texture->FilePath.c_str());
+        texture->State = TEXTURE_FAILED;
+        return -1;
+    }
+
+    texture->Data = Request.Data;
+    texture->width = Request.width;
+    texture->height = Request.height;
+
+    //Keep showing the placeholder if it will not fit
+    Atlas_Image_Location location = {};
+    if(__GLOBAL_ATLAS->PlaceImage(texture, location)){
+        SOIL_free_image_data(Request.Data);
+        texture->Data = nullptr;
+        texture->State = TEXTURE_FAILED;
+        return -1;
+    }
+
+    size_t bytes = (size_t)Request.width * Request.height * 4;
+
+    //Compressed/CPU mipped atlases copy into their page on the CPU so the buffer is skipped
+    if(this->Mapped && !__GLOBAL_ATLAS->UsesShadow() && this->SegmentUsed + bytes <= this->SegmentSize){
+        size_t offset = (this->Segment * this->SegmentSize) + this->SegmentUsed;
+
+        std::memcpy(this->Mapped + offset, Request.Data, bytes);
+        this->SegmentUsed += bytes;
+
+        //Data pointer becomes an offset into the bound buffer
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, this->PBO);
+        __GLOBAL_ATLAS->CopyImageData(location.Dest, location.index, (uint8_t*)(uintptr_t)offset, location.pos, glm::ivec2(Request.width, Request.height));
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    else{
+        //Too big for a segment (Or no mapped buffer/shadowed atlas), upload from client memory
+        __GLOBAL_ATLAS->CopyImageData(location.Dest, location.index, Request.Data, location.pos, glm::ivec2(Request.width, Request.height));
+    }
+
+    SOIL_free_image_data(Request.Data);
+    texture->Data = nullptr;
+    texture->State = TEXTURE_READY;
+
+    return 0;
+}
+
+Texture2D* TextureStreamer::Request(std::string FilePath){
+    std::string fullPath = GetFullPath(FilePath);
+
+    if(Texture2D* texture = __GLOBAL_ATLAS->CheckExists(fullPath); texture){
+        return texture;
+    }
+    if(Texture2D* texture = FindPackedTexture(fullPath); texture){
+        return texture;
+    }
+    if(Texture2D* texture = this->CheckInFlight(fullPath); texture){
+        return texture;
+    }
+
+    Texture2D* texture = new Texture2D();
+    texture->FilePath = fullPath;
+
+    this->Decode(texture);
+
+    return texture;
+}
+
+int TextureStreamer::Reload(Texture2D* texture){
+    if(texture->FilePath.empty()){
+        FAULT("TEXTURE HAS NO FILE TO RELOAD");
+        return -1;
+    }
+
+    if(this->CheckInFlight(texture->FilePath)){
+        return 0;
+    }
+
+    return this->Decode(texture);
+}
+
+int TextureStreamer::ShowPlaceholder(Texture2D* texture){
+    if(!this->Placeholder){
+        texture->TextureID = 0;
+        texture->Page = -1;
+        return -1;
+    }
+
+    texture->UVs = this->Placeholder->UVs;
+    texture->TextureID = this->Placeholder->TextureID;
+    texture->Page = this->Placeholder->Page;
+    texture->Layer = this->Placeholder->Layer;
+    texture->Unit = this->Placeholder->Unit;
+
+    return 0;
+}
+
+int TextureStreamer::Decode(Texture2D* texture){
+    std::string fullPath = texture->FilePath;
+
+    texture->State = TEXTURE_PENDING;
+    this->ShowPlaceholder(texture);
+
+    this->InFlight[fullPath] = texture;
+
+    auto decode = [this, texture, fullPath](){
+        TextureStreamRequest request = {};
+        request.Texture = texture;
+        request.Data = SOIL_load_image(fullPath.c_str(), &request.width, &request.height, NULL, SOIL_LOAD_RGBA);
+
+        {
+            std::lock_guard<std::mutex> lock(this->ReadyLock);
+            this->Ready.push_back(request);
+        }
+        this->ReadySignal.notify_all();
+    };
+
+    //Without workers decode here, it is still uploaded on the next Update
+    if(__GLOBAL_THREAD_POOL)
+        __GLOBAL_THREAD_POOL->Submit(decode);
+    else
+        decode();
+
+    return 0;
+}
+
+int TextureStreamer::Cancel(Texture2D* texture){
+    auto found = this->InFlight.find(texture->FilePath);
+    if(found == this->InFlight.end() || found->second != texture)
+        return 0;
+
+    this->InFlight.erase(found);
+
+    //Its decode may still be running, wait for it so nothing is left holding the texture
+    TextureStreamRequest request = {};
+
+    {
+        std::unique_lock<std::mutex> lock(this->ReadyLock);
+
+        auto IsTexture = [texture](const TextureStreamRequest& r){return r.Texture == texture;};
+        this->ReadySignal.wait(lock, [&]{return std::find_if(this->Ready.begin(), this->Ready.end(), IsTexture) != this->Ready.end();});
+
+        auto queued = std::find_if(this->Ready.begin(), this->Ready.end(), IsTexture);
+        request = *queued;
+        this->Ready.erase(queued);
+    }
+
+    if(request.Data)
+        SOIL_free_image_data(request.Data);
+
+    return 0;
+}
+
+Texture2D* TextureStreamer::CheckInFlight(std::string FilePath){
+    auto found = this->InFlight.find(FilePath);
+
+    if(found == this->InFlight.end())
+        return nullptr;
+
+    return found->second;
+}
+
+int TextureStreamer::Update(){
+    //Wait for the GPU to finish reading this segment before it is written again
+    if(this->Mapped && this->SegmentFences[this->Segment]){
+        while(glClientWaitSync(this->SegmentFences[this->Segment], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED);
+
+        glDeleteSync(this->SegmentFences[this->Segment]);
+        this->SegmentFences[this->Segment] = 0;
+    }
+    this->SegmentUsed = 0;
+
+    size_t uploaded = 0;
+
+    while(true){
+        TextureStreamRequest request = {};
+
+        {
+            std::lock_guard<std::mutex> lock(this->ReadyLock);
+
+            if(this->Ready.empty())
+                break;
+
+            size_t bytes = (size_t)this->Ready.front().width * this->Ready.front().height * 4;
+            if(uploaded && uploaded + bytes > this->UploadBudget)
+                break;
+
+            request = this->Ready.front();
+            this->Ready.pop_front();
+        }
+
+        uploaded += (size_t)request.width * request.height * 4;
+        this->Upload(request);
+    }
+
+    if(this->Mapped && this->SegmentUsed){
+        this->SegmentFences[this->Segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        this->Segment = (this->Segment + 1) % 3;
+    }
+
+    //Nothing else may write into the next segment until its fence has been waited on
+    this->SegmentUsed = this->SegmentSize;
+
+    return 0;
+}
+
+int TextureStreamer::Finish(Texture2D* texture){
+    if(texture->State != TEXTURE_PENDING){
+        return 0;
+    }
+
+    if(!this->CheckInFlight(texture->FilePath)){
+        FAULT("TEXTURE IS NOT STREAMING: ", texture->FilePath.c_str());
+        return -1;
+    }
+
+    TextureStreamRequest request = {};
+
+    {
+        std::unique_lock<std::mutex> lock(this->ReadyLock);
+
+        auto IsTexture = [texture](const TextureStreamRequest& r){return r.Texture == texture;};
+        this->ReadySignal.wait(lock, [&]{return std::find_if(this->Ready.begin(), this->Ready.end(), IsTexture) != this->Ready.end();});
+
+        auto found = std::find_if(this->Ready.begin(), this->Ready.end(), IsTexture);
+        request = *found;
+        this->Ready.erase(found);
+    }
+
+    return this->Upload(request);
+}
+
+Texture2D* UnifiedEngine::LoadTextureAsync(std::string FilePath){
+    if(!__GLOBAL_TEXTURE_STREAMER){
+        WARN("NO TEXTURE STREAMER, LOADING SYNCHRONOUSLY");
+        return LoadTexture(FilePath);
+    }
+
+    return __GLOBAL_TEXTURE_STREAMER->Request(FilePath);
+}
@@ -0,0 +1,457 @@
+#include <Unified-Engine/Core/Spatial/aabbBatch.h>
+#include <Unified-Engine/Utility/simd.h>
+#include <Unified-Engine/debug.h>
+
+using namespace UnifiedEngine;
+
+namespace {
+    struct BoxArrays{
+        const float* MinX;
+        const float* MinY;
+        const float* MinZ;
+        const float* MaxX;
+        const float* MaxY;
+        const float* MaxZ;
+    };
+
+    //Appends Base + each set bit of Mask
+    inline size_t EmitHits(uint32_t Mask, int Lanes, size_t Base, uint32_t* Hits){
+        size_t count = 0;
+
+        for(int lane = 0; lane < Lanes; lane++){
+            if(Mask & (1u << lane))
+                Hits[count++] = (uint32_t)(Base + lane);
+        }
+
+        return count;
+    }
+
+    // ---------------------------------------------------------------- Scalar
+
+    size_t OverlapsScalar(const BoxArrays& Boxes, const AABB& Query, size_t Begin, size_t End, uint32_t* Hits){
+        size_t count = 0;
+
+        for(size_t i = Begin; i < End; i++){
+            if(Boxes.MinX[i] <= Query.max.x && Boxes.MaxX[i] >= Query.min.x &&
+               Boxes.MinY[i] <= Query.max.y && Boxes.MaxY[i] >= Query.min.y &&
+               Boxes.MinZ[i] <= Query.max.z && Boxes.MaxZ[i] >= Query.min.z)
+                Hits[count++] = (uint32_t)i;
+        }
+
+        return count;
+    }
+
+    size_t RayHitsScalar(const BoxArrays& Boxes, const glm::vec3& Origin, const glm::vec3& Inverse, float MaxDistance, size_t Begin, size_t End, uint32_t* Hits, float* Distances){
+        size_t count = 0;
+
+        for(size_t i = Begin; i < End; i++){
+            AABB box;
+            box.min = glm::vec3(Boxes.MinX[i], Boxes.MinY[i], Boxes.MinZ[i]);
+            box.max = glm::vec3(Boxes.MaxX[i], Boxes.MaxY[i], Boxes.MaxZ[i]);
+
+            float distance;
+            if(box.intersectsRay(Origin, Inverse, MaxDistance, distance)){
+                Distances[count] = distance;
+                Hits[count++] = (uint32_t)i;
+            }
+        }
+
+        return count;
+    }
+
+    size_t VisibleScalar(const BoxArrays& Boxes, const Frustum& frustum, size_t Begin, size_t End, uint32_t* Hits){
+        size_t count = 0;
+
+        for(size_t i = Begin; i < End; i++){
+            AABB box;
+            box.min = glm::vec3(Boxes.MinX[i], Boxes.MinY[i], Boxes.MinZ[i]);
+            box.max = glm::vec3(Boxes.MaxX[i], Boxes.MaxY[i], Boxes.MaxZ[i]);
+
+            if(frustum.Intersects(box))
+                Hits[count++] = (uint32_t)i;
+        }
+
+        return count;
+    }
+
+#if defined(UE_SIMD_SSE2)
+    // ---------------------------------------------------------------- SSE2
+
+    size_t OverlapsSSE2(const BoxArrays& Boxes, const AABB& Query, size_t Begin, size_t End, uint32_t* Hits){
+        __m128 queryMinX = _mm_set1_ps(Query.min.x), queryMinY = _mm_set1_ps(Query.min.y), queryMinZ = _mm_set1_ps(Query.min.z);
+        __m128 queryMaxX = _mm_set1_ps(Query.max.x), queryMaxY = _mm_set1_ps(Query.max.y), queryMaxZ = _mm_set1_ps(Query.max.z);
+
+        size_t count = 0;
+        size_t i = Begin;
+
+        for(; i + 4 <= End; i += 4){
+            __m128 x = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(Boxes.MinX + i), queryMaxX), _mm_cmpge_ps(_mm_loadu_ps(Boxes.MaxX + i), queryMinX));
+            __m128 y = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(Boxes.MinY + i), queryMaxY), _mm_cmpge_ps(_mm_loadu_ps(Boxes.MaxY + i), queryMinY));
+            __m128 z = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(Boxes.MinZ + i), queryMaxZ), _mm_cmpge_ps(_mm_loadu_ps(Boxes.MaxZ + i), queryMinZ));
+
+            count += EmitHits(_mm_movemask_ps(_mm_and_ps(x, _mm_and_ps(y, z))), 4, i, Hits + count);
+        }
+
+        return count + OverlapsScalar(Boxes, Query, i, End, Hits + count);
+    }
+
+    //min/max return their second operand on NaN, which is exactly the scalar test's ternaries
+    size_t RayHitsSSE2(const BoxArrays& Boxes, const glm::vec3& Origin, const glm::vec3& Inverse, float MaxDistance, size_t Begin, size_t End, uint32_t* Hits, float* Distances){
+        const float* mins[3] = {Boxes.MinX, Boxes.MinY, Boxes.MinZ};
+        const float* maxs[3] = {Boxes.MaxX, Boxes.MaxY, Boxes.MaxZ};
+
+        size_t count = 0;
+        size_t i = Begin;
+
+        for(; i + 4 <= End; i += 4){
+            __m128 enter = _mm_setzero_ps();
+            __m128 exit = _mm_set1_ps(MaxDistance);
+
+            for(int axis = 0; axis < 3; axis++){
+                __m128 origin = _mm_set1_ps(Origin[axis]);
+                __m128 inverse = _mm_set1_ps(Inverse[axis]);
+
+                __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(mins[axis] + i), origin), inverse);
+                __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxs[axis] + i), origin), inverse);
+
+                enter = _mm_max_ps(_mm_min_ps(t1, t0), enter);
+                exit = _mm_min_ps(_mm_max_ps(t0, t1), exit);
+            }
+
+            int mask = _mm_movemask_ps(_mm_cmple_ps(enter, exit));
+            if(!mask)
+                continue;
+
+            float distances[4];
+            _mm_storeu_ps(distances, enter);
+
+            for(int lane = 0; lane < 4; lane++){
+                if(mask & (1 << lane)){
+                    Distances[count] = distances[lane];
+                    Hits[count++] = (uint32_t)(i + lane);
+                }
+            }
+        }
+
+        return count + RayHitsScalar(Boxes, Origin, Inverse, MaxDistance, i, End, Hits + count, Distances + count);
+    }
+
+    size_t VisibleSSE2(const BoxArrays& Boxes, const Frustum& frustum, size_t Begin, size_t End, uint32_t* Hits){
+        size_t count = 0;
+        size_t i = Begin;
+
+        for(; i + 4 <= End; i += 4){
+            __m128 outside = _mm_setzero_ps();
+
+            for(int p = 0; p < 6; p++){
+                const glm::vec4& plane = frustum.Planes[p];
+
+                //Corner furthest along the plane normal
+                __m128 x = _mm_loadu_ps((plane.x >= 0.f ? Boxes.MaxX : Boxes.MinX) + i);
+                __m128 y = _mm_loadu_ps((plane.y >= 0.f ? Boxes.MaxY : Boxes.MinY) + i);
+                __m128 z = _mm_loadu_ps((plane.z >= 0.f ? Boxes.MaxZ : Boxes.MinZ) + i);
+
+                __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), x), _mm_mul_ps(_mm_set1_ps(plane.y), y)), _mm_mul_ps(_mm_set1_ps(plane.z), z)), _mm_set1_ps(plane.w));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_setzero_ps()));
+            }
+
+            count += EmitHits(~_mm_movemask_ps(outside) & 0xF, 4, i, Hits + count);
+        }
+
+        return count + VisibleScalar(Boxes, frustum, i, End, Hits + count);
+    }
+
+    // ---------------------------------------------------------------- AVX2
+
+    UE_TARGET_AVX2 size_t OverlapsAVX2(const BoxArrays& Boxes, const AABB& Query, size_t Begin, size_t End, uint32_t* Hits){
+        __m256 queryMinX = _mm256_set1_ps(Query.min.x), queryMinY = _mm256_set1_ps(Query.min.y), queryMinZ = _mm256_set1_ps(Query.min.z);
+        __m256 queryMaxX = _mm256_set1_ps(Query.max.x), queryMaxY = _mm256_set1_ps(Query.max.y), queryMaxZ = _mm256_set1_ps(Query.max.z);
+
+        size_t count = 0;
+        size_t i = Begin;
+
+        for(; i + 8 <= End; i += 8){
+            __m256 x = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(Boxes.MinX + i), queryMaxX, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(Boxes.MaxX + i), queryMinX, _CMP_GE_OQ));
+            __m256 y = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(Boxes.MinY + i), queryMaxY, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(Boxes.MaxY + i), queryMinY, _CMP_GE_OQ));
+            __m256 z = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(Boxes.MinZ + i), queryMaxZ, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(Boxes.MaxZ + i), queryMinZ, _CMP_GE_OQ));
+
+            count += EmitHits(_mm256_movemask_ps(_mm256_and_ps(x, _mm256_and_ps(y, z))), 8, i, Hits + count);
+        }
+
+        return count + OverlapsSSE2(Boxes, Query, i, End, Hits + count);
+    }
+
+    UE_TARGET_AVX2 size_t RayHitsAVX2(const BoxArrays& Boxes, const glm::vec3& Origin, const glm::vec3& Inverse, float MaxDistance, size_t Begin, size_t End, uint32_t* Hits, float* Distances){
+        const float* mins[3] = {Boxes.MinX, Boxes.MinY, Boxes.MinZ};
+        const float* maxs[3] = {Boxes.MaxX, Boxes.MaxY, Boxes.MaxZ};
+
+        size_t count = 0;
+        size_t i = Begin;
+
+        for(; i + 8 <= End; i += 8){
+            __m256 enter = _mm256_setzero_ps();
+            __m256 exit = _mm256_set1_ps(MaxDistance);
+
+            for(int axis = 0; axis < 3; axis++){
+                __m256 origin = _mm256_set1_ps(Origin[axis]);
+                __m256 inverse = _mm256_set1_ps(Inverse[axis]);
+
+                __m256 t0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(mins[axis] + i), origin), inverse);
+                __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(maxs[axis] + i), origin), inverse);
+
+                enter = _mm256_max_ps(_mm256_min_ps(t1, t0), enter);
+                exit = _mm256_min_ps(_mm256_max_ps(t0, t1), exit);
+            }
+
+            int mask = _mm256_movemask_ps(_mm256_cmp_ps(enter, exit, _CMP_LE_OQ));
+            if(!mask)
+                continue;
+
+            float distances[8];
+            _mm256_storeu_ps(distances, enter);
+
+            for(int lane = 0; lane < 8; lane++){
+                if(mask & (1 << lane)){
+                    Distances[count] = distances[lane];
+                    Hits[count++] = (uint32_t)(i + lane);
+                }
+            }
+        }
+
+        return count + RayHitsSSE2(Boxes, Origin, Inverse, MaxDistance, i, End, Hits + count, Distances + count);
+    }
+
+    UE_TARGET_AVX2 size_t VisibleAVX2(const BoxArrays& Boxes, const Frustum& frustum, size_t Begin, size_t End, uint32_t* Hits){
+        size_t count = 0;
+        size_t i = Begin;
+
+        for(; i + 8 <= End; i += 8){
+            __m256 outside = _mm256_setzero_ps();
+
+            for(int p = 0; p < 6; p++){
+                const glm::vec4& plane = frustum.Planes[p];
+
+                __m256 x = _mm256_loadu_ps((plane.x >= 0.f ? Boxes.MaxX : Boxes.MinX) + i);
+                __m256 y = _mm256_loadu_ps((plane.y >= 0.f ? Boxes.MaxY : Boxes.MinY) + i);
+                __m256 z = _mm256_loadu_ps((plane.z >= 0.f ? Boxes.MaxZ : Boxes.MinZ) + i);
+
+                __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), x), _mm256_mul_ps(_mm256_set1_ps(plane.y), y)), _mm256_mul_ps(_mm256_set1_ps(plane.z), z)), _mm256_set1_ps(plane.w));
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_LT_OQ));
+            }
+
+            count += EmitHits(~_mm256_movemask_ps(outside) & 0xFF, 8, i, Hits + count);
+        }
+
+        return count + VisibleSSE2(Boxes, frustum, i, End, Hits + count);
+    }
+#endif
+
+#if defined(UE_SIMD_NEON)
+    // ---------------------------------------------------------------- NEON
+
+    inline uint32_t LaneMask(uint32x4_t Lanes){
+        return (vgetq_lane_u32(Lanes, 0) & 1) | (vgetq_lane_u32(Lanes, 1) & 2) | (vgetq_lane_u32(Lanes, 2) & 4) | (vgetq_lane_u32(Lanes, 3) & 8);
+    }
+
+    size_t OverlapsNEON(const BoxArrays& Boxes, const AABB& Query, size_t Begin, size_t End, uint32_t* Hits){
+        size_t count = 0;
+        size_t i = Begin;
+
+        for(; i + 4 <= End; i += 4){
+            uint32x4_t x = vandq_u32(vcleq_f32(vld1q_f32(Boxes.MinX + i), vdupq_n_f32(Query.max.x)), vcgeq_f32(vld1q_f32(Boxes.MaxX + i), vdupq_n_f32(Query.min.x)));
+            uint32x4_t y = vandq_u32(vcleq_f32(vld1q_f32(Boxes.MinY + i), vdupq_n_f32(Query.max.y)), vcgeq_f32(vld1q_f32(Boxes.MaxY + i), vdupq_n_f32(Query.min.y)));
+            uint32x4_t z = vandq_u32(vcleq_f32(vld1q_f32(Boxes.MinZ + i), vdupq_n_f32(Query.max.z)), vcgeq_f32(vld1q_f32(Boxes.MaxZ + i), vdupq_n_f32(Query.min.z)));
+
+            count += EmitHits(LaneMask(vandq_u32(x, vandq_u32(y, z))), 4, i, Hits + count);
+        }
+
+        return count + OverlapsScalar(Boxes, Query, i, End, Hits + count);
+    }
+
+    //NEON min/max pass NaN on, compares and selects keep the scalar test's ternaries
+    size_t RayHitsNEON(const BoxArrays& Boxes, const glm::vec3& Origin, const glm::vec3& Inverse, float MaxDistance, size_t Begin, size_t End, uint32_t* Hits, float* Distances){
+        const float* mins[3] = {Boxes.MinX, Boxes.MinY, Boxes.MinZ};
+        const float* maxs[3] = {Boxes.MaxX, Boxes.MaxY, Boxes.MaxZ};
+
+        size_t count = 0;
+        size_t i = Begin;
+
+        for(; i + 4 <= End; i += 4){
+            float32x4_t enter = vdupq_n_f32(0.f);
+            float32x4_t exit = vdupq_n_f32(MaxDistance);
+
+            for(int axis = 0; axis < 3; axis++){
+                float32x4_t origin = vdupq_n_f32(Origin[axis]);
+
+                float32x4_t t0 = vmulq_n_f32(vsubq_f32(vld1q_f32(mins[axis] + i), origin), Inverse[axis]);
+                float32x4_t t1 = vmulq_n_f32(vsubq_f32(vld1q_f32(maxs[axis] + i), origin), Inverse[axis]);
+
+                uint32x4_t swap = vcgtq_f32(t0, t1);
+                float32x4_t low = vbslq_f32(swap, t1, t0);
+                float32x4_t high = vbslq_f32(swap, t0, t1);
+
+                enter = vbslq_f32(vcgtq_f32(low, enter), low, enter);
+                exit = vbslq_f32(vcltq_f32(high, exit), high, exit);
+            }
+
+            uint32_t mask = LaneMask(vcleq_f32(enter, exit));
+            if(!mask)
+                continue;
+
+            float distances[4];
+            vst1q_f32(distances, enter);
+
+            for(int lane = 0; lane < 4; lane++){
+                if(mask & (1u << lane)){
+                    Distances[count] = distances[lane];
+                    Hits[count++] = (uint32_t)(i + lane);
+                }
+            }
+        }
+
+        return count + RayHitsScalar(Boxes, Origin, Inverse, MaxDistance, i, End, Hits + count, Distances + count);
+    }
+
+    size_t VisibleNEON(const BoxArrays& Boxes, const Frustum& frustum, size_t Begin, size_t End, uint32_t* Hits){
+        size_t count = 0;
+        size_t i = Begin;
+
+        for(; i + 4 <= End; i += 4){
+            uint32x4_t outside = vdupq_n_u32(0);
+
+            for(int p = 0; p < 6; p++){
+                const glm::vec4& plane = frustum.Planes[p];
+
+                float32x4_t x = vld1q_f32((plane.x >= 0.f ? Boxes.MaxX : Boxes.MinX) + i);
+                float32x4_t y = vld1q_f32((plane.y >= 0.f ? Boxes.MaxY : Boxes.MinY) + i);
+                float32x4_t z = vld1q_f32((plane.z >= 0.f ? Boxes.MaxZ : Boxes.MinZ) + i);
+
+                float32x4_t distance = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, plane.x), vmulq_n_f32(y, plane.y)), vmulq_n_f32(z, plane.z)), vdupq_n_f32(plane.w));
+                outside = vorrq_u32(outside, vcltq_f32(distance, vdupq_n_f32(0.f)));
+            }
+
+            count += EmitHits(~LaneMask(outside) & 0xF, 4, i, Hits + count);
+        }
+
+        return count + VisibleScalar(Boxes, frustum, i, End, Hits + count);
+    }
+#endif
+}
+
+AABBBatch::AABBBatch(){
+
+}
+AABBBatch::AABBBatch(const std::vector<AABB>& Boxes){
+    this->Reserve(Boxes.size());
+
+    for(auto i = Boxes.begin(); i != Boxes.end(); i++){
+        this->Add(*i);
+    }
+}
+AABBBatch::~AABBBatch(){
+
+}
+
+void AABBBatch::Clear(){
+    this->MinX.clear();
+    this->MinY.clear();
+    this->MinZ.clear();
+    this->MaxX.clear();
+    this->MaxY.clear();
+    this->MaxZ.clear();
+}
+
+void AABBBatch::Reserve(size_t Count){
+    this->MinX.reserve(Count);
+    this->MinY.reserve(Count);
+    this->MinZ.reserve(Count);
+    this->MaxX.reserve(Count);
+    this->MaxY.reserve(Count);
+    this->MaxZ.reserve(Count);
+}
+
+size_t AABBBatch::Add(const AABB& Box){
+    this->MinX.push_back(Box.min.x);
+    this->MinY.push_back(Box.min.y);
+    this->MinZ.push_back(Box.min.z);
+    this->MaxX.push_back(Box.max.x);
+    this->MaxY.push_back(Box.max.y);
+    this->MaxZ.push_back(Box.max.z);
+
+    return this->MinX.size() - 1;
+}
+
+void AABBBatch::Set(size_t Index, const AABB& Box){
+    this->MinX[Index] = Box.min.x;
+    this->MinY[Index] = Box.min.y;
+    this->MinZ[Index] = Box.min.z;
+    this->MaxX[Index] = Box.max.x;
+    this->MaxY[Index] = Box.max.y;
+    this->MaxZ[Index] = Box.max.z;
+}
+
+void AABBBatch::RemoveSwap(size_t Index){
+    if(Index >= this->Count()){
+        FAULT("NOT IN BATCH: ", Index);
+        return;
+    }
+
+    this->Set(Index, this->Get(this->Count() - 1));
+
+    this->MinX.pop_back();
+    this->MinY.pop_back();
+    this->MinZ.pop_back();
+    this->MaxX.pop_back();
+    this->MaxY.pop_back();
+    this->MaxZ.pop_back();
+}
+
+AABB AABBBatch::Get(size_t Index) const{
+    AABB box;
+    box.min = glm::vec3(this->MinX[Index], this->MinY[Index], this->MinZ[Index]);
+    box.max = glm::vec3(this->MaxX[Index], this->MaxY[Index], this->MaxZ[Index]);
+
+    return box;
+}
+
+size_t AABBBatch::Overlaps(const AABB& Query, size_t Begin, size_t End, uint32_t* Hits) const{
+    BoxArrays boxes = {this->MinX.data(), this->MinY.data(), this->MinZ.data(), this->MaxX.data(), this->MaxY.data(), this->MaxZ.data()};
+
+#if defined(UE_SIMD_SSE2)
+    if(CPUSupportsAVX2())
+        return OverlapsAVX2(boxes, Query, Begin, End, Hits);
+    return OverlapsSSE2(boxes, Query, Begin, End, Hits);
+#elif defined(UE_SIMD_NEON)
+    return OverlapsNEON(boxes, Query, Begin, End, Hits);
+#else
+    return OverlapsScalar(boxes, Query, Begin, End, Hits);
+#endif
+}
+
+size_t AABBBatch::RayHits(const glm::vec3& Origin, const glm::vec3& InverseDirection, float MaxDistance, size_t Begin, size_t End, uint32_t* Hits, float* Distances) const{
+    BoxArrays boxes = {this->MinX.data(), this->MinY.data(), this->MinZ.data(), this->MaxX.data(), this->MaxY.data(), this->MaxZ.data()};
+
+#if defined(UE_SIMD_SSE2)
+    if(CPUSupportsAVX2())
+        return RayHitsAVX2(boxes, Origin, InverseDirection, MaxDistance, Begin, End, Hits, Distances);
+    return RayHitsSSE2(boxes, Origin, InverseDirection, MaxDistance, Begin, End, Hits, Distances);
+#elif defined(UE_SIMD_NEON)
+    return RayHitsNEON(boxes, Origin, InverseDirection, MaxDistance, Begin, End, Hits, Distances);
+#else
+    return RayHitsScalar(boxes, Origin, InverseDirection, MaxDistance, Begin, End, Hits, Distances);
+#endif
+}
+
+size_t AABBBatch::Visible(const Frustum& frustum, size_t Begin, size_t End, uint32_t* Hits) const{
+    BoxArrays boxes = {this->MinX.data(), this->MinY.data(), this->MinZ.data(), this->MaxX.data(), this->MaxY.data(), this->MaxZ.data()};
+
+#if defined(UE_SIMD_SSE2)
+    if(CPUSupportsAVX2())
+        return VisibleAVX2(boxes, frustum, Begin, End, Hits);
+    return VisibleSSE2(boxes, frustum, Begin, End, Hits);
+#elif defined(UE_SIMD_NEON)
+    return VisibleNEON(boxes, frustum, Begin, End, Hits);
+#else
+    return VisibleScalar(boxes, frustum, Begin, End, Hits);
+#endif
+}
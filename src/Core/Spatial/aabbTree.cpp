@@ -0,0 +1,398 @@
+#include <Unified-Engine/Core/Spatial/aabbTree.h>
+#include <Unified-Engine/debug.h>
+#include <algorithm>
+#include <queue>
+#include <cmath>
+
+using namespace UnifiedEngine;
+
+AABBTree* UnifiedEngine::__GLOBAL_SCENE_TREE = nullptr;
+
+//A fat box grown past this many margins (From a fast move that stopped) is shrunk back on the next move
+constexpr float FAT_BOX_SHRINK = 4.f;
+
+static inline AABB Merged(const AABB& a, const AABB& b){
+    AABB box = a;
+    box.merge(b);
+    return box;
+}
+
+static inline float DistanceSquared(const AABB& box, const glm::vec3& point){
+    glm::vec3 closest = glm::clamp(point, box.min, box.max);
+    glm::vec3 d = closest - point;
+    return glm::dot(d, d);
+}
+
+AABBTree::AABBTree(float Margin, float Prediction)
+    : Margin(Margin), Prediction(Prediction)
+{
+
+}
+AABBTree::~AABBTree(){
+
+}
+
+int AABBTree::AllocateNode(){
+    if(this->FreeList == -1){
+        this->Nodes.push_back(AABBTreeNode{});
+        return (int)this->Nodes.size() - 1;
+    }
+
+    int node = this->FreeList;
+    this->FreeList = this->Nodes[node].Parent;
+    this->Nodes[node] = AABBTreeNode{};
+
+    return node;
+}
+
+void AABBTree::FreeNode(int Node){
+    this->Nodes[Node].Parent = this->FreeList;
+    this->Nodes[Node].Height = -1;
+    this->Nodes[Node].Data = nullptr;
+    this->FreeList = Node;
+}
+
+int AABBTree::CreateProxy(const AABB& Box, void* Data){
+    int proxy = this->AllocateNode();
+
+    AABBTreeNode& node = this->Nodes[proxy];
+    node.Box.min = Box.min - glm::vec3(this->Margin);
+    node.Box.max = Box.max + glm::vec3(this->Margin);
+    node.Data = Data;
+    node.Height = 0;
+
+    this->InsertLeaf(proxy);
+    this->Proxies++;
+
+    return proxy;
+}
+
+int AABBTree::DestroyProxy(int Proxy){
+    if(Proxy < 0 || Proxy >= (int)this->Nodes.size() || !this->Nodes[Proxy].IsLeaf() || this->Nodes[Proxy].Height != 0){
+        FAULT("NOT A PROXY: ", Proxy);
+        return -1;
+    }
+
+    this->RemoveLeaf(Proxy);
+    this->FreeNode(Proxy);
+    this->Proxies--;
+
+    return 0;
+}
+
+bool AABBTree::MoveProxy(int Proxy, const AABB& Box, const glm::vec3& Displacement){
+    const AABB& fat = this->Nodes[Proxy].Box;
+
+    if(fat.contains(Box)){
+        //Still inside, unless the fat box has got far too big for it
+        AABB huge = Box;
+        huge.min -= glm::vec3(FAT_BOX_SHRINK * this->Margin);
+        huge.max += glm::vec3(FAT_BOX_SHRINK * this->Margin);
+
+        if(huge.contains(fat))
+            return false;
+    }
+
+    this->RemoveLeaf(Proxy);
+
+    //Stretched ahead of the movement so the next few moves stay inside
+    AABB moved = Box;
+    moved.min -= glm::vec3(this->Margin);
+    moved.max += glm::vec3(this->Margin);
+
+    glm::vec3 ahead = Displacement * this->Prediction;
+    for(int i = 0; i < 3; i++){
+        if(ahead[i] < 0.f)
+            moved.min[i] += ahead[i];
+        else
+            moved.max[i] += ahead[i];
+    }
+
+    this->Nodes[Proxy].Box = moved;
+    this->InsertLeaf(Proxy);
+
+    return true;
+}
+
+void AABBTree::InsertLeaf(int Leaf){
+    if(this->Root == -1){
+        this->Root = Leaf;
+        this->Nodes[Leaf].Parent = -1;
+        return;
+    }
+
+    //Walk down to the sibling that adds the least area, including what every ancestor grows by
+    AABB leafBox = this->Nodes[Leaf].Box;
+    int index = this->Root;
+
+    while(!this->Nodes[index].IsLeaf()){
+        const AABBTreeNode& node = this->Nodes[index];
+
+        float area = node.Box.area();
+        float combinedArea = Merged(node.Box, leafBox).area();
+
+        //Making a new parent here
+        float cost = 2.f * combinedArea;
+        float inheritance = 2.f * (combinedArea - area);
+
+        auto Descend = [&](int Child){
+            const AABBTreeNode& child = this->Nodes[Child];
+            float merged = Merged(leafBox, child.Box).area();
+            return child.IsLeaf() ? merged + inheritance : (merged - child.Box.area()) + inheritance;
+        };
+
+        float cost1 = Descend(node.Child1);
+        float cost2 = Descend(node.Child2);
+
+        if(cost < cost1 && cost < cost2)
+            break;
+
+        index = (cost1 < cost2) ? node.Child1 : node.Child2;
+    }
+
+    int sibling = index;
+
+    int oldParent = this->Nodes[sibling].Parent;
+    int newParent = this->AllocateNode();
+
+    this->Nodes[newParent].Parent = oldParent;
+    this->Nodes[newParent].Box = Merged(leafBox, this->Nodes[sibling].Box);
+    this->Nodes[newParent].Height = this->Nodes[sibling].Height + 1;
+    this->Nodes[newParent].Child1 = sibling;
+    this->Nodes[newParent].Child2 = Leaf;
+
+    if(oldParent != -1){
+        if(this->Nodes[oldParent].Child1 == sibling)
+            this->Nodes[oldParent].Child1 = newParent;
+        else
+            this->Nodes[oldParent].Child2 = newParent;
+    }
+    else{
+        this->Root = newParent;
+    }
+
+    this->Nodes[sibling].Parent = newParent;
+    this->Nodes[Leaf].Parent = newParent;
+
+    //Refit and rotate back up to the root
+    index = this->Nodes[Leaf].Parent;
+    while(index != -1){
+        index = this->Balance(index);
+
+        AABBTreeNode& node = this->Nodes[index];
+        node.Height = 1 + std::max(this->Nodes[node.Child1].Height, this->Nodes[node.Child2].Height);
+        node.Box = Merged(this->Nodes[node.Child1].Box, this->Nodes[node.Child2].Box);
+
+        index = node.Parent;
+    }
+}
+
+void AABBTree::RemoveLeaf(int Leaf){
+    if(Leaf == this->Root){
+        this->Root = -1;
+        return;
+    }
+
+    int parent = this->Nodes[Leaf].Parent;
+    int grandParent = this->Nodes[parent].Parent;
+    int sibling = (this->Nodes[parent].Child1 == Leaf) ? this->Nodes[parent].Child2 : this->Nodes[parent].Child1;
+
+    if(grandParent == -1){
+        this->Root = sibling;
+        this->Nodes[sibling].Parent = -1;
+        this->FreeNode(parent);
+        return;
+    }
+
+    //The sibling takes the parent's place
+    if(this->Nodes[grandParent].Child1 == parent)
+        this->Nodes[grandParent].Child1 = sibling;
+    else
+        this->Nodes[grandParent].Child2 = sibling;
+
+    this->Nodes[sibling].Parent = grandParent;
+    this->FreeNode(parent);
+
+    int index = grandParent;
+    while(index != -1){
+        index = this->Balance(index);
+
+        AABBTreeNode& node = this->Nodes[index];
+        node.Box = Merged(this->Nodes[node.Child1].Box, this->Nodes[node.Child2].Box);
+        node.Height = 1 + std::max(this->Nodes[node.Child1].Height, this->Nodes[node.Child2].Height);
+
+        index = node.Parent;
+    }
+}
+
+//Rotates the taller child up when A's children differ in height by more than one, returns the new subtree root
+int AABBTree::Balance(int iA){
+    AABBTreeNode& A = this->Nodes[iA];
+    if(A.IsLeaf() || A.Height < 2)
+        return iA;
+
+    int iB = A.Child1;
+    int iC = A.Child2;
+    AABBTreeNode& B = this->Nodes[iB];
+    AABBTreeNode& C = this->Nodes[iC];
+
+    int balance = C.Height - B.Height;
+
+    //Pulls Up (C or B) above A, Other is the child of A that stays
+    auto Rotate = [&](int iUp, AABBTreeNode& Up, AABBTreeNode& Other, bool UpWasChild2){
+        int iF = Up.Child1;
+        int iG = Up.Child2;
+        AABBTreeNode& F = this->Nodes[iF];
+        AABBTreeNode& G = this->Nodes[iG];
+
+        Up.Child1 = iA;
+        Up.Parent = A.Parent;
+        A.Parent = iUp;
+
+        if(Up.Parent != -1){
+            if(this->Nodes[Up.Parent].Child1 == iA)
+                this->Nodes[Up.Parent].Child1 = iUp;
+            else
+                this->Nodes[Up.Parent].Child2 = iUp;
+        }
+        else{
+            this->Root = iUp;
+        }
+
+        //The taller grandchild stays with Up, the shorter one moves down to A
+        int iKeep = (F.Height > G.Height) ? iF : iG;
+        int iMove = (F.Height > G.Height) ? iG : iF;
+        AABBTreeNode& keep = this->Nodes[iKeep];
+        AABBTreeNode& move = this->Nodes[iMove];
+
+        Up.Child2 = iKeep;
+        if(UpWasChild2)
+            A.Child2 = iMove;
+        else
+            A.Child1 = iMove;
+        move.Parent = iA;
+
+        A.Box = Merged(Other.Box, move.Box);
+        Up.Box = Merged(A.Box, keep.Box);
+
+        A.Height = 1 + std::max(Other.Height, move.Height);
+        Up.Height = 1 + std::max(A.Height, keep.Height);
+
+        return iUp;
+    };
+
+    if(balance > 1)
+        return Rotate(iC, C, B, true);
+
+    if(balance < -1)
+        return Rotate(iB, B, C, false);
+
+    return iA;
+}
+
+void AABBTree::Query(const AABB& Box, const SpatialQueryCallback& Callback) const{
+    std::vector<int> stack;
+    stack.reserve(64);
+    if(this->Root != -1)
+        stack.push_back(this->Root);
+
+    while(!stack.empty()){
+        int index = stack.back();
+        stack.pop_back();
+
+        const AABBTreeNode& node = this->Nodes[index];
+        if(!node.Box.intersects(&Box))
+            continue;
+
+        if(node.IsLeaf()){
+            if(!Callback(index))
+                return;
+        }
+        else{
+            stack.push_back(node.Child1);
+            stack.push_back(node.Child2);
+        }
+    }
+}
+
+void AABBTree::Query(const Frustum& frustum, const SpatialQueryCallback& Callback) const{
+    std::vector<int> stack;
+    stack.reserve(64);
+    if(this->Root != -1)
+        stack.push_back(this->Root);
+
+    while(!stack.empty()){
+        int index = stack.back();
+        stack.pop_back();
+
+        const AABBTreeNode& node = this->Nodes[index];
+        if(!frustum.Intersects(node.Box))
+            continue;
+
+        if(node.IsLeaf()){
+            if(!Callback(index))
+                return;
+        }
+        else{
+            stack.push_back(node.Child1);
+            stack.push_back(node.Child2);
+        }
+    }
+}
+
+void AABBTree::RayCast(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, const SpatialRayCallback& Callback) const{
+    glm::vec3 inverse = 1.f / Direction;
+
+    std::vector<int> stack;
+    stack.reserve(64);
+    if(this->Root != -1)
+        stack.push_back(this->Root);
+
+    while(!stack.empty()){
+        int index = stack.back();
+        stack.pop_back();
+
+        const AABBTreeNode& node = this->Nodes[index];
+
+        float distance;
+        if(!node.Box.intersectsRay(Origin, inverse, MaxDistance, distance))
+            continue;
+
+        if(node.IsLeaf()){
+            float value = Callback(index, MaxDistance);
+            if(value <= 0.f)
+                return;
+            MaxDistance = std::min(MaxDistance, value);
+        }
+        else{
+            stack.push_back(node.Child1);
+            stack.push_back(node.Child2);
+        }
+    }
+}
+
+void AABBTree::Nearest(const glm::vec3& Point, size_t K, std::vector<int>& Out) const{
+    Out.clear();
+    if(this->Root == -1 || K == 0)
+        return;
+
+    //Best first, a box is never closer than its parent's so leaves come out in order
+    typedef std::pair<float, int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    open.push(Entry{DistanceSquared(this->Nodes[this->Root].Box, Point), this->Root});
+
+    while(!open.empty() && Out.size() < K){
+        int index = open.top().second;
+        open.pop();
+
+        const AABBTreeNode& node = this->Nodes[index];
+
+        if(node.IsLeaf()){
+            Out.push_back(index);
+        }
+        else{
+            open.push(Entry{DistanceSquared(this->Nodes[node.Child1].Box, Point), node.Child1});
+            open.push(Entry{DistanceSquared(this->Nodes[node.Child2].Box, Point), node.Child2});
+        }
+    }
+}
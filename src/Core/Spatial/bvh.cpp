@@ -0,0 +1,383 @@
+#include <Unified-Engine/Core/Spatial/bvh.h>
+#include <Unified-Engine/debug.h>
+#include <algorithm>
+#include <queue>
+
+using namespace UnifiedEngine;
+
+//Centroid bins tried per split
+constexpr int SAH_BINS = 16;
+
+static inline float DistanceSquared(const AABB& box, const glm::vec3& point){
+    glm::vec3 closest = glm::clamp(point, box.min, box.max);
+    glm::vec3 d = closest - point;
+    return glm::dot(d, d);
+}
+
+BVH::BVH(){
+
+}
+BVH::BVH(const std::vector<AABB>& Boxes){
+    this->Build(Boxes);
+}
+BVH::~BVH(){
+
+}
+
+void BVH::Clear(){
+    this->Nodes.clear();
+    this->Items.clear();
+    this->Boxes.clear();
+    this->LeafBoxes.Clear();
+}
+
+int BVH::Build(const std::vector<AABB>& Boxes){
+    this->Clear();
+
+    if(Boxes.empty())
+        return 0;
+
+    this->Boxes = Boxes;
+
+    std::vector<glm::vec3> centers(Boxes.size());
+    this->Items.resize(Boxes.size());
+
+    AABB root = {};
+    for(size_t i = 0; i < Boxes.size(); i++){
+        this->Items[i] = (uint32_t)i;
+        centers[i] = Boxes[i].center();
+        root.merge(Boxes[i]);
+    }
+
+    //Never more than 2n - 1 nodes
+    this->Nodes.reserve((Boxes.size() * 2) - 1);
+    this->Nodes.push_back(BVHNode{root, 0, (uint32_t)Boxes.size()});
+
+    this->Split(0, centers);
+
+    this->LeafBoxes.Reserve(this->Items.size());
+    for(auto i = this->Items.begin(); i != this->Items.end(); i++){
+        this->LeafBoxes.Add(this->Boxes[*i]);
+    }
+
+    return 0;
+}
+
+void BVH::Split(uint32_t Node, const std::vector<glm::vec3>& Centers){
+    uint32_t first = this->Nodes[Node].First;
+    uint32_t count = this->Nodes[Node].Count;
+
+    if(count <= this->LeafSize)
+        return;
+
+    AABB centroids = {};
+    for(uint32_t i = first; i < first + count; i++){
+        centroids.expand(Centers[this->Items[i]]);
+    }
+
+    glm::vec3 extent = centroids.max - centroids.min;
+    int axis = (extent.x > extent.y) ? ((extent.x > extent.z) ? 0 : 2) : ((extent.y > extent.z) ? 1 : 2);
+
+    //Every centre in one place, nothing to split on
+    if(extent[axis] <= 0.f)
+        return;
+
+    AABB binBoxes[SAH_BINS];
+    uint32_t binCounts[SAH_BINS] = {};
+    float scale = SAH_BINS / extent[axis];
+
+    auto Bin = [&](uint32_t Item){
+        return std::min((int)((Centers[Item][axis] - centroids.min[axis]) * scale), SAH_BINS - 1);
+    };
+
+    for(uint32_t i = first; i < first + count; i++){
+        int bin = Bin(this->Items[i]);
+        binCounts[bin]++;
+        binBoxes[bin].merge(this->Boxes[this->Items[i]]);
+    }
+
+    //Area times count either side of every bin boundary
+    float rightCost[SAH_BINS] = {};
+    {
+        AABB box = {};
+        uint32_t items = 0;
+        for(int b = SAH_BINS - 1; b > 0; b--){
+            box.merge(binBoxes[b]);
+            items += binCounts[b];
+            rightCost[b] = items ? box.area() * items : 0.f;
+        }
+    }
+
+    float bestCost = FLT_MAX;
+    int bestSplit = -1;
+    {
+        AABB box = {};
+        uint32_t items = 0;
+        for(int b = 1; b < SAH_BINS; b++){
+            box.merge(binBoxes[b - 1]);
+            items += binCounts[b - 1];
+
+            if(items == 0 || items == count)
+                continue;
+
+            float cost = (box.area() * items) + rightCost[b];
+            if(cost < bestCost){
+                bestCost = cost;
+                bestSplit = b;
+            }
+        }
+    }
+
+    //Splitting has to beat testing every item, big leaves are split anyway
+    float leafCost = this->Nodes[Node].Box.area() * count;
+    if((bestSplit < 0 || bestCost >= leafCost) && count <= this->LeafSize * 4)
+        return;
+
+    uint32_t* begin = this->Items.data() + first;
+    uint32_t* middle;
+
+    if(bestSplit >= 0){
+        middle = std::partition(begin, begin + count, [&](uint32_t Item){
+            return Bin(Item) < bestSplit;
+        });
+    }
+    else{
+        //Bins could not separate them, halve on the axis
+        middle = begin + (count / 2);
+        std::nth_element(begin, middle, begin + count, [&](uint32_t a, uint32_t b){
+            return Centers[a][axis] < Centers[b][axis];
+        });
+    }
+
+    uint32_t leftCount = (uint32_t)(middle - begin);
+
+    //Left child follows its parent, the right child follows the whole left subtree
+    AABB leftBox = {};
+    for(uint32_t i = first; i < first + leftCount; i++){
+        leftBox.merge(this->Boxes[this->Items[i]]);
+    }
+
+    uint32_t left = (uint32_t)this->Nodes.size();
+    this->Nodes.push_back(BVHNode{leftBox, first, leftCount});
+    this->Split(left, Centers);
+
+    AABB rightBox = {};
+    for(uint32_t i = first + leftCount; i < first + count; i++){
+        rightBox.merge(this->Boxes[this->Items[i]]);
+    }
+
+    uint32_t right = (uint32_t)this->Nodes.size();
+    this->Nodes.push_back(BVHNode{rightBox, first + leftCount, count - leftCount});
+    this->Split(right, Centers);
+
+    this->Nodes[Node].First = right;
+    this->Nodes[Node].Count = 0;
+}
+
+void BVH::Query(const AABB& Box, const SpatialQueryCallback& Callback) const{
+    std::vector<uint32_t> stack;
+    stack.reserve(64);
+    if(!this->Nodes.empty())
+        stack.push_back(0);
+
+    std::vector<uint32_t> hits; //Leaf items that passed
+
+    while(!stack.empty()){
+        uint32_t index = stack.back();
+        stack.pop_back();
+
+        const BVHNode& node = this->Nodes[index];
+        if(!node.Box.intersects(&Box))
+            continue;
+
+        if(node.Count){
+            hits.resize(std::max(hits.size(), (size_t)node.Count));
+            size_t found = this->LeafBoxes.Overlaps(Box, node.First, node.First + node.Count, hits.data());
+
+            for(size_t i = 0; i < found; i++){
+                if(!Callback(this->Items[hits[i]]))
+                    return;
+            }
+        }
+        else{
+            stack.push_back(node.First);
+            stack.push_back(index + 1);
+        }
+    }
+}
+
+void BVH::Query(const Frustum& frustum, const SpatialQueryCallback& Callback) const{
+    std::vector<uint32_t> stack;
+    stack.reserve(64);
+    if(!this->Nodes.empty())
+        stack.push_back(0);
+
+    std::vector<uint32_t> hits; //Leaf items that passed
+
+    while(!stack.empty()){
+        uint32_t index = stack.back();
+        stack.pop_back();
+
+        const BVHNode& node = this->Nodes[index];
+        if(!frustum.Intersects(node.Box))
+            continue;
+
+        if(node.Count){
+            hits.resize(std::max(hits.size(), (size_t)node.Count));
+            size_t found = this->LeafBoxes.Visible(frustum, node.First, node.First + node.Count, hits.data());
+
+            for(size_t i = 0; i < found; i++){
+                if(!Callback(this->Items[hits[i]]))
+                    return;
+            }
+        }
+        else{
+            stack.push_back(node.First);
+            stack.push_back(index + 1);
+        }
+    }
+}
+
+void BVH::RayCast(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, const SpatialRayCallback& Callback) const{
+    glm::vec3 inverse = 1.f / Direction;
+
+    std::vector<uint32_t> stack;
+    stack.reserve(64);
+    if(!this->Nodes.empty())
+        stack.push_back(0);
+
+    std::vector<uint32_t> hits; //Leaf items that passed
+    std::vector<float> distances;
+
+    while(!stack.empty()){
+        uint32_t index = stack.back();
+        stack.pop_back();
+
+        const BVHNode& node = this->Nodes[index];
+
+        float distance;
+        if(!node.Box.intersectsRay(Origin, inverse, MaxDistance, distance))
+            continue;
+
+        if(node.Count){
+            hits.resize(std::max(hits.size(), (size_t)node.Count));
+            distances.resize(hits.size());
+            size_t found = this->LeafBoxes.RayHits(Origin, inverse, MaxDistance, node.First, node.First + node.Count, hits.data(), distances.data());
+
+            for(size_t i = 0; i < found; i++){
+                //Clipped by an earlier hit in this leaf
+                if(distances[i] > MaxDistance)
+                    continue;
+
+                float value = Callback(this->Items[hits[i]], MaxDistance);
+                if(value <= 0.f)
+                    return;
+                MaxDistance = std::min(MaxDistance, value);
+            }
+        }
+        else{
+            //Nearer child on top so clipping kicks in sooner
+            float leftDistance, rightDistance;
+            bool left = this->Nodes[index + 1].Box.intersectsRay(Origin, inverse, MaxDistance, leftDistance);
+            bool right = this->Nodes[node.First].Box.intersectsRay(Origin, inverse, MaxDistance, rightDistance);
+
+            if(left && right){
+                if(leftDistance < rightDistance){
+                    stack.push_back(node.First);
+                    stack.push_back(index + 1);
+                }
+                else{
+                    stack.push_back(index + 1);
+                    stack.push_back(node.First);
+                }
+            }
+            else if(left){
+                stack.push_back(index + 1);
+            }
+            else if(right){
+                stack.push_back(node.First);
+            }
+        }
+    }
+}
+
+void BVH::Nearest(const glm::vec3& Point, size_t K, std::vector<int>& Out) const{
+    Out.clear();
+    if(this->Nodes.empty() || K == 0)
+        return;
+
+    //Nodes are stored as themselves, items as -(Item + 1)
+    typedef std::pair<float, int64_t> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    open.push(Entry{DistanceSquared(this->Nodes[0].Box, Point), 0});
+
+    while(!open.empty() && Out.size() < K){
+        int64_t code = open.top().second;
+        open.pop();
+
+        if(code < 0){
+            Out.push_back((int)(-code - 1));
+            continue;
+        }
+
+        const BVHNode& node = this->Nodes[code];
+
+        if(node.Count){
+            for(uint32_t i = node.First; i < node.First + node.Count; i++){
+                open.push(Entry{DistanceSquared(this->Boxes[this->Items[i]], Point), -(int64_t)this->Items[i] - 1});
+            }
+        }
+        else{
+            open.push(Entry{DistanceSquared(this->Nodes[code + 1].Box, Point), code + 1});
+            open.push(Entry{DistanceSquared(this->Nodes[node.First].Box, Point), (int64_t)node.First});
+        }
+    }
+}
+
+void BVH::QueryPairs(const BVH& Other, const glm::mat3& Linear, const glm::vec3& Translation, const SpatialPairCallback& Callback) const{
+    if(this->Nodes.empty() || Other.Nodes.empty())
+        return;
+
+    std::vector<std::pair<uint32_t, uint32_t>> stack;
+    stack.reserve(64);
+    stack.push_back({0, 0});
+
+    std::vector<uint32_t> hits;
+
+    while(!stack.empty()){
+        uint32_t index = stack.back().first;
+        uint32_t otherIndex = stack.back().second;
+        stack.pop_back();
+
+        const BVHNode& node = this->Nodes[index];
+        const BVHNode& otherNode = Other.Nodes[otherIndex];
+
+        AABB otherBox = otherNode.Box.transformed(Linear, Translation);
+        if(!node.Box.intersects(&otherBox))
+            continue;
+
+        if(node.Count && otherNode.Count){
+            //Each of the other leaf's items against the whole of this leaf at once
+            hits.resize(std::max(hits.size(), (size_t)node.Count));
+
+            for(uint32_t i = otherNode.First; i < otherNode.First + otherNode.Count; i++){
+                AABB box = Other.Boxes[Other.Items[i]].transformed(Linear, Translation);
+                size_t found = this->LeafBoxes.Overlaps(box, node.First, node.First + node.Count, hits.data());
+
+                for(size_t j = 0; j < found; j++){
+                    if(!Callback(this->Items[hits[j]], Other.Items[i]))
+                        return;
+                }
+            }
+        }
+        //Open the leaf-less side, or the bigger of two inner nodes
+        else if(otherNode.Count || (!node.Count && node.Box.area() >= otherBox.area())){
+            stack.push_back({node.First, otherIndex});
+            stack.push_back({index + 1, otherIndex});
+        }
+        else{
+            stack.push_back({index, otherNode.First});
+            stack.push_back({index, otherIndex + 1});
+        }
+    }
+}
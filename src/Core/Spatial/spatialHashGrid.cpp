@@ -0,0 +1,358 @@
+#include <Unified-Engine/Core/Spatial/spatialHashGrid.h>
+#include <Unified-Engine/Core/threadPool.h>
+#include <Unified-Engine/debug.h>
+#include <GLM/common.hpp>
+#include <GLM/geometric.hpp>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+
+using namespace UnifiedEngine;
+
+//Proxies each worker takes in a rebuild or pair update
+constexpr size_t GRID_PARALLEL_GRAIN = 2048;
+
+//Cell coordinates are kept well inside an int so a query box far out can't overflow them
+constexpr float GRID_CELL_LIMIT = 1073741824.f;
+
+//Smallest cell size taken, anything below is clamped up to it
+constexpr float GRID_MIN_CELL = 0.0001f;
+
+static inline size_t NextPowerOfTwo(size_t Value){
+    size_t power = 1;
+    while(power < Value){
+        power <<= 1;
+    }
+
+    return power;
+}
+
+static inline float HalfSize(const AABB& Box){
+    glm::vec3 half = (Box.max - Box.min) * 0.5f;
+    return std::max(half.x, std::max(half.y, half.z));
+}
+
+SpatialHashGrid::SpatialHashGrid(float CellSize, size_t Buckets)
+    : CellSize(std::max(CellSize, GRID_MIN_CELL)), InverseCellSize(1.f / std::max(CellSize, GRID_MIN_CELL))
+{
+    this->Heads.assign(NextPowerOfTwo(std::max(Buckets, (size_t)1)) + 1, -1);
+}
+SpatialHashGrid::~SpatialHashGrid(){
+
+}
+
+int SpatialHashGrid::CellOf(float Value) const{
+    float cell = std::floor(Value * this->InverseCellSize);
+    return (int)std::max(-GRID_CELL_LIMIT, std::min(GRID_CELL_LIMIT, cell));
+}
+
+int SpatialHashGrid::BucketOf(const int* Cell) const{
+    uint32_t hash = ((uint32_t)Cell[0] * 73856093u) ^ ((uint32_t)Cell[1] * 19349663u) ^ ((uint32_t)Cell[2] * 83492791u);
+
+    //Mixed so neighbouring cells spread over the low bits the mask keeps
+    hash ^= hash >> 16;
+    hash *= 0x7FEB352Du;
+    hash ^= hash >> 15;
+
+    return (int)(hash & (uint32_t)(this->BucketCount() - 1));
+}
+
+int SpatialHashGrid::Locate(const AABB& Box, int* Cell) const{
+    //Past half a cell from its centre a proxy could reach cells a query wouldn't look in
+    if(HalfSize(Box) > this->CellSize * 0.5f)
+        return (int)this->BucketCount();
+
+    glm::vec3 center = Box.center();
+    for(int i = 0; i < 3; i++){
+        Cell[i] = this->CellOf(center[i]);
+    }
+
+    return this->BucketOf(Cell);
+}
+
+void SpatialHashGrid::Link(int Proxy){
+    SpatialHashProxy& proxy = this->Proxies[Proxy];
+    int& head = this->Heads[proxy.Bucket];
+
+    proxy.Previous = -1;
+    proxy.Next = head;
+    if(head != -1)
+        this->Proxies[head].Previous = Proxy;
+
+    head = Proxy;
+}
+
+void SpatialHashGrid::Unlink(int Proxy){
+    SpatialHashProxy& proxy = this->Proxies[Proxy];
+
+    if(proxy.Previous != -1)
+        this->Proxies[proxy.Previous].Next = proxy.Next;
+    else
+        this->Heads[proxy.Bucket] = proxy.Next;
+
+    if(proxy.Next != -1)
+        this->Proxies[proxy.Next].Previous = proxy.Previous;
+
+    proxy.Next = -1;
+    proxy.Previous = -1;
+}
+
+int SpatialHashGrid::CreateProxy(const AABB& Box, void* Data){
+    int index;
+    if(this->FreeList == -1){
+        this->Proxies.push_back(SpatialHashProxy{});
+        index = (int)this->Proxies.size() - 1;
+    }
+    else{
+        index = this->FreeList;
+        this->FreeList = this->Proxies[index].Next;
+        this->Proxies[index] = SpatialHashProxy{};
+    }
+
+    SpatialHashProxy& proxy = this->Proxies[index];
+    proxy.Box = Box;
+    proxy.Data = Data;
+    this->Live++;
+
+    //Rebuild grows the buckets and links this one with the rest
+    if(this->Live * 2 > this->BucketCount()){
+        proxy.Bucket = 0;
+        this->Rebuild();
+        return index;
+    }
+
+    proxy.Bucket = this->Locate(Box, proxy.Cell);
+    if(proxy.Bucket != (int)this->BucketCount())
+        this->Reach = std::max(this->Reach, HalfSize(Box));
+
+    this->Link(index);
+
+    return index;
+}
+
+int SpatialHashGrid::DestroyProxy(int Proxy){
+    if(Proxy < 0 || Proxy >= (int)this->Proxies.size() || this->Proxies[Proxy].Bucket == -1){
+        FAULT("NOT A PROXY: ", Proxy);
+        return -1;
+    }
+
+    this->Unlink(Proxy);
+
+    SpatialHashProxy& proxy = this->Proxies[Proxy];
+    proxy.Bucket = -1;
+    proxy.Data = nullptr;
+    proxy.Next = this->FreeList;
+    this->FreeList = Proxy;
+    this->Live--;
+
+    return 0;
+}
+
+bool SpatialHashGrid::MoveProxy(int Proxy, const AABB& Box){
+    SpatialHashProxy& proxy = this->Proxies[Proxy];
+    proxy.Box = Box;
+
+    int cell[3] = {0, 0, 0};
+    int bucket = this->Locate(Box, cell);
+    if(bucket != (int)this->BucketCount())
+        this->Reach = std::max(this->Reach, HalfSize(Box));
+
+    if(bucket == proxy.Bucket && cell[0] == proxy.Cell[0] && cell[1] == proxy.Cell[1] && cell[2] == proxy.Cell[2])
+        return false;
+
+    this->Unlink(Proxy);
+
+    proxy.Bucket = bucket;
+    for(int i = 0; i < 3; i++){
+        proxy.Cell[i] = cell[i];
+    }
+
+    this->Link(Proxy);
+
+    return true;
+}
+
+int SpatialHashGrid::Rebuild(const SpatialBoxCallback& BoxOf){
+    if(this->Live * 2 > this->BucketCount())
+        this->Heads.assign(NextPowerOfTwo(this->Live * 4) + 1, -1);
+    else
+        std::fill(this->Heads.begin(), this->Heads.end(), -1);
+
+    this->Reach = 0.f;
+
+    //Each proxy swaps itself in as its bucket's head, whoever took the old head next points its Previous back
+    auto job = [&](size_t Begin, size_t End){
+        float reach = 0.f;
+
+        for(size_t i = Begin; i < End; i++){
+            SpatialHashProxy& proxy = this->Proxies[i];
+            if(proxy.Bucket == -1)
+                continue;
+
+            if(BoxOf)
+                proxy.Box = BoxOf((int)i, proxy.Data);
+
+            proxy.Bucket = this->Locate(proxy.Box, proxy.Cell);
+            proxy.Previous = -1;
+            if(proxy.Bucket != (int)this->BucketCount())
+                reach = std::max(reach, HalfSize(proxy.Box));
+
+            int old = std::atomic_ref<int>(this->Heads[proxy.Bucket]).exchange((int)i, std::memory_order_acq_rel);
+            proxy.Next = old;
+            if(old != -1)
+                this->Proxies[old].Previous = (int)i;
+        }
+
+        std::atomic_ref<float> shared(this->Reach);
+        float current = shared.load(std::memory_order_relaxed);
+        while(reach > current && !shared.compare_exchange_weak(current, reach, std::memory_order_relaxed));
+    };
+
+    size_t count = this->Proxies.size();
+    if(__GLOBAL_THREAD_POOL && count > GRID_PARALLEL_GRAIN)
+        __GLOBAL_THREAD_POOL->ParallelFor(count, GRID_PARALLEL_GRAIN, job);
+    else
+        job(0, count);
+
+    return 0;
+}
+
+int SpatialHashGrid::SetCellSize(float Size){
+    if(!(Size > 0.f)){
+        FAULT("BAD CELL SIZE: ", Size);
+        return -1;
+    }
+
+    this->CellSize = Size;
+    this->InverseCellSize = 1.f / Size;
+
+    return this->Rebuild();
+}
+
+bool SpatialHashGrid::Visit(const AABB& Box, int SmallAfter, int LargeAfter, const SpatialQueryCallback& Callback) const{
+    //A small proxy's centre is at most Reach outside anything it overlaps
+    glm::vec3 reach = glm::vec3(this->Reach);
+    int low[3], high[3];
+    double cells = 1.0;
+    for(int i = 0; i < 3; i++){
+        low[i] = this->CellOf(Box.min[i] - reach[i]);
+        high[i] = this->CellOf(Box.max[i] + reach[i]);
+        cells *= (double)high[i] - (double)low[i] + 1.0;
+    }
+
+    size_t buckets = this->BucketCount();
+
+    if(cells > (double)buckets){
+        //Covers more cells than there are buckets, quicker to look at every proxy once
+        for(size_t b = 0; b < buckets; b++){
+            for(int i = this->Heads[b]; i != -1; i = this->Proxies[i].Next){
+                if(i > SmallAfter && this->Proxies[i].Box.intersects(&Box) && !Callback(i))
+                    return false;
+            }
+        }
+    }
+    else{
+        int cell[3];
+        for(cell[0] = low[0]; cell[0] <= high[0]; cell[0]++){
+            for(cell[1] = low[1]; cell[1] <= high[1]; cell[1]++){
+                for(cell[2] = low[2]; cell[2] <= high[2]; cell[2]++){
+                    //Other cells can share the bucket, only this cell's proxies count
+                    for(int i = this->Heads[this->BucketOf(cell)]; i != -1; i = this->Proxies[i].Next){
+                        const SpatialHashProxy& proxy = this->Proxies[i];
+                        if(proxy.Cell[0] != cell[0] || proxy.Cell[1] != cell[1] || proxy.Cell[2] != cell[2])
+                            continue;
+
+                        if(i > SmallAfter && proxy.Box.intersects(&Box) && !Callback(i))
+                            return false;
+                    }
+                }
+            }
+        }
+    }
+
+    for(int i = this->Heads[buckets]; i != -1; i = this->Proxies[i].Next){
+        if(i > LargeAfter && this->Proxies[i].Box.intersects(&Box) && !Callback(i))
+            return false;
+    }
+
+    return true;
+}
+
+void SpatialHashGrid::Query(const AABB& Box, const SpatialQueryCallback& Callback) const{
+    this->Visit(Box, -1, -1, Callback);
+}
+
+void SpatialHashGrid::Query(const glm::vec3& Center, float Radius, const SpatialQueryCallback& Callback) const{
+    AABB box;
+    box.min = Center - glm::vec3(Radius);
+    box.max = Center + glm::vec3(Radius);
+
+    this->Visit(box, -1, -1, [&](int Proxy){
+        const AABB& found = this->Proxies[Proxy].Box;
+        glm::vec3 closest = glm::clamp(Center, found.min, found.max) - Center;
+
+        if(glm::dot(closest, closest) > Radius * Radius)
+            return true;
+
+        return Callback(Proxy);
+    });
+}
+
+bool SpatialHashGrid::VisitPairs(int Proxy, const SpatialPairCallback& Callback) const{
+    bool large = this->Proxies[Proxy].Bucket == (int)this->BucketCount();
+
+    return this->Visit(this->Proxies[Proxy].Box, large ? -1 : Proxy, large ? Proxy : INT_MAX, [&](int Other){
+        if(Other == Proxy)
+            return true;
+
+        return Callback(std::min(Proxy, Other), std::max(Proxy, Other));
+    });
+}
+
+void SpatialHashGrid::QueryPairs(const SpatialPairCallback& Callback) const{
+    for(int i = 0; i < (int)this->Proxies.size(); i++){
+        if(this->Proxies[i].Bucket == -1)
+            continue;
+
+        if(!this->VisitPairs(i, Callback))
+            return;
+    }
+}
+
+int SpatialHashGrid::Update(){
+    size_t count = this->Proxies.size();
+    size_t chunks = (count + GRID_PARALLEL_GRAIN - 1) / GRID_PARALLEL_GRAIN;
+
+    this->ChunkPairs.resize(std::max(chunks, (size_t)1));
+    for(auto i = this->ChunkPairs.begin(); i != this->ChunkPairs.end(); i++){
+        (*i).clear();
+    }
+
+    //Every job keeps its own list so the joined pairs come out in proxy order however the work was split
+    auto job = [&](size_t Begin, size_t End){
+        std::vector<BroadphasePair>& out = this->ChunkPairs[Begin / GRID_PARALLEL_GRAIN];
+
+        for(size_t i = Begin; i < End; i++){
+            if(this->Proxies[i].Bucket == -1)
+                continue;
+
+            this->VisitPairs((int)i, [&](int A, int B){
+                out.push_back(BroadphasePair{A, B});
+                return true;
+            });
+        }
+    };
+
+    if(__GLOBAL_THREAD_POOL && chunks > 1)
+        __GLOBAL_THREAD_POOL->ParallelFor(count, GRID_PARALLEL_GRAIN, job);
+    else
+        job(0, count);
+
+    this->PairList.clear();
+    for(auto i = this->ChunkPairs.begin(); i != this->ChunkPairs.end(); i++){
+        this->PairList.insert(this->PairList.end(), (*i).begin(), (*i).end());
+    }
+
+    return 0;
+}
@@ -1,8 +1,19 @@
 #include <Unified-Engine/Core/instance.h>
 #include <Unified-Engine/debug.h>
 #include <Unified-Engine/Objects/Components/texture2d.h>
+#include <Unified-Engine/Core/Rendering/textureStreamer.h>
+#include <Unified-Engine/Core/Rendering/textureResidency.h>
+#include <Unified-Engine/Core/Rendering/textureBindCache.h>
+#include <Unified-Engine/Core/Rendering/staticBatch.h>
+#include <Unified-Engine/Core/Rendering/frustum.h>
+#include <Unified-Engine/Core/Spatial/aabbTree.h>
+#include <Unified-Engine/Core/Physics/physicsWorld.h>
+#include <Unified-Engine/Core/threadPool.h>
 #include <Unified-Engine/Core/time.h>
 #include <Unified-Engine/Objects/gameObject.h>
+#include <Unified-Engine/Objects/Components/collider.h>
+#include <Unified-Engine/Objects/Components/rigidbody.h>
+#include <Unified-Engine/Debug/profiler.h>
 
 #include <chrono>
 #include <thread>
@@ -26,6 +37,26 @@ namespace UnifiedEngine
 
         __GAME__GLOBAL__INSTANCE__ = new GameInstance();
 
+        //Workers for decoding and other background jobs
+        if(!__GLOBAL_THREAD_POOL)
+            __GLOBAL_THREAD_POOL = new ThreadPool();
+
+        //Bounds of every object for culling, physics and proximity queries
+        if(!__GLOBAL_SCENE_TREE)
+            __GLOBAL_SCENE_TREE = new AABBTree(__GLOBAL_CONFIG__.SceneTreeMargin);
+
+        //Colliders register themselves as they update
+        if(!__GLOBAL_PHYSICS_WORLD){
+            __GLOBAL_PHYSICS_WORLD = new PhysicsWorld(__GLOBAL_SCENE_TREE);
+            __GLOBAL_PHYSICS_WORLD->Settings.Iterations = __GLOBAL_CONFIG__.PhysicsIterations;
+            __GLOBAL_PHYSICS_WORLD->SleepVelocity = __GLOBAL_CONFIG__.PhysicsSleepVelocity;
+            __GLOBAL_PHYSICS_WORLD->SleepTime = __GLOBAL_CONFIG__.PhysicsSleepTime;
+            __GLOBAL_PHYSICS_WORLD->BulletSubsteps = __GLOBAL_CONFIG__.PhysicsBulletSubsteps;
+            __GLOBAL_PHYSICS_WORLD->Deterministic = __GLOBAL_CONFIG__.PhysicsDeterministic;
+            __GLOBAL_PHYSICS_WORLD->FixedTimeStep = __GLOBAL_CONFIG__.PhysicsFixedTimeStep;
+            __GLOBAL_PHYSICS_WORLD->MaxStepsPerFrame = __GLOBAL_CONFIG__.PhysicsMaxStepsPerFrame;
+        }
+
         return 0;
     }
 
@@ -74,8 +105,10 @@ namespace UnifiedEngine
             glDeleteFramebuffers(1, &this->Framebuffer);
         if(this->Renderbuffer)
             glDeleteRenderbuffers(1, &this->Renderbuffer);
-        if(this->Texture)
+        if(this->Texture){
+            BindCache.Forget(this->Texture);
             glDeleteTextures(1, &this->Texture);
+        }
     }
 
     int GameInstance::_Init_Glad(){
@@ -93,11 +126,27 @@ namespace UnifiedEngine
         OpenGLEnable(GL_CULL_FACE);
         OpenGLRendering(GL_BACK, GL_CCW);
         OpenGLEnable(GL_BLEND);
-        OpenGLBlend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        //Premultiplied atlas pages already carry their alpha in the colour
+        if(__GLOBAL_CONFIG__.AtlasCPUMips && __GLOBAL_CONFIG__.AtlasMips.OutputPremultiplied)
+            OpenGLBlend(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        else
+            OpenGLBlend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         OpenGLPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
+        //Tracks what the atlas holds, created first so every texture is accounted for
+        __GLOBAL_TEXTURE_RESIDENCY = new TextureResidency(__GLOBAL_CONFIG__.TextureBudget, __GLOBAL_CONFIG__.TextureEvictionFrames);
+
         //Init Atlas
-        __GLOBAL_ATLAS = new TextureAtlas();
+        if(__GLOBAL_CONFIG__.TextureAtlasArray)
+            __GLOBAL_ATLAS = new TextureArrayAtlas();
+        else
+            __GLOBAL_ATLAS = new TextureAtlas();
+
+        //Async texture loading
+        __GLOBAL_TEXTURE_STREAMER = new TextureStreamer();
+
+        //Combined draws for objects that never move
+        __GLOBAL_STATIC_BATCHER = new StaticBatcher(__GLOBAL_CONFIG__.StaticBatchCellSize);
 
         return 0;
     }
@@ -121,6 +170,11 @@ namespace UnifiedEngine
         //Update Time Class
         Time.Update();
 
+        //Last frame's timings
+        Debug::__GLOBAL_PROFILER.Frame();
+        if(__GLOBAL_CONFIG__.ProfilerReportFrames && this->FrameCounter % __GLOBAL_CONFIG__.ProfilerReportFrames == 0)
+            Debug::__GLOBAL_PROFILER.Report();
+
         // UpdateDebug Window info
         // Done before content as "DeltaTime" control is possible
         if(this->debugWindow){
@@ -133,10 +187,26 @@ namespace UnifiedEngine
         //First Update Input
         glfwPollEvents();
 
+        //Upload any textures that finished decoding
+        if(__GLOBAL_TEXTURE_STREAMER)
+            __GLOBAL_TEXTURE_STREAMER->Update();
+
+        //Give back space from textures that have not been drawn recently
+        if(__GLOBAL_TEXTURE_RESIDENCY)
+            __GLOBAL_TEXTURE_RESIDENCY->Update();
+
         for (auto i = this->objects.begin(); i != this->objects.end(); i++) {
             (*i)->Update();
         }
 
+        //Physics, after everything moved
+        if(__GLOBAL_PHYSICS_WORLD)
+            __GLOBAL_PHYSICS_WORLD->Advance(Time.DeltaTime);
+
+        //Re-bake after static objects came or went
+        if(__GLOBAL_STATIC_BATCHER)
+            __GLOBAL_STATIC_BATCHER->Update();
+
         //Camera
         this->GetMainCamera()->Update();
         this->ProjectionMatrix = glm::mat4(1.f);
@@ -168,6 +238,10 @@ namespace UnifiedEngine
         // Window Context
         this->__windows.front()->Activate();
 
+        //Encode atlas pages changed since the last frame
+        if(__GLOBAL_ATLAS)
+            __GLOBAL_ATLAS->Flush();
+
         // Ensure V-Sync is set properly
         if (this->__windows.front()->Config().vsync) {
             glfwSwapInterval(1); // Enable V-Sync
@@ -179,8 +253,10 @@ namespace UnifiedEngine
             glDeleteFramebuffers(1, &this->Framebuffer);
         if(this->Renderbuffer)
             glDeleteRenderbuffers(1, &this->Renderbuffer);
-        if(this->Texture)
+        if(this->Texture){
+            BindCache.Forget(this->Texture);
             glDeleteTextures(1, &this->Texture);
+        }
 
         // See if we need to scale
         bool Scaled = false;
@@ -207,7 +283,7 @@ namespace UnifiedEngine
         //
         if (Scaled){
             glGenTextures(1, &this->Texture);
-            glBindTexture(GL_TEXTURE_2D, this->Texture);
+            BindCache.Bind(TEXTURE_SCRATCH_UNIT, GL_TEXTURE_2D, this->Texture);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, this->__windows.front()->Config().res_x, this->__windows.front()->Config().res_y, 0, GL_RGB, GL_UNSIGNED_BYTE, 0);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -231,6 +307,23 @@ namespace UnifiedEngine
             this->skybox->Render();
         }
 
+        glm::mat4 viewProjection = this->ProjectionMatrix * this->GetMainCamera()->ViewMatrix;
+
+        // Draw Static Batches
+        if(__GLOBAL_STATIC_BATCHER)
+            __GLOBAL_STATIC_BATCHER->Render(viewProjection);
+
+        // Cull Objects (Anything not in the scene tree is always drawn)
+        if(__GLOBAL_SCENE_TREE){
+            __GLOBAL_SCENE_TREE->Query(Frustum(viewProjection), [](int Proxy){
+                ObjectComponent* object = (ObjectComponent*)__GLOBAL_SCENE_TREE->Data(Proxy);
+                if(object->type == OBJECT_GAME_OBJECT)
+                    ((GameObject*)object)->InView = true;
+
+                return true;
+            });
+        }
+
         // Draw Objects
         for (auto i = this->objects.begin(); i != this->objects.end(); i++) {
             (*i)->Render();
@@ -518,14 +611,92 @@ namespace UnifiedEngine
         return Result;
     }
 
+    bool GameInstance::Raycast(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, RaycastHit& Hit, uint32_t LayerMask){
+        if(!__GLOBAL_PHYSICS_WORLD){
+            Hit = RaycastHit{};
+            return false;
+        }
+
+        return __GLOBAL_PHYSICS_WORLD->Raycast(Origin, Direction, MaxDistance, Hit, LayerMask);
+    }
+
+    size_t GameInstance::RaycastAll(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, std::vector<RaycastHit>& Hits, uint32_t LayerMask){
+        Hits.clear();
+        if(!__GLOBAL_PHYSICS_WORLD)
+            return 0;
+
+        return __GLOBAL_PHYSICS_WORLD->RaycastAll(Origin, Direction, MaxDistance, Hits, LayerMask);
+    }
+
+    bool GameInstance::SphereCast(const glm::vec3& Origin, float Radius, const glm::vec3& Direction, float MaxDistance, RaycastHit& Hit, uint32_t LayerMask){
+        if(!__GLOBAL_PHYSICS_WORLD){
+            Hit = RaycastHit{};
+            return false;
+        }
+
+        return __GLOBAL_PHYSICS_WORLD->SphereCast(Origin, Radius, Direction, MaxDistance, Hit, LayerMask);
+    }
+
+    size_t GameInstance::OverlapBox(const OrientedBox& Box, std::vector<Collider*>& Out, uint32_t LayerMask){
+        Out.clear();
+        if(!__GLOBAL_PHYSICS_WORLD)
+            return 0;
+
+        return __GLOBAL_PHYSICS_WORLD->OverlapBox(Box, Out, LayerMask);
+    }
+
+    size_t GameInstance::OverlapSphere(const glm::vec3& Center, float Radius, std::vector<Collider*>& Out, uint32_t LayerMask){
+        Out.clear();
+        if(!__GLOBAL_PHYSICS_WORLD)
+            return 0;
+
+        return __GLOBAL_PHYSICS_WORLD->OverlapSphere(Center, Radius, Out, LayerMask);
+    }
+
+    void GameInstance::RaycastBatch(const RayQuery* Rays, size_t Count, RaycastHit* Hits, uint32_t LayerMask){
+        if(__GLOBAL_PHYSICS_WORLD){
+            __GLOBAL_PHYSICS_WORLD->RaycastBatch(Rays, Count, Hits, LayerMask);
+            return;
+        }
+
+        for(size_t i = 0; i < Count; i++){
+            Hits[i] = RaycastHit{};
+        }
+    }
+
+    //Destroyed objects leave the scene tree and physics world along with their children
+    static void ReleaseSpatial(ObjectComponent* Object){
+        if(Object->type == OBJECT_GAME_OBJECT)
+            ((GameObject*)Object)->ReleaseSpatial();
+
+        for (auto i = Object->Components.begin(); i != Object->Components.end(); i++){
+            if((*i)->type == OBJECT_COLLIDER)
+                ((Collider*)(*i))->ReleasePhysics();
+            else if((*i)->type == OBJECT_RIGID_BODY)
+                ((RigidBody*)(*i))->ReleasePhysics();
+        }
+
+        for (auto i = Object->Children.begin(); i != Object->Children.end(); i++){
+            ReleaseSpatial(*i);
+        }
+    }
+
     int instantiate(ObjectComponent* Object){
         __GAME__GLOBAL__INSTANCE__->objects.push_back(Object);
 
+        if(__GLOBAL_STATIC_BATCHER && Object->type == OBJECT_GAME_OBJECT)
+            __GLOBAL_STATIC_BATCHER->Add((GameObject*)Object);
+
         return 0;
     }
     int destroy(ObjectComponent* Object){
         __GAME__GLOBAL__INSTANCE__->objects.remove(Object);
 
+        if(__GLOBAL_STATIC_BATCHER && Object->type == OBJECT_GAME_OBJECT)
+            __GLOBAL_STATIC_BATCHER->Remove((GameObject*)Object);
+
+        ReleaseSpatial(Object);
+
         return 0;
     }
 
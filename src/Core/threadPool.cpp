@@ -0,0 +1,131 @@
+#include <Unified-Engine/Core/threadPool.h>
+#include <Unified-Engine/debug.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+using namespace UnifiedEngine;
+
+ThreadPool* UnifiedEngine::__GLOBAL_THREAD_POOL = nullptr;
+
+ThreadPool::ThreadPool(unsigned int WorkerCount){
+    if(!WorkerCount){
+        unsigned int hardware = std::thread::hardware_concurrency();
+        WorkerCount = (hardware > 1) ? hardware - 1 : 1;
+    }
+
+    for(unsigned int i = 0; i < WorkerCount; i++){
+        this->Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(this->JobLock);
+        this->Stopping = true;
+    }
+    this->JobSignal.notify_all();
+
+    for (auto i = this->Workers.begin(); i != this->Workers.end(); i++){
+        if((*i).joinable())
+            (*i).join();
+    }
+}
+
+void ThreadPool::WorkerLoop(){
+    while(true){
+        std::function<void()> job;
+
+        {
+            std::unique_lock<std::mutex> lock(this->JobLock);
+            this->JobSignal.wait(lock, [this]{return this->Stopping || !this->Jobs.empty();});
+
+            //Finish the queue before stopping
+            if(this->Jobs.empty())
+                return;
+
+            job = std::move(this->Jobs.front());
+            this->Jobs.pop_front();
+            this->ActiveJobs++;
+        }
+
+        job();
+
+        {
+            std::lock_guard<std::mutex> lock(this->JobLock);
+            this->ActiveJobs--;
+        }
+        this->IdleSignal.notify_all();
+    }
+}
+
+int ThreadPool::Submit(std::function<void()> Job){
+    if(!Job){
+        FAULT("EMPTY JOB SUBMITTED");
+        return -1;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->JobLock);
+        this->Jobs.push_back(std::move(Job));
+    }
+    this->JobSignal.notify_one();
+
+    return 0;
+}
+
+int ThreadPool::Wait(){
+    std::unique_lock<std::mutex> lock(this->JobLock);
+    this->IdleSignal.wait(lock, [this]{return this->Jobs.empty() && this->ActiveJobs == 0;});
+
+    return 0;
+}
+
+int ThreadPool::ParallelFor(size_t Count, size_t Grain, const std::function<void(size_t Begin, size_t End)>& Job){
+    if(!Count)
+        return 0;
+
+    if(!Grain)
+        Grain = 1;
+
+    size_t chunks = (Count + Grain - 1) / Grain;
+
+    if(chunks == 1 || this->Workers.empty()){
+        Job(0, Count);
+        return 0;
+    }
+
+    struct Progress{
+        std::atomic<size_t> Next{0};
+        std::atomic<size_t> Done{0};
+        std::mutex Lock;
+        std::condition_variable Signal;
+    };
+    std::shared_ptr<Progress> progress = std::make_shared<Progress>();
+
+    //Helpers that start after everything is claimed return without touching Job
+    auto run = [progress, chunks, Grain, Count, &Job](){
+        size_t chunk;
+        while((chunk = progress->Next.fetch_add(1)) < chunks){
+            size_t begin = chunk * Grain;
+            Job(begin, std::min(begin + Grain, Count));
+
+            if(progress->Done.fetch_add(1) + 1 == chunks){
+                std::lock_guard<std::mutex> lock(progress->Lock);
+                progress->Signal.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(chunks - 1, this->Workers.size());
+    for(size_t i = 0; i < helpers; i++){
+        this->Submit(run);
+    }
+
+    //Work here too so calling from inside a job cannot dead lock
+    run();
+
+    std::unique_lock<std::mutex> lock(progress->Lock);
+    progress->Signal.wait(lock, [&]{return progress->Done.load() == chunks;});
+
+    return 0;
+}
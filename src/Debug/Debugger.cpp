@@ -1,6 +1,7 @@
 #include <Unified-Engine/Debug/Debugger.h>
 
 #include <Unified-Engine/includeGL.h>
+#include <Unified-Engine/Core/Rendering/textureBindCache.h>
 
 using namespace UnifiedEngine::Debug;
 
@@ -33,8 +34,10 @@ int DebugWindow::Render(){
         glDeleteFramebuffers(1, &this->Framebuffer);
     if(this->Renderbuffer)
         glDeleteRenderbuffers(1, &this->Renderbuffer);
-    if(this->Texture)
+    if(this->Texture){
+        BindCache.Forget(this->Texture);
         glDeleteTextures(1, &this->Texture);
+    }
 
     //
     // Resolution Stuff
@@ -54,7 +57,7 @@ int DebugWindow::Render(){
     //
     {
         glGenTextures(1, &this->Texture);
-        glBindTexture(GL_TEXTURE_2D, this->Texture);
+        BindCache.Bind(TEXTURE_SCRATCH_UNIT, GL_TEXTURE_2D, this->Texture);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, this->window->Config().res_x, this->window->Config().res_y, 0, GL_RGB, GL_UNSIGNED_BYTE, 0);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
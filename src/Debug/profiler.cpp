@@ -0,0 +1,58 @@
+#include <Unified-Engine/Debug/profiler.h>
+#include <Unified-Engine/debug.h>
+#include <cstring>
+
+using namespace UnifiedEngine::Debug;
+
+Profiler UnifiedEngine::Debug::__GLOBAL_PROFILER;
+
+//Weight of the newest frame in the average
+constexpr double PROFILE_SMOOTHING = 0.1;
+
+int Profiler::Section(const char* Name){
+    for(size_t i = 0; i < this->SectionList.size(); i++){
+        if(this->SectionList[i].Name == Name)
+            return (int)i;
+    }
+
+    //Same text from another translation unit
+    for(size_t i = 0; i < this->SectionList.size(); i++){
+        if(!strcmp(this->SectionList[i].Name, Name))
+            return (int)i;
+    }
+
+    this->SectionList.push_back(ProfileSection{Name});
+
+    return (int)this->SectionList.size() - 1;
+}
+
+void Profiler::Add(int Section, double Milliseconds){
+    this->SectionList[Section].Running += Milliseconds;
+    this->SectionList[Section].RunningCalls++;
+}
+
+void Profiler::Frame(){
+    for(auto i = this->SectionList.begin(); i != this->SectionList.end(); i++){
+        (*i).Milliseconds = (*i).Running;
+        (*i).Calls = (*i).RunningCalls;
+        (*i).Average += ((*i).Running - (*i).Average) * PROFILE_SMOOTHING;
+
+        (*i).Running = 0.0;
+        (*i).RunningCalls = 0;
+    }
+}
+
+void Profiler::Report(){
+    for(auto i = this->SectionList.begin(); i != this->SectionList.end(); i++){
+        LOG("PROFILE ", (*i).Name, ": ", (*i).Average, "MS (", (*i).Calls, " CALLS)");
+    }
+}
+
+const ProfileSection* Profiler::Find(const char* Name) const{
+    for(auto i = this->SectionList.begin(); i != this->SectionList.end(); i++){
+        if(!strcmp((*i).Name, Name))
+            return &(*i);
+    }
+
+    return nullptr;
+}
@@ -1,151 +1,211 @@
 #include <Unified-Engine/Objects/Components/collider.h>
+#include <Unified-Engine/Core/Physics/physicsWorld.h>
+#include <Unified-Engine/Objects/gameObject.h>
+#include <GLM/gtc/quaternion.hpp>
+#include <GLM/matrix.hpp>
+#include <algorithm>
+#include <cmath>
 
 using namespace UnifiedEngine;
 
-// Check if a point is inside a triangle using barycentric coordinates
-bool isPointInTriangle(const glm::vec3& point, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, bool ccw)
-{
-    glm::vec3 u = v1 - v0;
-    glm::vec3 v = v2 - v0;
-    glm::vec3 w = point - v0;
-
-    float uu = glm::dot(u, u);
-    float uv = glm::dot(u, v);
-    float vv = glm::dot(v, v);
-    float wu = glm::dot(w, u);
-    float wv = glm::dot(w, v);
-
-    float denom = uv * uv - uu * vv;
-    if (fabs(denom) < 1e-6f)
-        return false; // Degenerate triangle
-
-    float s = (uv * wv - vv * wu) / denom;
-    float t = (uv * wu - uu * wv) / denom;
-
-    if (ccw)
-        return (s >= 0.0f && t >= 0.0f && s + t <= 1.0f); // CCW
-    else
-        return (s <= 0.0f && t <= 0.0f && s + t >= -1.0f); // CW
+Collider::~Collider(){
+    this->ReleasePhysics();
 }
 
-// Möller-Trumbore algorithm for triangle-triangle intersection
-bool triangleIntersects(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2,
-                        const glm::vec3& u0, const glm::vec3& u1, const glm::vec3& u2, bool ccw = true)
-{
-    // Edge vectors for triangle v (v0, v1, v2)
-    glm::vec3 vEdge1 = v1 - v0;
-    glm::vec3 vEdge2 = v2 - v0;
-
-    // Edge vectors for triangle u (u0, u1, u2)
-    glm::vec3 uEdge1 = u1 - u0;
-    glm::vec3 uEdge2 = u2 - u0;
-
-    // Triangle normal direction (to check for orientation)
-    glm::vec3 normalV = glm::normalize(glm::cross(vEdge1, vEdge2));
-    glm::vec3 normalU = glm::normalize(glm::cross(uEdge1, uEdge2));
-
-    // Orientation check
-    if (ccw)
-    {
-        if (glm::dot(normalV, normalU) < 0) // Opposite direction
-            return false;
-    }
-    else
-    {
-        if (glm::dot(normalV, normalU) > 0) // Same direction
-            return false;
+AABB Collider::WorldBounds(){
+    return AABB{};
+}
+
+int Collider::ReleasePhysics(){
+    if(__GLOBAL_PHYSICS_WORLD)
+        return __GLOBAL_PHYSICS_WORLD->RemoveCollider(this);
+
+    this->Proxy = -1;
+
+    return 0;
+}
+
+int Collider::Update(){
+    if(__GLOBAL_PHYSICS_WORLD && this->Enabled){
+        AABB bounds = this->WorldBounds();
+
+        //Nothing to collide with yet
+        if(bounds.min.x > bounds.max.x)
+            return this->ReleasePhysics();
+
+        return __GLOBAL_PHYSICS_WORLD->AddCollider(this);
     }
 
-    // Check if any vertex of u is inside v
-    if (isPointInTriangle(u0, v0, v1, v2, ccw) ||
-        isPointInTriangle(u1, v0, v1, v2, ccw) ||
-        isPointInTriangle(u2, v0, v1, v2, ccw))
-    {
+    return this->ReleasePhysics();
+}
+
+bool BoxCollider::WorldBox(OrientedBox& Out){
+    AABB local = {};
+
+    if(this->BoundingBox)
+        local = *this->BoundingBox;
+    else if(this->Parent && this->Parent->type == OBJECT_GAME_OBJECT)
+        local = ((GameObject*)this->Parent)->LocalBounds();
+
+    if(local.min.x > local.max.x)
+        return false;
+
+    if(!this->Parent){
+        Out = OrientedBox{local.center() + this->Offset, glm::mat3(1.f), (local.max - local.min) * 0.5f};
         return true;
     }
 
-    // Check if any vertex of v is inside u
-    if (isPointInTriangle(v0, u0, u1, u2, ccw) ||
-        isPointInTriangle(v1, u0, u1, u2, ccw) ||
-        isPointInTriangle(v2, u0, u1, u2, ccw))
-    {
-        return true;
+    //Scaled before rotating so it stays a box
+    Transform& transform = this->Parent->transform;
+    Out.Axes = glm::mat3_cast(transform.Quaternion());
+    Out.Center = transform.Position + Out.Axes * ((local.center() + this->Offset) * transform.Scale);
+    Out.HalfSize = glm::abs((local.max - local.min) * 0.5f * transform.Scale);
+
+    return true;
+}
+
+AABB BoxCollider::WorldBounds(){
+    OrientedBox obb;
+    if(!this->WorldBox(obb))
+        return AABB{};
+
+    //Half size through the axes, the absolute of each (Arvo)
+    glm::vec3 extent(0.f);
+
+    for(int i = 0; i < 3; i++){
+        extent[i] = std::abs(obb.Axes[0][i]) * obb.HalfSize.x + std::abs(obb.Axes[1][i]) * obb.HalfSize.y + std::abs(obb.Axes[2][i]) * obb.HalfSize.z;
     }
 
-    // Check edge-edge intersections
-    auto edgeIntersect = [](const glm::vec3& p1, const glm::vec3& p2,
-                            const glm::vec3& q1, const glm::vec3& q2) -> bool {
-        glm::vec3 r = p2 - p1;
-        glm::vec3 s = q2 - q1;
-        glm::vec3 qp = q1 - p1;
-
-        float rsCross = glm::length(glm::cross(r, s));
-        if (fabs(rsCross) < 1e-6f) // Parallel or collinear
-            return false;
-
-        float t = glm::dot(glm::cross(qp, s), glm::cross(r, s)) / rsCross;
-        float u = glm::dot(glm::cross(qp, r), glm::cross(r, s)) / rsCross;
-
-        return (t >= 0.0f && t <= 1.0f && u >= 0.0f && u <= 1.0f);
-    };
-
-    // Check all edges of both triangles
-    glm::vec3 edgesV[3][2] = {{v0, v1}, {v1, v2}, {v2, v0}};
-    glm::vec3 edgesU[3][2] = {{u0, u1}, {u1, u2}, {u2, u0}};
-
-    for (int i = 0; i < 3; ++i)
-    {
-        for (int j = 0; j < 3; ++j)
-        {
-            if (edgeIntersect(edgesV[i][0], edgesV[i][1], edgesU[j][0], edgesU[j][1]))
-            {
-                return true;
-            }
-        }
+    AABB box = {};
+    box.min = obb.Center - extent;
+    box.max = obb.Center + extent;
+
+    return box;
+}
+
+void SphericalCollider::WorldSphere(glm::vec3& Center, float& WorldRadius){
+    if(!this->Parent){
+        Center = this->Offset;
+        WorldRadius = this->Radius;
+        return;
+    }
+
+    Transform& transform = this->Parent->transform;
+    glm::vec3 scale = glm::abs(transform.Scale);
+
+    Center = transform.Position + glm::mat3_cast(transform.Quaternion()) * (this->Offset * transform.Scale);
+    WorldRadius = this->Radius * std::max(scale.x, std::max(scale.y, scale.z));
+}
+
+AABB SphericalCollider::WorldBounds(){
+    glm::vec3 center;
+    float radius;
+    this->WorldSphere(center, radius);
+
+    AABB box = {};
+    box.min = center - glm::vec3(radius);
+    box.max = center + glm::vec3(radius);
+
+    return box;
+}
+
+const Mesh* MeshCollider::FindMesh(){
+    if(!this->SourceMesh && this->Parent && this->Parent->type == OBJECT_GAME_OBJECT)
+        return &((GameObject*)this->Parent)->mesh;
+
+    return this->SourceMesh;
+}
+
+int MeshCollider::Rebuild(){
+    const Mesh* mesh = this->FindMesh();
+
+    this->Attempted = mesh;
+    this->AttemptedVertices = mesh ? mesh->vertices.size() : 0;
+    this->AttemptedIndices = mesh ? mesh->indices.size() : 0;
+
+    if(!mesh){
+        this->Shape.Clear();
+        return -1;
+    }
+
+    return this->Shape.Build(*mesh);
+}
+
+const TriangleMesh& MeshCollider::GetShape(){
+    //Tried again while empty once the mesh changes, the parent's mesh can be given after the collider
+    if(this->Shape.Empty()){
+        const Mesh* mesh = this->FindMesh();
+
+        if(mesh != this->Attempted || (mesh && (mesh->vertices.size() != this->AttemptedVertices || mesh->indices.size() != this->AttemptedIndices)))
+            this->Rebuild();
+    }
+
+    return this->Shape;
+}
+
+void MeshCollider::WorldTransform(glm::mat3& Linear, glm::vec3& Translation){
+    if(!this->Parent){
+        Linear = glm::mat3(1.f);
+        Translation = this->Offset;
+        return;
+    }
+
+    //Rotation with each local axis scaled, same order as the model matrix
+    Transform& transform = this->Parent->transform;
+    Linear = glm::mat3_cast(transform.Quaternion());
+
+    for(int i = 0; i < 3; i++){
+        Linear[i] *= transform.Scale[i];
     }
 
-    // No intersection found
-    return false;
+    Translation = transform.Position + Linear * this->Offset;
+}
+
+AABB MeshCollider::WorldBounds(){
+    const TriangleMesh& shape = this->GetShape();
+    if(shape.Empty())
+        return AABB{};
+
+    glm::mat3 linear;
+    glm::vec3 translation;
+    this->WorldTransform(linear, translation);
+
+    return shape.Bounds().transformed(linear, translation);
 }
 
-// bool MeshCollider::intersects(MeshCollider* Other){
-
-//     if(!this->mesh->GeneratedAABB){
-//         this->mesh->GeneratedAABB = computeAABB(this->mesh);
-//     }
-//     if(!Other->mesh->GeneratedAABB){
-//         Other->mesh->GeneratedAABB = computeAABB(Other->mesh);
-//     }
-
-//     // Compute AABBs
-//     AABB* box1 = this->mesh->GeneratedAABB;
-//     AABB* box2 = Other->mesh->GeneratedAABB;
-
-//     // Quick rejection using AABB
-//     if (!box1->intersects(box2))
-//     {
-//         return false;
-//     }
-
-//     // Detailed triangle-triangle checks
-//     for (size_t i = 0; i < this->mesh->indices.size(); i += 3)
-//     {
-//         glm::vec3 v0 = this->mesh->vertices[this->mesh->indices[i]].position + this->Offset;
-//         glm::vec3 v1 = this->mesh->vertices[this->mesh->indices[i + 1]].position + this->Offset;
-//         glm::vec3 v2 = this->mesh->vertices[this->mesh->indices[i + 2]].position + this->Offset;
-
-//         for (size_t j = 0; j < Other->mesh->indices.size(); j += 3)
-//         {
-//             glm::vec3 u0 = Other->mesh->vertices[Other->mesh->indices[j]].position + Other->Offset;
-//             glm::vec3 u1 = Other->mesh->vertices[Other->mesh->indices[j + 1]].position + Other->Offset;
-//             glm::vec3 u2 = Other->mesh->vertices[Other->mesh->indices[j + 2]].position + Other->Offset;
-
-//             if (triangleIntersects(v0, v1, v2, u0, u1, u2))
-//             {
-//                 return true; // Collision detected
-//             }
-//         }
-//     }
-
-//     return false; // No collision
-// }
\ No newline at end of file
+bool MeshCollider::Intersects(MeshCollider* Other){
+    const TriangleMesh& shape = this->GetShape();
+    const TriangleMesh& other = Other->GetShape();
+
+    if(shape.Empty() || other.Empty())
+        return false;
+
+    glm::mat3 linearA, linearB;
+    glm::vec3 translationA, translationB;
+    this->WorldTransform(linearA, translationA);
+    Other->WorldTransform(linearB, translationB);
+
+    //A zero scale flattens it past inverting
+    if(std::abs(glm::determinant(linearA)) < 1e-12f)
+        return false;
+
+    //Other's local space into this one's for the hierarchy walk, triangles are tested in world space
+    glm::mat3 inverse = glm::inverse(linearA);
+    bool hit = false;
+
+    shape.Hierarchy().QueryPairs(other.Hierarchy(), inverse * linearB, inverse * (translationB - translationA), [&](int triangle, int otherTriangle){
+        glm::vec3 a[3], b[3];
+        shape.Triangle(triangle, a[0], a[1], a[2]);
+        other.Triangle(otherTriangle, b[0], b[1], b[2]);
+
+        for(int i = 0; i < 3; i++){
+            a[i] = linearA * a[i] + translationA;
+            b[i] = linearB * b[i] + translationB;
+        }
+
+        hit = TrianglesIntersect(a[0], a[1], a[2], b[0], b[1], b[2]);
+        return !hit;
+    });
+
+    return hit;
+}
@@ -74,18 +74,20 @@ Texture2DMaterial::Texture2DMaterial(ObjectComponent* Parent, Texture2D* texture
     //Create Args For Parent
     ShaderObject* parentShader = (ShaderObject*)Parent;
 
-    ShaderArguments TextureArg = {.dataLoc = (unsigned int*)(&(this->texture->TextureID)), .type = SHADER_ARG_INT, .name = "Texture"};
+    ShaderArguments TextureArg = {.dataLoc = &(this->texture->Unit), .type = SHADER_ARG_INT, .name = "Texture"};
     // ShaderArguments UVArg = {.dataLoc = &this->texture->UVsr.UV, .type = SHADER_ARG_VEC2, .name = "UVMap"};
     ShaderArguments UVArg0 = {.dataLoc = &(this->texture->UVs.UV[0]), .type = SHADER_ARG_VEC2, .name = "UVMap[0]"};
     ShaderArguments UVArg1 = {.dataLoc = &(this->texture->UVs.UV[1]), .type = SHADER_ARG_VEC2, .name = "UVMap[1]"};
     ShaderArguments UVArg2 = {.dataLoc = &(this->texture->UVs.UV[2]), .type = SHADER_ARG_VEC2, .name = "UVMap[2]"};
     ShaderArguments UVArg3 = {.dataLoc = &(this->texture->UVs.UV[3]), .type = SHADER_ARG_VEC2, .name = "UVMap[3]"};
+    ShaderArguments LayerArg = {.dataLoc = &(this->texture->Layer), .type = SHADER_ARG_INT, .name = "TextureLayer"};
 
     parentShader->Arguments.push_back(TextureArg);
     parentShader->Arguments.push_back(UVArg0);
     parentShader->Arguments.push_back(UVArg1);
     parentShader->Arguments.push_back(UVArg2);
     parentShader->Arguments.push_back(UVArg3);
+    parentShader->Arguments.push_back(LayerArg);
 }
 Texture2DMaterial::~Texture2DMaterial(){
     //TODO: Remove arguments from Shader
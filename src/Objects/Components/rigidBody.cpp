@@ -1,8 +1,12 @@
 #include <Unified-Engine/Objects/Components/rigidbody.h>
 #include <Unified-Engine/Objects/Components/collider.h>
 #include <Unified-Engine/Objects/gameObject.h>
+#include <Unified-Engine/Core/Physics/physicsWorld.h>
+#include <Unified-Engine/Core/Physics/contact.h>
 #include <Unified-Engine/debug.h>
 #include <Unified-Engine/Core/time.h>
+#include <GLM/gtc/quaternion.hpp>
+#include <algorithm>
 
 using namespace UnifiedEngine;
 
@@ -12,7 +16,7 @@ RigidBody::RigidBody(ObjectComponent* parent)
 
 }
 RigidBody::~RigidBody(){
-
+    this->ReleasePhysics();
 }
 
 int RigidBody::Update(){
@@ -21,37 +25,151 @@ int RigidBody::Update(){
         return -1;
     }
 
-    GameObject* parent = (GameObject*)this->Parent;
+    //The world integrates around solving contacts
+    if(__GLOBAL_PHYSICS_WORLD){
+        if(this->Enabled)
+            return __GLOBAL_PHYSICS_WORLD->AddBody(this);
+
+        return this->ReleasePhysics();
+    }
+
+    this->IntegrateVelocity(Time.DeltaTime);
+    this->IntegratePosition(Time.DeltaTime);
+
+    return 0;
+}
+int RigidBody::Render(){
+
+
+    return 0;
+}
+
+int RigidBody::ReleasePhysics(){
+    if(__GLOBAL_PHYSICS_WORLD)
+        return __GLOBAL_PHYSICS_WORLD->RemoveBody(this);
+
+    this->SolverIndex = -1;
+
+    return 0;
+}
+
+int RigidBody::Wake(){
+    this->Sleeping = false;
+    this->SleepTimer = 0.f;
+
+    return 0;
+}
+
+int RigidBody::IntegrateVelocity(float DeltaTime){
+    //Immovable bodies keep whatever velocity they were given
+    if(this->Mass <= 0)
+        return 0;
 
     // Calculate adjusted acceleration with gravity applied (if enabled)
-    glm::vec3 gravityForce = glm::vec3(0, Gravity * UseGravity * 10, 0);
+    glm::vec3 gravityForce = glm::vec3(0.f, this->UseGravity ? this->Gravity * 10.f : 0.f, 0.f);
     glm::vec3 AdjustedAcceleration = this->Acceleration + gravityForce;
 
     // Update velocity based on acceleration and time step
-    this->Velocity += AdjustedAcceleration * Time.DeltaTime;
+    this->Velocity += AdjustedAcceleration * DeltaTime;
 
     // Apply drag to the velocity
     if (glm::length(this->Velocity) > 0.0f) {
         glm::vec3 dragForce = glm::normalize(this->Velocity) * glm::length(this->Velocity) * this->DragFactor;
-        this->Velocity -= dragForce * Time.DeltaTime;
+        this->Velocity -= dragForce * DeltaTime;
     }
 
-    // Update the position of the parent object based on velocity and position lock
-    parent->transform.Position += this->Velocity * Time.DeltaTime * this->PositionLock;
+    this->AngularVelocity *= std::max(0.f, 1.f - (this->AngularDrag * DeltaTime));
 
     // Reset acceleration for the next frame (forces should re-apply each frame)
     this->Acceleration = glm::vec3(0.0);
 
     return 0;
 }
-int RigidBody::Render(){
 
+int RigidBody::IntegratePosition(float DeltaTime){
+    GameObject* parent = (GameObject*)this->Parent;
+
+    // Update the position of the parent object based on velocity and position lock
+    parent->transform.Position += this->Velocity * DeltaTime * this->PositionLock;
+
+    //Spin about the world axis of the angular velocity
+    glm::vec3 spin = this->AngularVelocity * this->RotationLock;
+    float speed = glm::length(spin);
+
+    if(speed > 1e-6f)
+        parent->transform.Rotate(glm::angleAxis(speed * DeltaTime, spin / speed));
 
     return 0;
 }
 
-int RigidBody::CheckIfCollided(Collider* collider1, Collider* collider2){
+float RigidBody::FrictionCoefficient() const{
+    return this->Friction ? this->FrictionLevel * 0.1f : 0.f;
+}
+
+glm::vec3 RigidBody::InverseMass() const{
+    if(this->Mass <= 0)
+        return glm::vec3(0.f);
+
+    return this->PositionLock / (float)this->Mass;
+}
+
+glm::mat3 RigidBody::InverseInertia(){
+    if(this->Mass <= 0)
+        return glm::mat3(0.f);
+
+    //R * I^-1 * R^T, then locked axes zeroed on both sides
+    glm::mat3 rotation = glm::mat3_cast(this->Parent->transform.Quaternion());
+    glm::mat3 inertia = rotation * glm::mat3(glm::vec3(this->LocalInverseInertia.x, 0.f, 0.f), glm::vec3(0.f, this->LocalInverseInertia.y, 0.f), glm::vec3(0.f, 0.f, this->LocalInverseInertia.z)) * glm::transpose(rotation);
+
+    for(int i = 0; i < 3; i++){
+        for(int j = 0; j < 3; j++){
+            inertia[i][j] *= this->RotationLock[i] * this->RotationLock[j];
+        }
+    }
+
+    return inertia;
+}
 
+int RigidBody::UpdateMassProperties(){
+    float mass = (float)std::max(this->Mass, 1);
+
+    //Unit cube without a shape
+    glm::vec3 half = glm::vec3(0.5f);
+    bool sphere = false;
+    float radius = 0.f;
+
+    Collider* collider = (Collider*)this->Parent->GetCompoentOfType(OBJECT_COLLIDER);
+    if(collider && collider->GetType() == COLLIDER_BOX){
+        OrientedBox box;
+        if(((BoxCollider*)collider)->WorldBox(box))
+            half = glm::max(box.HalfSize, glm::vec3(1e-3f));
+    }
+    else if(collider && collider->GetType() == COLLIDER_SPHERE){
+        glm::vec3 center;
+        ((SphericalCollider*)collider)->WorldSphere(center, radius);
+        sphere = radius > 1e-3f;
+    }
+    else if(collider && collider->GetType() == COLLIDER_MESH){
+        //Treated as its bounds
+        const TriangleMesh& shape = ((MeshCollider*)collider)->GetShape();
+        if(!shape.Empty())
+            half = glm::max(glm::abs((shape.Bounds().max - shape.Bounds().min) * 0.5f * this->Parent->transform.Scale), glm::vec3(1e-3f));
+    }
+
+    if(sphere){
+        this->LocalInverseInertia = glm::vec3(1.f / (0.4f * mass * radius * radius));
+    }
+    else{
+        //Solid box, m/12 * (w^2 + h^2) with half sizes
+        glm::vec3 h2 = half * half;
+        this->LocalInverseInertia = glm::vec3(3.f / (mass * (h2.y + h2.z)), 3.f / (mass * (h2.x + h2.z)), 3.f / (mass * (h2.x + h2.y)));
+    }
 
     return 0;
-}
\ No newline at end of file
+}
+
+int RigidBody::CheckIfCollided(Collider* collider1, Collider* collider2){
+    ContactManifold manifold;
+
+    return Collide(collider1, collider2, manifold) > 0;
+}
@@ -101,6 +101,11 @@ int ShaderObject::PassArgs(){
     SendArg(this->shader, {.dataLoc=&(ParentObj->transform.Position), .type=SHADER_ARG_VEC3, .name="ObjectPosition"});
     SendArg(this->shader, {.dataLoc=&(ParentObj->transform.Rotation()), .type=SHADER_ARG_VEC3, .name="ObjectRotation"});
 
+    //Vertex decoding
+    SendArg(this->shader, {.dataLoc=&(ParentObj->Layout), .type=SHADER_ARG_INT, .name="VertexLayout"});
+    SendArg(this->shader, {.dataLoc=&(ParentObj->MeshOffset), .type=SHADER_ARG_VEC3, .name="MeshOffset"});
+    SendArg(this->shader, {.dataLoc=&(ParentObj->MeshScale), .type=SHADER_ARG_VEC3, .name="MeshScale"});
+
     //Camera
     SendArg(this->shader, {.dataLoc=&(__GAME__GLOBAL__INSTANCE__->GetMainCamera()->transform.Position), .type=SHADER_ARG_VEC3, .name="CameraPosition"});
     SendArg(this->shader, {.dataLoc=&(__GAME__GLOBAL__INSTANCE__->GetMainCamera()->transform.Rotation()), .type=SHADER_ARG_VEC3, .name="CameraRotation"});
@@ -1,10 +1,16 @@
 #include <Unified-Engine/Objects/Components/texture2d.h>
+#include <Unified-Engine/Core/Rendering/textureStreamer.h>
+#include <Unified-Engine/Core/Rendering/texturePack.h>
+#include <Unified-Engine/Core/Rendering/textureResidency.h>
+#include <Unified-Engine/Core/Rendering/textureBindCache.h>
+#include <Unified-Engine/Core/config.h>
 #include <Unified-Engine/debug.h>
 #include <vector>
 #include <SOIL2/SOIL2.h>
 #include <iostream>
 #include <cstdint>
 #include <cstring>
+#include <algorithm>
 
 using namespace UnifiedEngine;
 
@@ -44,14 +50,19 @@ Atlas_Image_Location TextureAtlas::FindAvailableSpace(glm::ivec2 Size){
 
                 (*i).erase((j));
 
-                return Atlas_Image_Location{glm::ivec2(Big.x, Small.y), (*(std::next(this->TextureIdentifiers.begin(), index))), index};
+                return Atlas_Image_Location{glm::ivec2(Big.x, Small.y), this->TextureIdentifiers[index], index};
             }
         }
 
         index++;
     }
 
-    return Atlas_Image_Location{glm::ivec2(-1), 0};
+    //No page had space so open a new one (only if it could ever fit)
+    if(Size.x <= ATLAS_PAGE_SIZE && Size.y <= ATLAS_PAGE_SIZE && this->AddPage() >= 0){
+        return this->FindAvailableSpace(Size);
+    }
+
+    return Atlas_Image_Location{glm::ivec2(-1), 0, -1};
 }
 int TextureAtlas::CopyImageData(GLuint Dest, GLuint Src, glm::ivec2 Position, glm::ivec2 Size){
 
@@ -84,131 +95,611 @@ int TextureAtlas::CopyImageData(GLuint Dest, GLuint Src, glm::ivec2 Position, gl
 
     return 0;
 }
-int TextureAtlas::CopyImageData(GLuint Dest, uint8_t* Src, glm::ivec2 Position, glm::ivec2 Size){
-
-    glBindTexture(GL_TEXTURE_2D, Dest);
-
-    //Get the data
-    unsigned char * destData = (unsigned char *)malloc(4096 * 4096 * 4);
-    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, destData);
-
-    for(int i = Position.y; i < Position.y + Size.y; i++){
-        std::memcpy(destData + (i * 4096 * 4) + (Position.x * 4), Src + (Size.x * (i - Position.y) * 4), (Size.x * 4));
+int TextureAtlas::CopyImageData(GLuint Dest, int Layer, uint8_t* Src, glm::ivec2 Position, glm::ivec2 Size){
+    if(this->UsesShadow()){
+        return this->CopyToShadow(Layer, Src, Position, Size);
     }
 
-    // glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 4096, 4096, GL_BGRA, GL_UNSIGNED_BYTE, destData);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 4096, 4096, 0, GL_RGBA, GL_UNSIGNED_BYTE, destData);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-
-    glGenerateMipmap(GL_TEXTURE_2D);
+    BindCache.Bind(TEXTURE_SCRATCH_UNIT, GL_TEXTURE_2D, Dest);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    //Only upload the region that changed (Src is an offset when a GL_PIXEL_UNPACK_BUFFER is bound)
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, Position.x, Position.y, Size.x, Size.y, GL_RGBA, GL_UNSIGNED_BYTE, Src);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
-    this->Bound = 0;
+    glGenerateMipmap(GL_TEXTURE_2D);
 
     return 0;
 }
 GLuint TextureAtlas::CreateNewImage(){
-
-    std::vector<GLubyte> emptyData(4096 * 4096 * 4, 0);
     GLuint id;
     glGenTextures(1, &id);
 
+    BindCache.Bind(TEXTURE_SCRATCH_UNIT, GL_TEXTURE_2D, id);
+
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, this->CPUMips ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+
+    //Blocks are uploaded by Flush(), compressed pages only have mips when they are built on the CPU
+    if(this->Compression){
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, this->MipLevels - 1);
+
+        for(int level = 0; level < this->MipLevels; level++){
+            int size = std::max(ATLAS_PAGE_SIZE >> level, 1);
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, CompressedInternalFormat(this->Compression), size, size, 0, CompressedImageSize(this->Compression, size, size), nullptr);
+        }
+
+        return id;
+    }
+
+    std::vector<GLubyte> emptyData(4096 * 4096 * 4, 0);
 
-    glBindTexture(GL_TEXTURE_2D, id);
     // glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 4096, 4096, GL_BGRA, GL_UNSIGNED_BYTE, &emptyData[0]);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 4096, 4096, 0, GL_RGBA, GL_UNSIGNED_BYTE, &emptyData[0]);
 
-    glGenerateMipmap(GL_TEXTURE_2D);
+    //Allocating the levels directly is far cheaper than filtering an empty page
+    if(this->CPUMips){
+        for(int level = 1; level < this->MipLevels; level++){
+            int size = std::max(ATLAS_PAGE_SIZE >> level, 1);
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, &emptyData[0]);
+        }
+    }
+    else{
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
 
     return id;
 }
 
-TextureAtlas::TextureAtlas(){
+int TextureAtlas::AddPage(){
+    GLuint id = this->CreateNewImage();
+
+    if(!id){
+        FAULT("COULD NOT CREATE ATLAS PAGE");
+        return -1;
+    }
+
+    //Fill a released slot before growing so page indices stay small
+    int page = std::find(this->TextureIdentifiers.begin(), this->TextureIdentifiers.end(), 0) - this->TextureIdentifiers.begin();
+
+    if(page == (int)this->TextureIdentifiers.size()){
+        this->TextureIdentifiers.push_back(id);
+        this->SpaceIdentifiers.push_back(std::list<Atlas_Space_Identifier>{});
+        this->Texture2DIdentifiers.push_back(std::list<Atlas_Texture_Identifier>{});
+        this->PageLocked.push_back(0);
+        this->PageGenerations.push_back(0);
+    }
+    else{
+        this->TextureIdentifiers[page] = id;
+    }
+
+    //Load the texture info
+    this->SpaceIdentifiers[page] = std::list<Atlas_Space_Identifier>{Atlas_Space_Identifier{0, 0, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE}};
+    this->AddPageShadow(page);
+
+    return page;
+}
+
+int TextureAtlas::ReleasePage(int Page){
+    //Dropping the page is what actually gives the memory back
+    BindCache.Forget(this->TextureIdentifiers[Page]);
+    glDeleteTextures(1, &this->TextureIdentifiers[Page]);
+
+    this->TextureIdentifiers[Page] = 0;
+    this->SpaceIdentifiers[Page].clear(); //Nothing fits on a released page until AddPage fills it again
+    this->PageLocked[Page] = 0;
+    this->PageGenerations[Page]++;
+
+    if(this->UsesShadow()){
+        std::vector<uint8_t>().swap(this->PageShadows[Page]);
+        this->PageDirty[Page] = glm::ivec4(0);
+    }
+
+    return 0;
+}
+
+int TextureAtlas::FreeSpace(Texture2D* image){
+    if(image->Page < 0 || image->Page >= (int)this->Texture2DIdentifiers.size()){
+        return 0;
+    }
+
+    std::list<Atlas_Texture_Identifier>& textures = this->Texture2DIdentifiers[image->Page];
+
+    auto found = std::find_if(textures.begin(), textures.end(), [image](const Atlas_Texture_Identifier& t){return t.Texture == image;});
+    if(found == textures.end()){
+        return 0;
+    }
+
+    Atlas_Space_Identifier space = {(*found).x, (*found).y, (*found).w, (*found).h};
+    textures.erase(found);
+
+    int page = image->Page;
+    image->Page = -1;
+
+    if(textures.empty()){
+        return this->ReleasePage(page);
+    }
+
+    //Smallest first so little textures go back into little gaps
+    if(!this->PageLocked[page]){
+        auto j = this->SpaceIdentifiers[page].begin();
+        while(j != this->SpaceIdentifiers[page].end() && (uint64_t)(*j).w * (*j).h < (uint64_t)space.w * space.h)
+            j++;
+
+        this->SpaceIdentifiers[page].insert(j, space);
+    }
+
+    return 0;
+}
+
+size_t TextureAtlas::TextureBytes(int width, int height){
+    size_t bytes = (this->Compression) ? CompressedImageSize(this->Compression, width, height) : (size_t)width * height * 4;
+
+    //A full chain is a third bigger again, compressed pages only have one when it is built on the CPU
+    if(this->CPUMips || !this->Compression)
+        bytes += bytes / 3;
+
+    return bytes;
+}
+
+size_t TextureAtlas::PageBytes(){
+    size_t pages = 0;
+    for (auto i = this->TextureIdentifiers.begin(); i != this->TextureIdentifiers.end(); i++){
+        if((*i))
+            pages++;
+    }
+
+    return this->TextureBytes(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE) * pages;
+}
+
+int TextureAtlas::UploadLevel(int Page, int Level, const uint8_t* Src){
+    int size = std::max(ATLAS_PAGE_SIZE >> Level, 1);
+
+    //Shadowed pages take the top level, Flush() makes the rest
+    if(this->UsesShadow()){
+        return Level ? 0 : this->CopyToShadow(Page, Src, glm::ivec2(0), glm::ivec2(size));
+    }
+
+    return this->UploadRegion(Page, Level, glm::ivec2(0), glm::ivec2(size), Src, size);
+}
+
+int TextureAtlas::AddPageShadow(int Page){
+    if(!this->UsesShadow()){
+        return 0;
+    }
+
+    if(Page == (int)this->PageShadows.size()){
+        this->PageShadows.push_back({});
+        this->PageDirty.push_back(glm::ivec4(0));
+    }
+
+    this->PageShadows[Page].assign(MipChainOffset(ATLAS_PAGE_SIZE, this->MipLevels), 0);
+
+    //Compressed storage starts undefined so the first Flush() has to fill it, plain storage is already cleared
+    if(this->Compression)
+        this->PageDirty[Page] = glm::ivec4(0, 0, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+    else
+        this->PageDirty[Page] = glm::ivec4(0);
+
+    return 0;
+}
+
+int TextureAtlas::CopyToShadow(int Page, const uint8_t* Src, glm::ivec2 Position, glm::ivec2 Size){
+    if(Page < 0 || Page >= (int)this->PageShadows.size() || !Src){
+        FAULT("INVALID ATLAS PAGE WRITE");
+        return -1;
+    }
+
+    uint8_t* shadow = &this->PageShadows[Page][0];
+    for(int y = 0; y < Size.y; y++){
+        uint8_t* row = shadow + ((((size_t)Position.y + y) * ATLAS_PAGE_SIZE) + Position.x) * 4;
+        std::memcpy(row, Src + ((size_t)y * Size.x * 4), (size_t)Size.x * 4);
+
+        //Only what was written, the rest of the dirty area is already converted
+        if(this->CPUMips && __GLOBAL_CONFIG__.AtlasMips.OutputPremultiplied)
+            PremultiplyAlpha(row, Size.x);
+    }
+
+    glm::ivec4& dirty = this->PageDirty[Page];
+    glm::ivec4 region(Position.x, Position.y, Position.x + Size.x, Position.y + Size.y);
+
+    if(dirty.z <= dirty.x || dirty.w <= dirty.y)
+        dirty = region;
+    else
+        dirty = glm::ivec4(std::min(dirty.x, region.x), std::min(dirty.y, region.y), std::max(dirty.z, region.z), std::max(dirty.w, region.w));
+
+    return 0;
+}
+
+int TextureAtlas::UploadRegion(int Page, int Level, glm::ivec2 Position, glm::ivec2 Size, const uint8_t* Src, int RowLength){
+    BindCache.Bind(TEXTURE_SCRATCH_UNIT, GL_TEXTURE_2D, this->TextureIdentifiers[Page]);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, RowLength);
+    glTexSubImage2D(GL_TEXTURE_2D, Level, Position.x, Position.y, Size.x, Size.y, GL_RGBA, GL_UNSIGNED_BYTE, Src);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    return 0;
+}
+
+int TextureAtlas::UploadBlocks(int Page, int Level, glm::ivec2 Position, glm::ivec2 Size, const uint8_t* Blocks){
+    BindCache.Bind(TEXTURE_SCRATCH_UNIT, GL_TEXTURE_2D, this->TextureIdentifiers[Page]);
+
+    glCompressedTexSubImage2D(GL_TEXTURE_2D, Level, Position.x, Position.y, Size.x, Size.y, CompressedInternalFormat(this->Compression), CompressedImageSize(this->Compression, Size.x, Size.y), Blocks);
+
+    return 0;
+}
+
+int TextureAtlas::Flush(){
+    if(!this->UsesShadow()){
+        return 0;
+    }
+
+    for(size_t page = 0; page < this->PageDirty.size(); page++){
+        glm::ivec4 region = this->PageDirty[page];
+
+        if(region.z <= region.x || region.w <= region.y)
+            continue;
+
+        uint8_t* chain = &this->PageShadows[page][0];
+
+        //Each level only rebuilds what the changes above it reach
+        for(int level = 0; level < this->MipLevels; level++){
+            int size = std::max(ATLAS_PAGE_SIZE >> level, 1);
+            uint8_t* pixels = chain + MipChainOffset(ATLAS_PAGE_SIZE, level);
+
+            if(level)
+                region = DownsampleRegion(chain + MipChainOffset(ATLAS_PAGE_SIZE, level - 1), size * 2, pixels, region, __GLOBAL_CONFIG__.AtlasMips);
+
+            if(region.z <= region.x || region.w <= region.y)
+                break;
+
+            if(this->UploadShadow(page, level, region)){
+                return -1;
+            }
+        }
+
+        this->PageDirty[page] = glm::ivec4(0);
+    }
+
+    return 0;
+}
+
+int TextureAtlas::UploadShadow(int Page, int Level, glm::ivec4 Region){
+    int size = std::max(ATLAS_PAGE_SIZE >> Level, 1);
+    const uint8_t* pixels = &this->PageShadows[Page][MipChainOffset(ATLAS_PAGE_SIZE, Level)];
+
+    if(!this->Compression){
+        glm::ivec2 position(Region.x, Region.y);
+        return this->UploadRegion(Page, Level, position, glm::ivec2(Region.z - Region.x, Region.w - Region.y), pixels + ((((size_t)position.y * size) + position.x) * 4), size);
+    }
+
+    //Grow to whole blocks, levels are multiples of 4 (Or smaller than a block) so this stays inside
+    glm::ivec2 position(Region.x & ~3, Region.y & ~3);
+    glm::ivec2 extent(std::min((Region.z + 3) & ~3, size) - position.x, std::min((Region.w + 3) & ~3, size) - position.y);
+
+    std::vector<uint8_t> blocks(CompressedImageSize(this->Compression, extent.x, extent.y));
+
+    if(CompressImage(this->Compression, pixels + ((((size_t)position.y * size) + position.x) * 4), extent.x, extent.y, (size_t)size * 4, &blocks[0])){
+        return -1;
+    }
+
+    return this->UploadBlocks(Page, Level, position, extent, &blocks[0]);
+}
+
+TextureAtlas::TextureAtlas(GLenum Target)
+    : Target(Target)
+{
     //Initialise Lists
     this->TextureIdentifiers = {};
     this->SpaceIdentifiers = {};
     this->Texture2DIdentifiers = {};
 
+    this->Compression = SupportedCompression(__GLOBAL_CONFIG__.AtlasCompression);
+    this->CPUMips = __GLOBAL_CONFIG__.AtlasCPUMips;
+    this->MipLevels = this->CPUMips ? MipLevelCount(ATLAS_PAGE_SIZE) : 1;
+}
+TextureAtlas::TextureAtlas()
+    : TextureAtlas(GL_TEXTURE_2D)
+{
     //Create First Texture Space
-    GLuint id = CreateNewImage();
-
-    //Load the texture info
-    this->TextureIdentifiers.push_back(id);
-    this->SpaceIdentifiers.push_back(std::list<Atlas_Space_Identifier>{Atlas_Space_Identifier{0, 0, 4096, 4096}});
-    this->Texture2DIdentifiers.push_back(std::list<Atlas_Texture_Identifier>{});
+    this->AddPage();
 }
 TextureAtlas::~TextureAtlas(){
     for (auto i = this->TextureIdentifiers.begin(); i != this->TextureIdentifiers.end(); i++){
+        if(!(*i))
+            continue;
+
+        BindCache.Forget(*i);
         glDeleteTextures(1, &(*i));
     }
 }
 
-int TextureAtlas::AddImage(Texture2D* image){
+int TextureAtlas::PlaceImage(Texture2D* image, Atlas_Image_Location& Location){
     //First Check it fits
-    Atlas_Image_Location position = this->FindAvailableSpace(glm::ivec2(image->width, image->height));
+    Location = this->FindAvailableSpace(glm::ivec2(image->width, image->height));
 
-    if(position.Dest == 0){
+    if(Location.Dest == 0){
         FAULT("COULD NOT FIT IMAGE");
         return -1;
     }
 
-    this->CopyImageData(position.Dest, image->Data, position.pos, glm::ivec2(image->width, image->height));
+    return this->PlaceImageAt(image, Location.index, Location.pos);
+}
+int TextureAtlas::PlaceImageAt(Texture2D* image, int Page, glm::ivec2 Position){
+    this->Texture2DIdentifiers[Page].push_back(Atlas_Texture_Identifier{(uint32_t)Position.x, (uint32_t)Position.y, (uint32_t)image->width, (uint32_t)image->height, image});
+
+    if(!image->FilePath.empty())
+        this->Textures[image->FilePath] = image;
 
-    (*(std::next(this->Texture2DIdentifiers.begin(), position.index))).push_back(Atlas_Texture_Identifier{(uint32_t)position.pos.x, (uint32_t)position.pos.y, (uint32_t)image->width, (uint32_t)image->height, image});
+    image->UVs.UV[0] = glm::vec2((Position.x) / 4096.0f, 1.f - ((Position.y) / 4096.0f)); //0,1
+    image->UVs.UV[1] = glm::vec2((Position.x + image->width) / 4096.0f, 1.f - ((Position.y) / 4096.0f)); //1, 1
+    image->UVs.UV[2] = glm::vec2((Position.x) / 4096.0f, 1.f - ((Position.y + image->height) / 4096.0f)); //0, 0
+    image->UVs.UV[3] = glm::vec2((Position.x + image->width) / 4096.0f, 1.f - ((Position.y + image->height) / 4096.0f)); //1, 0
 
-    image->UVs.UV[0] = glm::vec2((position.pos.x) / 4096.0f, 1.f - ((position.pos.y) / 4096.0f)); //0,1
-    image->UVs.UV[1] = glm::vec2((position.pos.x + image->width) / 4096.0f, 1.f - ((position.pos.y) / 4096.0f)); //1, 1
-    image->UVs.UV[2] = glm::vec2((position.pos.x) / 4096.0f, 1.f - ((position.pos.y + image->height) / 4096.0f)); //0, 0
-    image->UVs.UV[3] = glm::vec2((position.pos.x + image->width) / 4096.0f, 1.f - ((position.pos.y + image->height) / 4096.0f)); //1, 0
+    image->TextureID = this->TextureIdentifiers[Page];
+    image->Page = Page;
+    image->Layer = (this->Target == GL_TEXTURE_2D_ARRAY) ? Page : 0;
 
-    image->TextureID = position.Dest;
+    if(__GLOBAL_TEXTURE_RESIDENCY)
+        __GLOBAL_TEXTURE_RESIDENCY->Track(image);
 
     return 0;
 }
-int TextureAtlas::RemoveImage(Texture2D* image){
-    FAULT("NOT IMPLEMENTED YET");
+int TextureAtlas::AddImage(Texture2D* image){
+    Atlas_Image_Location position = {};
+
+    if(this->PlaceImage(image, position)){
+        return -1;
+    }
+
+    this->CopyImageData(position.Dest, position.index, image->Data, position.pos, glm::ivec2(image->width, image->height));
+
+    image->State = TEXTURE_READY;
+
     return 0;
 }
+int TextureAtlas::RemoveImage(Texture2D* image){
+    //Stop handing the texture out for its old path
+    auto found = this->Textures.find(image->FilePath);
+    if(found != this->Textures.end() && found->second == image)
+        this->Textures.erase(found);
+
+    if(__GLOBAL_TEXTURE_RESIDENCY)
+        __GLOBAL_TEXTURE_RESIDENCY->Untrack(image);
+
+    return this->FreeSpace(image);
+}
 
 int TextureAtlas::Toggle(Texture2D* image){
-    int index = 0;
-    for (auto i = this->Texture2DIdentifiers.begin(); i != this->Texture2DIdentifiers.end(); i++){
-        for (auto j = (*i).begin(); j != (*i).end(); j++){
-            if((*j).Texture == image){
-                glBindTexture(GL_TEXTURE_2D, 0);
-                glActiveTexture(0);
-
-                this->Bound = (*(std::next(this->TextureIdentifiers.begin(), index)));
-                glBindTexture(GL_TEXTURE_2D, this->Bound);
-                glActiveTexture(GL_TEXTURE0 + this->Bound);
-                return 0;
-            }
+    //The texture already knows which page it is on
+    if(image->Page < 0){
+        return -1;
+    }
+
+    //Pages keep their unit so this is normally skipped by the cache
+    image->Unit = BindCache.AssignUnit(image->TextureID);
+    BindCache.Bind(image->Unit, GL_TEXTURE_2D, image->TextureID);
+
+    this->Bound = image->TextureID;
+
+    return 0;
+}
+
+TextureArrayAtlas::TextureArrayAtlas(int InitialLayers)
+    : TextureAtlas(GL_TEXTURE_2D_ARRAY)
+{
+    //Reserve the first layers up front so small projects never grow the array
+    this->LayerCapacity = (InitialLayers > 0) ? InitialLayers : 1;
+    this->ArrayID = this->CreateNewImage();
+
+    this->AddPage();
+}
+TextureArrayAtlas::~TextureArrayAtlas(){
+    if(this->ArrayID){
+        BindCache.Forget(this->ArrayID);
+        glDeleteTextures(1, &this->ArrayID);
+    }
+
+    //Every page shares the array so stop the base from deleting it again
+    this->TextureIdentifiers.clear();
+}
+
+GLuint TextureArrayAtlas::CreateNewImage(){
+    GLuint id;
+    glGenTextures(1, &id);
+
+    BindCache.Bind(TEXTURE_SCRATCH_UNIT, GL_TEXTURE_2D_ARRAY, id);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, this->CPUMips ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+
+    if(this->Compression){
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, this->MipLevels - 1);
+
+        for(int level = 0; level < this->MipLevels; level++){
+            int size = std::max(ATLAS_PAGE_SIZE >> level, 1);
+            glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, CompressedInternalFormat(this->Compression), size, size, this->LayerCapacity, 0, CompressedImageSize(this->Compression, size, size) * this->LayerCapacity, nullptr);
         }
 
-        index++;
+        return id;
     }
 
-    return 0;
+    std::vector<GLubyte> emptyData(ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE * 4, 0);
+
+    //CPU mips allocate and clear every level rather than filtering empty layers
+    int levels = this->CPUMips ? this->MipLevels : 1;
+
+    for(int level = 0; level < levels; level++){
+        int size = std::max(ATLAS_PAGE_SIZE >> level, 1);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA, size, size, this->LayerCapacity, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+        //Clear each layer so unused space is transparent
+        for(int i = 0; i < this->LayerCapacity; i++){
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, i, size, size, 1, GL_RGBA, GL_UNSIGNED_BYTE, &emptyData[0]);
+        }
+    }
+
+    if(!this->CPUMips)
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+    return id;
 }
 
-Texture2D* TextureAtlas::CheckExists(std::string FilePath){
-    for (auto x : this->Texture2DIdentifiers){
-        for (auto y : x){
-            if (y.Texture->FilePath == FilePath){
-                return y.Texture;
+int TextureArrayAtlas::AddPage(){
+    int layer = this->TextureIdentifiers.size();
+
+    //Grow the array when it is full, layers are copied across on the GPU where possible
+    if(layer >= this->LayerCapacity){
+        GLint maxLayers = 0;
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+
+        if(layer >= maxLayers){
+            FAULT("ATLAS ARRAY LAYER LIMIT REACHED: ", maxLayers);
+            return -1;
+        }
+
+        GLuint oldID = this->ArrayID;
+
+        this->LayerCapacity = std::min(this->LayerCapacity * 2, (int)maxLayers);
+        this->ArrayID = this->CreateNewImage();
+
+        if(this->UsesShadow()){
+            //Every level is already in the page copies, nothing needs filtering again
+            for(int page = 0; page < layer; page++){
+                for(int level = 0; level < this->MipLevels; level++){
+                    int size = std::max(ATLAS_PAGE_SIZE >> level, 1);
+                    this->UploadShadow(page, level, glm::ivec4(0, 0, size, size));
+                }
+            }
+        }
+        else if(GLAD_GL_VERSION_4_3){
+            glCopyImageSubData(oldID, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, this->ArrayID, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, layer);
+        }
+        else{
+            std::vector<GLubyte> layerData((size_t)ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE * 4 * layer);
+
+            BindCache.Bind(TEXTURE_SCRATCH_UNIT, GL_TEXTURE_2D_ARRAY, oldID);
+            glGetTexImage(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, GL_UNSIGNED_BYTE, &layerData[0]);
+
+            BindCache.Bind(TEXTURE_SCRATCH_UNIT, GL_TEXTURE_2D_ARRAY, this->ArrayID);
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, layer, GL_RGBA, GL_UNSIGNED_BYTE, &layerData[0]);
+        }
+
+        if(!this->UsesShadow()){
+            BindCache.Bind(TEXTURE_SCRATCH_UNIT, GL_TEXTURE_2D_ARRAY, this->ArrayID);
+            glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        }
+
+        BindCache.Forget(oldID);
+        glDeleteTextures(1, &oldID);
+
+        //Re-point everything at the new array
+        for (auto i = this->TextureIdentifiers.begin(); i != this->TextureIdentifiers.end(); i++){
+            (*i) = this->ArrayID;
+        }
+        for (auto i = this->Texture2DIdentifiers.begin(); i != this->Texture2DIdentifiers.end(); i++){
+            for (auto j = (*i).begin(); j != (*i).end(); j++){
+                (*j).Texture->TextureID = this->ArrayID;
             }
         }
     }
-    return nullptr;
+
+    this->TextureIdentifiers.push_back(this->ArrayID);
+    this->SpaceIdentifiers.push_back(std::list<Atlas_Space_Identifier>{Atlas_Space_Identifier{0, 0, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE}});
+    this->Texture2DIdentifiers.push_back(std::list<Atlas_Texture_Identifier>{});
+    this->PageLocked.push_back(0);
+    this->PageGenerations.push_back(0);
+    this->AddPageShadow(layer);
+
+    return layer;
+}
+
+size_t TextureArrayAtlas::PageBytes(){
+    //Layers are allocated up front
+    return this->TextureBytes(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE) * this->LayerCapacity;
+}
+
+int TextureArrayAtlas::ReleasePage(int Page){
+    //Layers can not be dropped from the array, the whole layer is handed out again instead
+    this->SpaceIdentifiers[Page] = std::list<Atlas_Space_Identifier>{Atlas_Space_Identifier{0, 0, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE}};
+    this->PageLocked[Page] = 0;
+    this->PageGenerations[Page]++;
+
+    return 0;
+}
+
+int TextureArrayAtlas::CopyImageData(GLuint Dest, int Layer, uint8_t* Src, glm::ivec2 Position, glm::ivec2 Size){
+    if(this->UsesShadow()){
+        return this->CopyToShadow(Layer, Src, Position, Size);
+    }
+
+    BindCache.Bind(TEXTURE_SCRATCH_UNIT, GL_TEXTURE_2D_ARRAY, Dest);
+
+    //Only the new region is uploaded, no need to read the layer back
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, Position.x, Position.y, Layer, Size.x, Size.y, 1, GL_RGBA, GL_UNSIGNED_BYTE, Src);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+    return 0;
+}
+
+int TextureArrayAtlas::UploadRegion(int Page, int Level, glm::ivec2 Position, glm::ivec2 Size, const uint8_t* Src, int RowLength){
+    BindCache.Bind(TEXTURE_SCRATCH_UNIT, GL_TEXTURE_2D_ARRAY, this->ArrayID);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, RowLength);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, Level, Position.x, Position.y, Page, Size.x, Size.y, 1, GL_RGBA, GL_UNSIGNED_BYTE, Src);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    return 0;
 }
 
+int TextureArrayAtlas::UploadBlocks(int Page, int Level, glm::ivec2 Position, glm::ivec2 Size, const uint8_t* Blocks){
+    BindCache.Bind(TEXTURE_SCRATCH_UNIT, GL_TEXTURE_2D_ARRAY, this->ArrayID);
+
+    glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, Level, Position.x, Position.y, Page, Size.x, Size.y, 1, CompressedInternalFormat(this->Compression), CompressedImageSize(this->Compression, Size.x, Size.y), Blocks);
+
+    return 0;
+}
+
+int TextureArrayAtlas::Toggle(Texture2D* image){
+    //Every texture lives in the same array so after the first bind this is skipped by the cache
+    image->Unit = BindCache.AssignUnit(this->ArrayID);
+    BindCache.Bind(image->Unit, GL_TEXTURE_2D_ARRAY, this->ArrayID);
+
+    this->Bound = this->ArrayID;
+
+    return 0;
+}
+
+Texture2D* TextureAtlas::CheckExists(std::string FilePath){
+    auto found = this->Textures.find(FilePath);
+
+    if(found == this->Textures.end())
+        return nullptr;
+
+    return found->second;
+}
+
+Texture2D::Texture2D()
+    : UVsr(UVs), TextID(TextureID)
+{
+    //Filled in later by the TextureStreamer
+    this->Data = nullptr;
+    this->width = 0;
+    this->height = 0;
+    this->TextureID = 0;
+}
 Texture2D::Texture2D(std::string FilePath)
     : UVsr(UVs), TextID(TextureID)
 {
@@ -223,12 +714,14 @@ Texture2D::Texture2D(std::string FilePath)
 
     if(!Data){
         FAULT("COULD NOT AQUIRE DATA: ", this->FilePath.c_str());
+        this->State = TEXTURE_FAILED;
         return;
     }
 
     __GLOBAL_ATLAS->AddImage(this);
 
     SOIL_free_image_data(this->Data);
+    this->Data = nullptr;
 }
 Texture2D::Texture2D(uint8_t* Data, int width, int height)
     : UVsr(UVs), TextID(TextureID)
@@ -240,6 +733,7 @@ Texture2D::Texture2D(uint8_t* Data, int width, int height)
 
     if(!Data){
         FAULT("COULD NOT READ DATA");
+        this->State = TEXTURE_FAILED;
         return;
     }
 
@@ -248,16 +742,21 @@ Texture2D::Texture2D(uint8_t* Data, int width, int height)
     this->height = height;
 
     __GLOBAL_ATLAS->AddImage(this);
+
+    //Copied into the atlas, the caller keeps the buffer
+    this->Data = nullptr;
 }
 Texture2D::~Texture2D(){
+    //The streamer would upload into it after it is gone
+    if(this->State == TEXTURE_PENDING && __GLOBAL_TEXTURE_STREAMER)
+        __GLOBAL_TEXTURE_STREAMER->Cancel(this);
+
     if(!__GLOBAL_ATLAS){
         FAULT("ERROR NO ATLAS");
         return;
     }
 
     __GLOBAL_ATLAS->RemoveImage(this);
-
-    delete this->Data;
 }
 
 int Texture2D::UpdateTeture(std::string FilePath){
@@ -280,6 +779,7 @@ int Texture2D::UpdateTeture(std::string FilePath){
     __GLOBAL_ATLAS->AddImage(this);
 
     SOIL_free_image_data(this->Data);
+    this->Data = nullptr;
 
     return 0;
 }
@@ -302,6 +802,7 @@ int Texture2D::UpdateTeture(uint8_t* Data, int width, int height){
 
     __GLOBAL_ATLAS->AddImage(this);
 
+    this->Data = nullptr;
 
     return 0;
 }
@@ -312,6 +813,14 @@ int Texture2D::Bind(){
         return -1;
     }
 
+    if(__GLOBAL_TEXTURE_RESIDENCY){
+        //Evicted textures come back the first time something draws them
+        if(this->State == TEXTURE_EVICTED)
+            __GLOBAL_TEXTURE_RESIDENCY->Restore(this);
+
+        __GLOBAL_TEXTURE_RESIDENCY->Touch(this);
+    }
+
     __GLOBAL_ATLAS->Toggle(this);
 
     return 0;
@@ -333,10 +842,10 @@ void Texture2D::operator=(TextureAtlas* Atlas){
 
 #include <filesystem>
 
-std::string GetFullPath(const std::string& filePath) {
+std::string UnifiedEngine::GetFullPath(const std::string& filePath) {
     try {
-        // Convert the given path to an absolute path
-        std::filesystem::path path = std::filesystem::absolute(filePath);
+        // Convert the given path to a canonical absolute path so "./a/../b.png" and "b.png" match
+        std::filesystem::path path = std::filesystem::weakly_canonical(std::filesystem::absolute(filePath));
         return path.string(); // Return as a std::string
     } catch (const std::filesystem::filesystem_error& e) {
         std::cerr << "Error resolving full path: " << e.what() << std::endl;
@@ -346,7 +855,24 @@ std::string GetFullPath(const std::string& filePath) {
 
 Texture2D* UnifiedEngine::LoadTexture(std::string FilePath){
     if (Texture2D* texture = __GLOBAL_ATLAS->CheckExists(GetFullPath(FilePath)); texture){
+        if(texture->State == TEXTURE_EVICTED && __GLOBAL_TEXTURE_RESIDENCY)
+            __GLOBAL_TEXTURE_RESIDENCY->Restore(texture);
+
+        return texture;
+    }
+
+    //Cooked packs skip decoding entirely
+    if (Texture2D* texture = FindPackedTexture(GetFullPath(FilePath)); texture){
         return texture;
     }
+
+    //Coalesce with an async load of the same file rather than decoding it twice
+    if (__GLOBAL_TEXTURE_STREAMER){
+        if (Texture2D* texture = __GLOBAL_TEXTURE_STREAMER->CheckInFlight(GetFullPath(FilePath)); texture){
+            __GLOBAL_TEXTURE_STREAMER->Finish(texture);
+            return texture;
+        }
+    }
+
     return new Texture2D(GetFullPath(FilePath));
 }
\ No newline at end of file
@@ -1,20 +1,52 @@
 #include <Unified-Engine/Objects/gameObject.h>
+#include <Unified-Engine/Objects/Mesh/meshOptimize.h>
+#include <Unified-Engine/Core/Spatial/aabbTree.h>
 #include <Unified-Engine/Core/instance.h>
 #include <Unified-Engine/debug.h>
+#include <algorithm>
+#include <cmath>
 
 using namespace UnifiedEngine;
 
 int GameObject::GenerateVAOBuffers(){
+    if(this->mesh.Layout == VERTEX_LAYOUT_FULL)
+        return this->GenerateVAOBuffers(this->mesh.vertices.data(), this->mesh.vertices.size(), this->mesh.indices.data(), this->mesh.indices.size(), GL_UNSIGNED_INT, VERTEX_LAYOUT_FULL);
+
+    //Compact layouts are quantized against the bounds
+    if(!this->mesh.GeneratedAABB)
+        this->mesh.GeneratedAABB = computeBounds(&this->mesh);
+
+    std::vector<CompactVertex> packed(this->mesh.vertices.size());
+    for(size_t i = 0; i < packed.size(); i++){
+        packed[i] = PackVertex(this->mesh.vertices[i], this->mesh.Layout, *this->mesh.GeneratedAABB);
+    }
+
+    return this->GenerateVAOBuffers(packed.data(), packed.size(), this->mesh.indices.data(), this->mesh.indices.size(), GL_UNSIGNED_INT, this->mesh.Layout);
+}
+
+int GameObject::GenerateVAOBuffers(const void* Vertices, size_t VertexCount, const void* Indices, size_t IndexCount, GLenum IndexType, VertexLayout Layout){
     //Test if already generated and if so clear all the buffers
     if (this->VAO) {
-        glDeleteBuffers(1, &this->VAO);
+        glDeleteVertexArrays(1, &this->VAO);
         glDeleteBuffers(1, &this->VBO);
 
         //Clear EBO Buffer as well (Uses this method to stop problems if mesh is updated to not have indicices)
         if (this->EBO)
             glDeleteBuffers(1, &this->EBO);
+
+        this->EBO = 0;
     }
 
+    this->VertexCount = VertexCount;
+    this->IndexCount = IndexCount;
+    this->IndexType = IndexType;
+    this->Layout = Layout;
+
+    if(this->mesh.GeneratedAABB)
+        VertexDequantization(Layout, *this->mesh.GeneratedAABB, this->MeshOffset, this->MeshScale);
+    else
+        VertexDequantization(Layout, AABB{}, this->MeshOffset, this->MeshScale);
+
     //Create new buffers
     glGenVertexArrays(1, &this->VAO);
     glBindVertexArray(this->VAO);
@@ -23,28 +55,47 @@ int GameObject::GenerateVAOBuffers(){
     glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
 
     //Copy new buffer data
-    glBufferData(GL_ARRAY_BUFFER, this->mesh.vertices.size() * sizeof(Vertex), this->mesh.vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, VertexCount * VertexStride(Layout), Vertices, GL_STATIC_DRAW);
 
     //If we use indicies for vertexes then we need to create a EBO buffer
-    if (this->mesh.indices.size() > 0) {
+    if (IndexCount > 0) {
         glGenBuffers(1, &this->EBO);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->EBO);
 
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, this->mesh.indices.size() * sizeof(GLuint), this->mesh.indices.data(), GL_STATIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, IndexCount * ((IndexType == GL_UNSIGNED_SHORT) ? sizeof(GLushort) : sizeof(GLuint)), Indices, GL_STATIC_DRAW);
     }
 
     //Split Data
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, position));
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, color));
-    glEnableVertexAttribArray(1);
-    
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, uv));
-    glEnableVertexAttribArray(2);
-
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, normal));
-    glEnableVertexAttribArray(3);
+    if (Layout == VERTEX_LAYOUT_FULL) {
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, position));
+        glEnableVertexAttribArray(0);
+
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, color));
+        glEnableVertexAttribArray(1);
+        
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, uv));
+        glEnableVertexAttribArray(2);
+
+        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, normal));
+        glEnableVertexAttribArray(3);
+    }
+    else {
+        //Same locations, the shader scales positions by MeshOffset/MeshScale and unfolds the normal
+        if (Layout == VERTEX_LAYOUT_COMPACT)
+            glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(CompactVertex), (GLvoid*)offsetof(CompactVertex, position));
+        else
+            glVertexAttribPointer(0, 3, GL_HALF_FLOAT, GL_FALSE, sizeof(CompactVertex), (GLvoid*)offsetof(CompactVertex, position));
+        glEnableVertexAttribArray(0);
+
+        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(CompactVertex), (GLvoid*)offsetof(CompactVertex, color));
+        glEnableVertexAttribArray(1);
+
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(CompactVertex), (GLvoid*)offsetof(CompactVertex, uv));
+        glEnableVertexAttribArray(2);
+
+        glVertexAttribPointer(3, 2, GL_SHORT, GL_TRUE, sizeof(CompactVertex), (GLvoid*)offsetof(CompactVertex, normal));
+        glEnableVertexAttribArray(3);
+    }
 
     //Unbind for use with other objects
     glBindVertexArray(0);
@@ -90,8 +141,32 @@ GameObject::GameObject(GameObject* _parent, Mesh _mesh, ShaderObject* _shader)
         this->GenerateVAOBuffers();
 }
 
+GameObject::GameObject(const MeshFile& _mesh, ShaderObject* _shader)
+    : ObjectComponent(nullptr, OBJECT_GAME_OBJECT)
+{
+    //Initialse Values
+    this->shader = _shader;
+
+    this->transformOld = this->transform;
+
+    if(this->shader){
+        this->shader->Parent = this;
+        this->NoShader = false;
+    }
+
+    this->ReplaceMesh(_mesh);
+}
+
 GameObject::~GameObject(){
+    this->ReleaseSpatial();
+
+    if (this->VAO) {
+        glDeleteVertexArrays(1, &this->VAO);
+        glDeleteBuffers(1, &this->VBO);
 
+        if (this->EBO)
+            glDeleteBuffers(1, &this->EBO);
+    }
 }
 
 glm::mat4 CalculateModelMatrix(Transform transform, glm::vec3 origin){
@@ -110,18 +185,69 @@ glm::mat4 CalculateModelMatrix(Transform transform, glm::vec3 origin){
     return Matrix;
 }
 
-int GameObject::ReplaceMesh(Mesh newMesh){
+int GameObject::ReplaceMesh(Mesh newMesh, bool Optimize){
     //Initialse Values
     this->mesh = std::move(newMesh);
 
+    if(Optimize && this->mesh.indices.size() && OptimizeMesh(this->mesh, false))
+        return -1;
+
     if(this->mesh.vertices.size())
         this->GenerateVAOBuffers();
+    else
+        this->VertexCount = 0;
+
+    return 0;
+}
+
+int GameObject::ReplaceMesh(const MeshFile& newMesh){
+    if(!newMesh.IsOpen()){
+        FAULT("MESH FILE IS NOT OPEN");
+        return -1;
+    }
+
+    const MeshFileHeader* info = newMesh.Info();
+
+    //Only the bounds and LOD ranges are kept on the CPU
+    this->mesh = Mesh{};
+    this->mesh.GeneratedAABB = newMesh.Bounds();
+
+    for(uint32_t i = 0; i < info->LODCount; i++){
+        this->mesh.LODs.push_back(MeshLOD{newMesh.LODs()[i].FirstIndex, newMesh.LODs()[i].IndexCount, newMesh.LODs()[i].Error});
+    }
+
+    this->mesh.Layout = newMesh.Layout();
+
+    if(info->VertexCount)
+        return this->GenerateVAOBuffers(newMesh.Vertices(), info->VertexCount, newMesh.Indices(), info->IndexCount, (info->IndexSize == 2) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, this->mesh.Layout);
+
+    this->VertexCount = 0;
+
+    return 0;
 }
 
 int GameObject::Update(){
-    this->ModelMatrix = CalculateModelMatrix(this->transform, this->transform.Position);
+    //Baked objects keep the matrix they were baked with
+    if(!this->Batched)
+        this->ModelMatrix = CalculateModelMatrix(this->transform, this->transform.Position);
     // this->ModelMatrix = CalculateModelMatrix(this->transform, glm::vec3(0.0f));
 
+    //Scene tree, only re-inserted once it leaves its fat box
+    if(__GLOBAL_SCENE_TREE && this->Spatial && (this->VertexCount || this->mesh.vertices.size())){
+        AABB bounds = this->WorldBounds();
+
+        if(this->SpatialProxy < 0)
+            this->SpatialProxy = __GLOBAL_SCENE_TREE->CreateProxy(bounds, (ObjectComponent*)this);
+        else
+            __GLOBAL_SCENE_TREE->MoveProxy(this->SpatialProxy, bounds, this->transform.Position - this->transformOld.Position);
+    }
+    else if(this->SpatialProxy >= 0){
+        this->ReleaseSpatial();
+    }
+
+    if(this->AutoLOD && !this->Batched)
+        this->SelectLOD();
+
     //Children
     this->UpdateC();
 
@@ -135,25 +261,138 @@ int GameObject::Update(){
     return 0;
 }
 
+AABB GameObject::LocalBounds(){
+    if(!this->mesh.GeneratedAABB){
+        if(this->mesh.vertices.empty())
+            return AABB{};
+        this->mesh.GeneratedAABB = computeBounds(&this->mesh);
+    }
+
+    return *this->mesh.GeneratedAABB;
+}
+
+AABB GameObject::WorldBounds(){
+    AABB box = {};
+
+    if(!this->mesh.GeneratedAABB){
+        if(this->mesh.vertices.empty())
+            return box;
+        this->mesh.GeneratedAABB = computeBounds(&this->mesh);
+    }
+
+    //Centre and half size through the matrix, the size takes the absolute of each axis (Arvo)
+    const AABB& local = *this->mesh.GeneratedAABB;
+    glm::vec3 center = glm::vec3(this->ModelMatrix * glm::vec4(local.center(), 1.f));
+    glm::vec3 half = (local.max - local.min) * 0.5f;
+    glm::vec3 extent(0.f);
+
+    for(int i = 0; i < 3; i++){
+        extent[i] = std::abs(this->ModelMatrix[0][i]) * half.x + std::abs(this->ModelMatrix[1][i]) * half.y + std::abs(this->ModelMatrix[2][i]) * half.z;
+    }
+
+    box.min = center - extent;
+    box.max = center + extent;
+
+    return box;
+}
+
+int GameObject::ReleaseSpatial(){
+    if(this->SpatialProxy >= 0 && __GLOBAL_SCENE_TREE)
+        __GLOBAL_SCENE_TREE->DestroyProxy(this->SpatialProxy);
+
+    this->SpatialProxy = -1;
+
+    return 0;
+}
+
+int GameObject::SelectLOD(){
+    if(this->mesh.LODs.size() < 2)
+        return 0;
+
+    if(!this->mesh.GeneratedAABB){
+        if(this->mesh.vertices.empty())
+            return 0;
+        this->mesh.GeneratedAABB = computeBounds(&this->mesh);
+    }
+
+    Camera* camera = __GAME__GLOBAL__INSTANCE__->GetMainCamera();
+    if(!camera || __GAME__GLOBAL__INSTANCE__->__windows.empty())
+        return -1;
+
+    //Bounding sphere in world space, errors scale with the largest axis
+    const AABB& box = *this->mesh.GeneratedAABB;
+    glm::vec3 center = glm::vec3(this->ModelMatrix * glm::vec4((box.min + box.max) * 0.5f, 1.f));
+    float scale = std::max(glm::length(glm::vec3(this->ModelMatrix[0])), std::max(glm::length(glm::vec3(this->ModelMatrix[1])), glm::length(glm::vec3(this->ModelMatrix[2]))));
+    float radius = glm::length(box.max - box.min) * 0.5f * scale;
+
+    float distance = std::max(glm::length(center - camera->transform.Position) - radius, camera->NearPlane);
+
+    //Pixels one unit covers at that distance
+    float height = (float)__GAME__GLOBAL__INSTANCE__->__windows.front()->Config().res_y;
+    float pixels = height / (2.f * std::tan(glm::radians(camera->FOV) * 0.5f) * distance);
+
+    int current = std::clamp(this->LOD, 0, (int)this->mesh.LODs.size() - 1);
+    int target = 0;
+
+    //Errors only grow down the chain, dropping below the current LOD needs the hysteresis margin
+    for(int i = 1; i < (int)this->mesh.LODs.size(); i++){
+        float limit = __GLOBAL_CONFIG__.LODPixelError;
+        if(i > current)
+            limit *= 1.f - __GLOBAL_CONFIG__.LODHysteresis;
+
+        if(this->mesh.LODs[i].Error * scale * pixels > limit)
+            break;
+
+        target = i;
+    }
+
+    this->LOD = target;
+
+    return 0;
+}
+
 int GameObject::Render(){
-    if (this->Enabled) {
-        //Update Shader Values
-        if(this->shader)
+    if (this->Enabled && this->Batched) {
+        //The batch draws the mesh
+        this->RenderC();
+    }
+    else if (this->Enabled && this->SpatialProxy >= 0 && !this->InView) {
+        //Outside the camera, only the children might be seen
+        this->RenderC();
+    }
+    else if (this->Enabled) {
+        this->InView = false;
+
+        //Update Shader Values (Shader objects can be shared, arguments come from whoever draws)
+        if(this->shader){
+            this->shader->Parent = this;
             this->shader->PassArgs();
+        }
 
         //Load Shader
         if(this->shader)
             this->shader->Toggle();
 
-        if(this->mesh.vertices.size()){
+        if(this->VertexCount){
             //Bind Buffers
             glBindVertexArray(this->VAO);
             
             //Use Method Based on Indicies or not
-            if (this->mesh.indices.size() > 0)
-                glDrawElements(GL_TRIANGLES, this->mesh.indices.size(), GL_UNSIGNED_INT, 0);
+            if (this->IndexCount > 0){
+                GLuint first = 0;
+                GLsizei count = this->IndexCount;
+
+                if(this->mesh.LODs.size()){
+                    const MeshLOD& lod = this->mesh.LODs[std::clamp(this->LOD, 0, (int)this->mesh.LODs.size() - 1)];
+                    first = lod.FirstIndex;
+                    count = lod.IndexCount;
+                }
+
+                size_t indexSize = (this->IndexType == GL_UNSIGNED_SHORT) ? sizeof(GLushort) : sizeof(GLuint);
+                glDrawElements(GL_TRIANGLES, count, this->IndexType, (GLvoid*)(first * indexSize));
+            }
             else
-                glDrawArrays(GL_TRIANGLES, 0, this->mesh.vertices.size());
+                glDrawArrays(GL_TRIANGLES, 0, this->VertexCount);
 
             //Clearing
             glBindVertexArray(0);
@@ -1,11 +1,122 @@
 #include <Unified-Engine/Objects/Mesh/mesh.h>
+#include <GLM/gtc/packing.hpp>
+#include <algorithm>
+#include <cmath>
 
 UnifiedEngine::AABB* UnifiedEngine::computeAABB(const UnifiedEngine::Mesh* mesh)
 {
-    UnifiedEngine::AABB* box = new UnifiedEngine::AABB{};
+    return new UnifiedEngine::AABB(UnifiedEngine::computeBounds(mesh));
+}
+
+UnifiedEngine::AABB UnifiedEngine::computeBounds(const UnifiedEngine::Mesh* mesh)
+{
+    UnifiedEngine::AABB box = {};
     for (const auto& vertex : mesh->vertices)
     {
-        box->expand(vertex.position);
+        box.expand(vertex.position);
     }
     return box;
-}
\ No newline at end of file
+}
+
+size_t UnifiedEngine::VertexStride(UnifiedEngine::VertexLayout Layout)
+{
+    return (Layout == UnifiedEngine::VERTEX_LAYOUT_FULL) ? sizeof(UnifiedEngine::Vertex) : sizeof(UnifiedEngine::CompactVertex);
+}
+
+void UnifiedEngine::VertexDequantization(UnifiedEngine::VertexLayout Layout, const UnifiedEngine::AABB& Bounds, glm::vec3& Offset, glm::vec3& Scale)
+{
+    Offset = glm::vec3(0.f);
+    Scale = glm::vec3(1.f);
+
+    //Only quantized positions are relative to the bounds
+    if (Layout == UnifiedEngine::VERTEX_LAYOUT_COMPACT && Bounds.min.x <= Bounds.max.x)
+    {
+        Offset = Bounds.min;
+        Scale = Bounds.max - Bounds.min;
+    }
+}
+
+static inline uint16_t PackUnorm16(float v)
+{
+    return (uint16_t)std::lround(std::clamp(v, 0.f, 1.f) * 65535.f);
+}
+
+static inline int16_t PackSnorm16(float v)
+{
+    return (int16_t)std::lround(std::clamp(v, -1.f, 1.f) * 32767.f);
+}
+
+static inline float UnpackSnorm16(int16_t v)
+{
+    return std::max(v / 32767.f, -1.f);
+}
+
+UnifiedEngine::CompactVertex UnifiedEngine::PackVertex(const UnifiedEngine::Vertex& vertex, UnifiedEngine::VertexLayout Layout, const UnifiedEngine::AABB& Bounds)
+{
+    UnifiedEngine::CompactVertex packed = {};
+
+    glm::vec3 offset, scale;
+    UnifiedEngine::VertexDequantization(Layout, Bounds, offset, scale);
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (Layout == UnifiedEngine::VERTEX_LAYOUT_COMPACT)
+            packed.position[i] = PackUnorm16(scale[i] > 0.f ? (vertex.position[i] - offset[i]) / scale[i] : 0.f);
+        else
+            packed.position[i] = glm::packHalf1x16(vertex.position[i]);
+    }
+
+    for (int i = 0; i < 3; i++)
+        packed.color[i] = (uint8_t)std::lround(std::clamp(vertex.color[i], 0.f, 1.f) * 255.f);
+    packed.color[3] = 255;
+
+    packed.uv[0] = glm::packHalf1x16(vertex.uv.x);
+    packed.uv[1] = glm::packHalf1x16(vertex.uv.y);
+
+    //Octahedral: project onto the octahedron then fold the lower half over the upper
+    glm::vec3 n = vertex.normal;
+    float sum = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    glm::vec2 oct(0.f);
+
+    if (sum > 0.f)
+    {
+        oct = glm::vec2(n.x / sum, n.y / sum);
+
+        if (n.z < 0.f)
+            oct = glm::vec2((1.f - std::abs(oct.y)) * (oct.x >= 0.f ? 1.f : -1.f), (1.f - std::abs(oct.x)) * (oct.y >= 0.f ? 1.f : -1.f));
+    }
+
+    packed.normal[0] = PackSnorm16(oct.x);
+    packed.normal[1] = PackSnorm16(oct.y);
+
+    return packed;
+}
+
+UnifiedEngine::Vertex UnifiedEngine::UnpackVertex(const UnifiedEngine::CompactVertex& vertex, UnifiedEngine::VertexLayout Layout, const UnifiedEngine::AABB& Bounds)
+{
+    UnifiedEngine::Vertex unpacked = {};
+
+    glm::vec3 offset, scale;
+    UnifiedEngine::VertexDequantization(Layout, Bounds, offset, scale);
+
+    for (int i = 0; i < 3; i++)
+    {
+        float stored = (Layout == UnifiedEngine::VERTEX_LAYOUT_COMPACT) ? vertex.position[i] / 65535.f : glm::unpackHalf1x16(vertex.position[i]);
+        unpacked.position[i] = offset[i] + (stored * scale[i]);
+        unpacked.color[i] = vertex.color[i] / 255.f;
+    }
+
+    unpacked.uv = glm::vec2(glm::unpackHalf1x16(vertex.uv[0]), glm::unpackHalf1x16(vertex.uv[1]));
+
+    //Same decode as the standard vertex shader
+    glm::vec3 n(UnpackSnorm16(vertex.normal[0]), UnpackSnorm16(vertex.normal[1]), 0.f);
+    n.z = 1.f - std::abs(n.x) - std::abs(n.y);
+
+    float t = std::max(-n.z, 0.f);
+    n.x += (n.x >= 0.f) ? -t : t;
+    n.y += (n.y >= 0.f) ? -t : t;
+
+    unpacked.normal = glm::normalize(n);
+
+    return unpacked;
+}
@@ -0,0 +1,211 @@
+#include <Unified-Engine/Objects/Mesh/meshFile.h>
+#include <Unified-Engine/debug.h>
+#include <fstream>
+#include <vector>
+#include <cstring>
+
+using namespace UnifiedEngine;
+
+static_assert(sizeof(Vertex) == 44, "MESH_LAYOUT_FULL is a packed Vertex");
+static_assert(sizeof(CompactVertex) == 20, "MESH_LAYOUT_COMPACT is a packed CompactVertex");
+static_assert((int)MESH_LAYOUT_COMPACT == (int)VERTEX_LAYOUT_COMPACT && (int)MESH_LAYOUT_COMPACT_HALF == (int)VERTEX_LAYOUT_COMPACT_HALF, "Mesh file layouts are vertex layouts");
+
+MeshFile::MeshFile(){
+
+}
+MeshFile::MeshFile(const std::string& FilePath){
+    this->Open(FilePath);
+}
+MeshFile::~MeshFile(){
+    this->Close();
+}
+
+int MeshFile::Open(const std::string& FilePath){
+    this->Close();
+
+    if(this->File.Open(FilePath)){
+        return -1;
+    }
+
+    const uint8_t* bytes = this->File.Bytes();
+    size_t length = this->File.Length();
+
+    if(length < sizeof(MeshFileHeader)){
+        FAULT("MESH FILE TOO SMALL: ", FilePath.c_str());
+        this->File.Close();
+        return -1;
+    }
+
+    const MeshFileHeader* header = (const MeshFileHeader*)bytes;
+
+    if(header->Magic != MESH_FILE_MAGIC || header->Version != MESH_FILE_VERSION){
+        FAULT("MESH FILE VERSION MISMATCH, RE-CONVERT: ", FilePath.c_str());
+        this->File.Close();
+        return -1;
+    }
+
+    //Everything has to be inside the file before anything points into it
+    bool valid = header->Layout <= MESH_LAYOUT_COMPACT_HALF && header->VertexStride == VertexStride((VertexLayout)header->Layout)
+        && (header->IndexSize == 2 || header->IndexSize == 4)
+        && header->LODOffset + ((uint64_t)header->LODCount * sizeof(MeshFileLOD)) <= length
+        && header->VertexOffset + ((uint64_t)header->VertexCount * header->VertexStride) <= length
+        && header->IndexOffset + ((uint64_t)header->IndexCount * header->IndexSize) <= length;
+
+    const MeshFileLOD* lods = (const MeshFileLOD*)(bytes + header->LODOffset);
+    for(uint32_t i = 0; valid && i < header->LODCount; i++){
+        valid = (uint64_t)lods[i].FirstIndex + lods[i].IndexCount <= header->IndexCount;
+    }
+
+    if(!valid){
+        FAULT("MESH FILE IS CORRUPT: ", FilePath.c_str());
+        this->File.Close();
+        return -1;
+    }
+
+    this->Header = header;
+
+    return 0;
+}
+
+int MeshFile::Close(){
+    this->Header = nullptr;
+    return this->File.Close();
+}
+
+AABB MeshFile::Bounds() const{
+    AABB box = {};
+
+    if(this->Header){
+        box.min = glm::vec3(this->Header->Min[0], this->Header->Min[1], this->Header->Min[2]);
+        box.max = glm::vec3(this->Header->Max[0], this->Header->Max[1], this->Header->Max[2]);
+    }
+
+    return box;
+}
+
+int MeshFile::ToMesh(Mesh& Out) const{
+    if(!this->Header){
+        FAULT("MESH FILE IS NOT OPEN");
+        return -1;
+    }
+
+    AABB bounds = this->Bounds();
+
+    Out.Layout = this->Layout();
+    Out.vertices.resize(this->Header->VertexCount);
+    if(Out.Layout == VERTEX_LAYOUT_FULL){
+        std::memcpy(Out.vertices.data(), this->Vertices(), this->VertexBytes());
+    }
+    else{
+        const CompactVertex* vertices = (const CompactVertex*)this->Vertices();
+        for(uint32_t i = 0; i < this->Header->VertexCount; i++){
+            Out.vertices[i] = UnpackVertex(vertices[i], Out.Layout, bounds);
+        }
+    }
+
+    Out.indices.resize(this->Header->IndexCount);
+    if(this->Header->IndexSize == 4){
+        std::memcpy(Out.indices.data(), this->Indices(), this->IndexBytes());
+    }
+    else{
+        const uint16_t* indices = (const uint16_t*)this->Indices();
+        for(uint32_t i = 0; i < this->Header->IndexCount; i++){
+            Out.indices[i] = indices[i];
+        }
+    }
+
+    Out.LODs.clear();
+    for(uint32_t i = 0; i < this->Header->LODCount; i++){
+        Out.LODs.push_back(MeshLOD{this->LODs()[i].FirstIndex, this->LODs()[i].IndexCount, this->LODs()[i].Error});
+    }
+
+    Out.GeneratedAABB = bounds;
+
+    return 0;
+}
+
+int UnifiedEngine::WriteMeshFile(const std::string& FilePath, const Mesh& mesh){
+    MeshFileHeader header = {};
+    header.Magic = MESH_FILE_MAGIC;
+    header.Version = MESH_FILE_VERSION;
+    header.Layout = mesh.Layout;
+    header.VertexStride = VertexStride(mesh.Layout);
+    header.VertexCount = mesh.vertices.size();
+    header.IndexSize = (mesh.vertices.size() <= 65536) ? 2 : 4;
+    header.IndexCount = mesh.indices.size();
+
+    //Without LODs the whole index buffer is LOD 0
+    std::vector<MeshFileLOD> lods;
+    for (auto i = mesh.LODs.begin(); i != mesh.LODs.end(); i++){
+        lods.push_back(MeshFileLOD{(*i).FirstIndex, (*i).IndexCount, (*i).Error, 0});
+    }
+    if(lods.empty())
+        lods.push_back(MeshFileLOD{0, (uint32_t)mesh.indices.size(), 0.f, 0});
+
+    header.LODCount = lods.size();
+
+    AABB box = {};
+    for (auto i = mesh.vertices.begin(); i != mesh.vertices.end(); i++){
+        box.expand((*i).position);
+    }
+    if(mesh.vertices.empty())
+        box.min = box.max = glm::vec3(0.f);
+
+    for(int i = 0; i < 3; i++){
+        header.Min[i] = box.min[i];
+        header.Max[i] = box.max[i];
+    }
+
+    header.LODOffset = MeshFileAlign(sizeof(MeshFileHeader));
+    header.VertexOffset = MeshFileAlign(header.LODOffset + (lods.size() * sizeof(MeshFileLOD)));
+    header.IndexOffset = MeshFileAlign(header.VertexOffset + (mesh.vertices.size() * header.VertexStride));
+
+    std::ofstream file(FilePath, std::ios::binary | std::ios::trunc);
+    if(!file){
+        FAULT("COULD NOT OPEN OUTPUT: ", FilePath.c_str());
+        return -1;
+    }
+
+    //Pads to the next section
+    uint64_t written = 0;
+    auto Write = [&file, &written](const void* Data, size_t Size){
+        file.write((const char*)Data, Size);
+        written += Size;
+    };
+    auto Pad = [&Write, &written](uint64_t Offset){
+        std::vector<char> padding(Offset - written, 0);
+        Write(padding.data(), padding.size());
+    };
+
+    Write(&header, sizeof(header));
+    Pad(header.LODOffset);
+    Write(lods.data(), lods.size() * sizeof(MeshFileLOD));
+    Pad(header.VertexOffset);
+    if(mesh.Layout == VERTEX_LAYOUT_FULL){
+        Write(mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex));
+    }
+    else{
+        //Quantized against the same bounds the header stores
+        std::vector<CompactVertex> vertices(mesh.vertices.size());
+        for(size_t i = 0; i < vertices.size(); i++){
+            vertices[i] = PackVertex(mesh.vertices[i], mesh.Layout, box);
+        }
+        Write(vertices.data(), vertices.size() * sizeof(CompactVertex));
+    }
+    Pad(header.IndexOffset);
+
+    if(header.IndexSize == 4){
+        Write(mesh.indices.data(), mesh.indices.size() * sizeof(GLuint));
+    }
+    else{
+        std::vector<uint16_t> indices(mesh.indices.begin(), mesh.indices.end());
+        Write(indices.data(), indices.size() * sizeof(uint16_t));
+    }
+
+    if(!file){
+        FAULT("FAILED WRITING: ", FilePath.c_str());
+        return -1;
+    }
+
+    return 0;
+}
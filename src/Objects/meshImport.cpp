@@ -0,0 +1,936 @@
+#include <Unified-Engine/Objects/Mesh/meshImport.h>
+#include <Unified-Engine/Utility/mappedFile.h>
+#include <Unified-Engine/Core/threadPool.h>
+#include <Unified-Engine/debug.h>
+#include <GLM/mat4x4.hpp>
+#include <GLM/mat3x3.hpp>
+#include <GLM/gtc/quaternion.hpp>
+#include <string_view>
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+
+using namespace UnifiedEngine;
+
+//Runs on the worker pool when there is one
+static void ForRanges(size_t Count, size_t Grain, const std::function<void(size_t Begin, size_t End)>& Job){
+    if(__GLOBAL_THREAD_POOL)
+        __GLOBAL_THREAD_POOL->ParallelFor(Count, Grain, Job);
+    else if(Count)
+        Job(0, Count);
+}
+
+// ---------------------------------------------------------------- OBJ
+
+//Parsing works on the mapping directly, a cursor never goes past End
+struct OBJCursor{
+    const char* At;
+    const char* End;
+};
+
+static inline void SkipSpaces(OBJCursor& c){
+    while(c.At < c.End && (*c.At == ' ' || *c.At == '\t' || *c.At == '\r'))
+        c.At++;
+}
+
+static inline void SkipLine(OBJCursor& c){
+    const char* next = (const char*)std::memchr(c.At, '\n', c.End - c.At);
+    c.At = next ? next + 1 : c.End;
+}
+
+static inline bool ReadFloat(OBJCursor& c, float& Out){
+    SkipSpaces(c);
+
+    //from_chars does not take a leading '+'
+    if(c.At < c.End && *c.At == '+')
+        c.At++;
+
+    auto result = std::from_chars(c.At, c.End, Out);
+    if(result.ec != std::errc())
+        return false;
+
+    c.At = result.ptr;
+    return true;
+}
+
+static inline bool ReadIndex(OBJCursor& c, int32_t& Out){
+    auto result = std::from_chars(c.At, c.End, Out);
+    if(result.ec != std::errc())
+        return false;
+
+    c.At = result.ptr;
+    return true;
+}
+
+//A face corner before the chunk knows where its elements start
+//Negative OBJ indices are stored already resolved against the chunk, Relative marks which ones still need the chunk's base
+struct OBJRawCorner{
+    int32_t Position;
+    int32_t UV;
+    int32_t Normal;
+    uint32_t Relative; //Bit 0 position, 1 uv, 2 normal
+};
+
+//Resolved, 1 based (0 = missing)
+struct OBJCorner{
+    uint32_t Position;
+    uint32_t UV;
+    uint32_t Normal;
+
+    inline bool operator==(const OBJCorner& Other) const{
+        return this->Position == Other.Position && this->UV == Other.UV && this->Normal == Other.Normal;
+    }
+};
+
+static inline uint64_t HashCorner(const OBJCorner& Corner){
+    uint64_t h = ((uint64_t)Corner.Position * 0x9E3779B97F4A7C15ull) ^ ((uint64_t)Corner.UV * 0xC2B2AE3D27D4EB4Full) ^ ((uint64_t)Corner.Normal * 0x165667B19E3779F9ull);
+    return h ^ (h >> 29);
+}
+
+struct OBJChunk{
+    const char* Begin;
+    const char* End;
+
+    std::vector<glm::vec3> Positions;
+    std::vector<glm::vec3> Colors;
+    std::vector<glm::vec2> UVs;
+    std::vector<glm::vec3> Normals;
+    std::vector<OBJRawCorner> Corners; //Already fanned into triangles
+
+    //Where this chunk's elements start in the whole file
+    size_t PositionBase = 0;
+    size_t UVBase = 0;
+    size_t NormalBase = 0;
+    size_t CornerBase = 0;
+
+    std::vector<std::vector<uint32_t>> Buckets; //Shard -> corners of this chunk it dedups
+};
+
+//Fills everything but the bases, only looks at its own lines
+static void ParseOBJChunk(OBJChunk& Chunk){
+    OBJCursor c = {Chunk.Begin, Chunk.End};
+    std::vector<OBJRawCorner> face;
+
+    while(c.At < c.End){
+        SkipSpaces(c);
+
+        if(c.At + 1 >= c.End){
+            SkipLine(c);
+            continue;
+        }
+
+        char a = c.At[0];
+        char b = c.At[1];
+
+        if(a == 'v' && (b == ' ' || b == '\t')){
+            c.At += 2;
+
+            glm::vec3 position(0.f);
+            glm::vec3 color(1.f);
+            ReadFloat(c, position.x) && ReadFloat(c, position.y) && ReadFloat(c, position.z);
+
+            //Optional vertex colour
+            glm::vec3 extra;
+            if(ReadFloat(c, extra.x) && ReadFloat(c, extra.y) && ReadFloat(c, extra.z))
+                color = extra;
+
+            Chunk.Positions.push_back(position);
+            Chunk.Colors.push_back(color);
+        }
+        else if(a == 'v' && b == 't'){
+            c.At += 2;
+
+            glm::vec2 uv(0.f);
+            ReadFloat(c, uv.x) && ReadFloat(c, uv.y);
+            Chunk.UVs.push_back(uv);
+        }
+        else if(a == 'v' && b == 'n'){
+            c.At += 2;
+
+            glm::vec3 normal(0.f);
+            ReadFloat(c, normal.x) && ReadFloat(c, normal.y) && ReadFloat(c, normal.z);
+            Chunk.Normals.push_back(normal);
+        }
+        else if(a == 'f' && (b == ' ' || b == '\t')){
+            c.At += 2;
+            face.clear();
+
+            //Relative indices count back from what this chunk has seen so far, the base is added later
+            auto Component = [](int32_t Index, size_t Seen, uint32_t Bit, OBJRawCorner& Corner) -> int32_t{
+                if(Index >= 0)
+                    return Index;
+
+                Corner.Relative |= Bit;
+                return (int32_t)Seen + Index + 1;
+            };
+
+            while(true){
+                SkipSpaces(c);
+
+                int32_t index = 0;
+                if(c.At >= c.End || !ReadIndex(c, index))
+                    break;
+
+                OBJRawCorner corner = {0, 0, 0, 0};
+                corner.Position = Component(index, Chunk.Positions.size(), 1, corner);
+
+                if(c.At < c.End && *c.At == '/'){
+                    c.At++;
+                    if(ReadIndex(c, index))
+                        corner.UV = Component(index, Chunk.UVs.size(), 2, corner);
+
+                    if(c.At < c.End && *c.At == '/'){
+                        c.At++;
+                        if(ReadIndex(c, index))
+                            corner.Normal = Component(index, Chunk.Normals.size(), 4, corner);
+                    }
+                }
+
+                face.push_back(corner);
+            }
+
+            //Fan the polygon
+            for(size_t i = 2; i < face.size(); i++){
+                Chunk.Corners.push_back(face[0]);
+                Chunk.Corners.push_back(face[i - 1]);
+                Chunk.Corners.push_back(face[i]);
+            }
+        }
+
+        SkipLine(c);
+    }
+}
+
+//1 based, 0 when missing or out of range
+static inline uint32_t ResolveIndex(int32_t Index, bool Relative, size_t Base, size_t Count){
+    int64_t resolved = Relative ? (int64_t)Base + Index : Index;
+    return (resolved > 0 && resolved <= (int64_t)Count) ? (uint32_t)resolved : 0;
+}
+
+int UnifiedEngine::ImportOBJ(const std::string& FilePath, Mesh& Out){
+    MappedFile file;
+
+    if(file.Open(FilePath)){
+        return -1;
+    }
+
+    const char* begin = (const char*)file.Bytes();
+    const char* end = begin + file.Length();
+
+    //Split on line ends, a few chunks per thread so uneven lines still balance
+    size_t threads = __GLOBAL_THREAD_POOL ? __GLOBAL_THREAD_POOL->WorkerCount() + 1 : 1;
+    size_t chunkCount = std::max<size_t>(1, std::min<size_t>(file.Length() / (1 << 20), threads * 4));
+
+    std::vector<OBJChunk> chunks(chunkCount);
+    const char* at = begin;
+    for(size_t i = 0; i < chunkCount; i++){
+        const char* split = (i + 1 == chunkCount) ? end : begin + ((file.Length() * (i + 1)) / chunkCount);
+
+        if(split < at)
+            split = at;
+        if(split < end){
+            const char* newline = (const char*)std::memchr(split, '\n', end - split);
+            split = newline ? newline + 1 : end;
+        }
+
+        chunks[i].Begin = at;
+        chunks[i].End = split;
+        at = split;
+    }
+
+    ForRanges(chunkCount, 1, [&](size_t Begin, size_t End){
+        for(size_t i = Begin; i < End; i++){
+            ParseOBJChunk(chunks[i]);
+        }
+    });
+
+    //Element offsets of each chunk
+    size_t positionCount = 0;
+    size_t uvCount = 0;
+    size_t normalCount = 0;
+    size_t cornerCount = 0;
+
+    for (auto i = chunks.begin(); i != chunks.end(); i++){
+        (*i).PositionBase = positionCount;
+        (*i).UVBase = uvCount;
+        (*i).NormalBase = normalCount;
+        (*i).CornerBase = cornerCount;
+
+        positionCount += (*i).Positions.size();
+        uvCount += (*i).UVs.size();
+        normalCount += (*i).Normals.size();
+        cornerCount += (*i).Corners.size();
+    }
+
+    if(!cornerCount){
+        FAULT("OBJ HAS NO FACES: ", FilePath.c_str());
+        return -1;
+    }
+
+    if(cornerCount > UINT32_MAX){
+        FAULT("OBJ HAS TOO MANY FACES: ", FilePath.c_str());
+        return -1;
+    }
+
+    //Shards split the de-duplication by hash so each can run on its own thread
+    size_t shardCount = 1;
+    while(shardCount < threads * 2)
+        shardCount <<= 1;
+
+    int shardShift = 64;
+    for(size_t s = shardCount; s > 1; s >>= 1)
+        shardShift--;
+
+    std::vector<glm::vec3> positions(positionCount);
+    std::vector<glm::vec3> colors(positionCount);
+    std::vector<glm::vec2> uvs(uvCount);
+    std::vector<glm::vec3> normals(normalCount);
+    std::vector<OBJCorner> corners(cornerCount);
+    std::atomic<bool> missing{false};
+
+    ForRanges(chunkCount, 1, [&](size_t Begin, size_t End){
+        for(size_t i = Begin; i < End; i++){
+            OBJChunk& chunk = chunks[i];
+
+            std::copy(chunk.Positions.begin(), chunk.Positions.end(), positions.begin() + chunk.PositionBase);
+            std::copy(chunk.Colors.begin(), chunk.Colors.end(), colors.begin() + chunk.PositionBase);
+            std::copy(chunk.UVs.begin(), chunk.UVs.end(), uvs.begin() + chunk.UVBase);
+            std::copy(chunk.Normals.begin(), chunk.Normals.end(), normals.begin() + chunk.NormalBase);
+
+            chunk.Buckets.assign(shardCount, {});
+
+            for(size_t j = 0; j < chunk.Corners.size(); j++){
+                const OBJRawCorner& raw = chunk.Corners[j];
+
+                OBJCorner corner = {
+                    ResolveIndex(raw.Position, raw.Relative & 1, chunk.PositionBase, positionCount),
+                    ResolveIndex(raw.UV, raw.Relative & 2, chunk.UVBase, uvCount),
+                    ResolveIndex(raw.Normal, raw.Relative & 4, chunk.NormalBase, normalCount)
+                };
+
+                if(!corner.Position)
+                    missing = true;
+
+                uint32_t index = chunk.CornerBase + j;
+                corners[index] = corner;
+                chunk.Buckets[(shardCount > 1) ? (HashCorner(corner) >> shardShift) : 0].push_back(index);
+            }
+
+            //Free as soon as possible, these are the biggest part of the peak
+            std::vector<glm::vec3>().swap(chunk.Positions);
+            std::vector<glm::vec3>().swap(chunk.Colors);
+            std::vector<glm::vec2>().swap(chunk.UVs);
+            std::vector<glm::vec3>().swap(chunk.Normals);
+            std::vector<OBJRawCorner>().swap(chunk.Corners);
+        }
+    });
+
+    //Each shard gives its unique corners local ids with an open addressed table
+    std::vector<std::vector<OBJCorner>> unique(shardCount);
+    std::vector<uint32_t> localIDs(cornerCount);
+
+    ForRanges(shardCount, 1, [&](size_t Begin, size_t End){
+        for(size_t s = Begin; s < End; s++){
+            size_t count = 0;
+            for (auto i = chunks.begin(); i != chunks.end(); i++){
+                count += (*i).Buckets[s].size();
+            }
+
+            size_t capacity = 16;
+            while(capacity < count * 2)
+                capacity <<= 1;
+
+            std::vector<uint32_t> table(capacity, 0); //Local id + 1, 0 is empty
+            size_t mask = capacity - 1;
+
+            //Chunk order keeps the output the same however the work is split
+            for (auto i = chunks.begin(); i != chunks.end(); i++){
+                for (auto j = (*i).Buckets[s].begin(); j != (*i).Buckets[s].end(); j++){
+                    const OBJCorner& corner = corners[(*j)];
+                    size_t slot = HashCorner(corner) & mask;
+
+                    while(table[slot] && !(unique[s][table[slot] - 1] == corner))
+                        slot = (slot + 1) & mask;
+
+                    if(!table[slot]){
+                        unique[s].push_back(corner);
+                        table[slot] = unique[s].size();
+                    }
+
+                    localIDs[(*j)] = table[slot] - 1;
+                }
+
+                std::vector<uint32_t>().swap((*i).Buckets[s]);
+            }
+        }
+    });
+
+    std::vector<size_t> shardBase(shardCount, 0);
+    size_t vertexCount = 0;
+    for(size_t s = 0; s < shardCount; s++){
+        shardBase[s] = vertexCount;
+        vertexCount += unique[s].size();
+    }
+
+    Out.vertices.resize(vertexCount);
+    Out.indices.resize(cornerCount);
+    Out.LODs.clear();
+
+    ForRanges(shardCount, 1, [&](size_t Begin, size_t End){
+        for(size_t s = Begin; s < End; s++){
+            for(size_t i = 0; i < unique[s].size(); i++){
+                const OBJCorner& corner = unique[s][i];
+                Vertex& vertex = Out.vertices[shardBase[s] + i];
+
+                vertex = Vertex{};
+                if(corner.Position){
+                    vertex.position = positions[corner.Position - 1];
+                    vertex.color = colors[corner.Position - 1];
+                }
+                if(corner.UV)
+                    vertex.uv = uvs[corner.UV - 1];
+                if(corner.Normal)
+                    vertex.normal = normals[corner.Normal - 1];
+            }
+        }
+    });
+
+    ForRanges(cornerCount, 1 << 16, [&](size_t Begin, size_t End){
+        for(size_t i = Begin; i < End; i++){
+            size_t shard = (shardCount > 1) ? (HashCorner(corners[i]) >> shardShift) : 0;
+            Out.indices[i] = shardBase[shard] + localIDs[i];
+        }
+    });
+
+    //Drop triangles that point at vertices that do not exist
+    if(missing){
+        WARN("OBJ FACE REFERS TO A MISSING VERTEX: ", FilePath.c_str());
+
+        size_t kept = 0;
+        for(size_t i = 0; i + 2 < cornerCount; i += 3){
+            if(!corners[i].Position || !corners[i + 1].Position || !corners[i + 2].Position)
+                continue;
+
+            Out.indices[kept++] = Out.indices[i];
+            Out.indices[kept++] = Out.indices[i + 1];
+            Out.indices[kept++] = Out.indices[i + 2];
+        }
+        Out.indices.resize(kept);
+    }
+
+    Out.GeneratedAABB = computeBounds(&Out);
+
+    return 0;
+}
+
+// ---------------------------------------------------------------- glTF
+
+//Just enough JSON for the glTF scene description, strings point into the mapping
+struct GLTFValue{
+    enum Kind{
+        GLTF_NULL = 0,
+        GLTF_BOOL,
+        GLTF_NUMBER,
+        GLTF_STRING,
+        GLTF_ARRAY,
+        GLTF_OBJECT
+    };
+
+    Kind Type = GLTF_NULL;
+    double Number = 0;
+    std::string_view Text = {};
+    std::vector<std::string_view> Keys = {}; //Objects only, matches Children
+    std::vector<GLTFValue> Children = {};
+
+    const GLTFValue* Get(std::string_view Key) const{
+        for(size_t i = 0; i < this->Keys.size(); i++){
+            if(this->Keys[i] == Key)
+                return &this->Children[i];
+        }
+        return nullptr;
+    }
+
+    //Indices come straight from the JSON so anything negative or fractional is missing
+    const GLTFValue* At(double Index) const{
+        if(this->Type != GLTF_ARRAY || !(Index >= 0) || Index >= (double)this->Children.size() || Index != (size_t)Index)
+            return nullptr;
+
+        return &this->Children[(size_t)Index];
+    }
+
+    double NumberOr(std::string_view Key, double Default) const{
+        const GLTFValue* value = this->Get(Key);
+        return (value && value->Type == GLTF_NUMBER) ? value->Number : Default;
+    }
+
+    //Counts and byte offsets, never negative
+    size_t SizeOr(std::string_view Key, size_t Default) const{
+        double value = this->NumberOr(Key, (double)Default);
+        return (value > 0 && value < 9.0e15) ? (size_t)value : 0;
+    }
+};
+
+static bool ParseJSON(OBJCursor& c, GLTFValue& Out, int Depth = 0){
+    auto Skip = [&c](){
+        while(c.At < c.End && (*c.At == ' ' || *c.At == '\t' || *c.At == '\r' || *c.At == '\n'))
+            c.At++;
+    };
+
+    auto ParseString = [&c](std::string_view& Text) -> bool{
+        const char* start = ++c.At;
+
+        while(c.At < c.End && *c.At != '"'){
+            if(*c.At == '\\')
+                c.At++;
+            c.At++;
+        }
+
+        if(c.At >= c.End)
+            return false;
+
+        Text = std::string_view(start, c.At - start);
+        c.At++;
+        return true;
+    };
+
+    Skip();
+    if(c.At >= c.End || Depth > 64)
+        return false;
+
+    char first = *c.At;
+
+    if(first == '{' || first == '['){
+        bool object = first == '{';
+        Out.Type = object ? GLTFValue::GLTF_OBJECT : GLTFValue::GLTF_ARRAY;
+        c.At++;
+
+        Skip();
+        if(c.At < c.End && *c.At == (object ? '}' : ']')){
+            c.At++;
+            return true;
+        }
+
+        while(c.At < c.End){
+            if(object){
+                Skip();
+                std::string_view key;
+                if(c.At >= c.End || *c.At != '"' || !ParseString(key))
+                    return false;
+
+                Skip();
+                if(c.At >= c.End || *c.At != ':')
+                    return false;
+                c.At++;
+
+                Out.Keys.push_back(key);
+            }
+
+            Out.Children.emplace_back();
+            if(!ParseJSON(c, Out.Children.back(), Depth + 1))
+                return false;
+
+            Skip();
+            if(c.At >= c.End)
+                return false;
+
+            if(*c.At == ','){
+                c.At++;
+                continue;
+            }
+            if(*c.At == (object ? '}' : ']')){
+                c.At++;
+                return true;
+            }
+
+            return false;
+        }
+
+        return false;
+    }
+
+    if(first == '"'){
+        Out.Type = GLTFValue::GLTF_STRING;
+        return ParseString(Out.Text);
+    }
+
+    if(c.End - c.At >= 4 && std::memcmp(c.At, "true", 4) == 0){
+        Out.Type = GLTFValue::GLTF_BOOL;
+        Out.Number = 1;
+        c.At += 4;
+        return true;
+    }
+    if(c.End - c.At >= 5 && std::memcmp(c.At, "false", 5) == 0){
+        Out.Type = GLTFValue::GLTF_BOOL;
+        c.At += 5;
+        return true;
+    }
+    if(c.End - c.At >= 4 && std::memcmp(c.At, "null", 4) == 0){
+        c.At += 4;
+        return true;
+    }
+
+    Out.Type = GLTFValue::GLTF_NUMBER;
+    auto result = std::from_chars(c.At, c.End, Out.Number);
+    if(result.ec != std::errc())
+        return false;
+
+    c.At = result.ptr;
+    return true;
+}
+
+constexpr uint32_t GLB_MAGIC = 0x46546C67; //"glTF"
+constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;
+
+//An accessor resolved to where its elements are in the binary chunk
+struct GLTFAccessor{
+    const uint8_t* Data = nullptr;
+    size_t Count = 0;
+    size_t Stride = 0;
+    int Components = 0;
+    int ComponentType = 0;
+    bool Normalized = false;
+
+    //Any component type to float, normalised integers map to [0, 1] (Or [-1, 1] when signed)
+    inline float Read(size_t Index, int Component) const{
+        const uint8_t* at = this->Data + (Index * this->Stride);
+
+        switch(this->ComponentType){
+            case 5126:{ //Float
+                float value;
+                std::memcpy(&value, at + (Component * 4), 4);
+                return value;
+            }
+            case 5121: return this->Normalized ? at[Component] / 255.f : at[Component]; //Unsigned byte
+            case 5120: return this->Normalized ? std::max(((int8_t*)at)[Component] / 127.f, -1.f) : ((int8_t*)at)[Component]; //Byte
+            case 5123:{ //Unsigned short
+                uint16_t value;
+                std::memcpy(&value, at + (Component * 2), 2);
+                return this->Normalized ? value / 65535.f : value;
+            }
+            case 5122:{ //Short
+                int16_t value;
+                std::memcpy(&value, at + (Component * 2), 2);
+                return this->Normalized ? std::max(value / 32767.f, -1.f) : value;
+            }
+            case 5125:{ //Unsigned int (Indices only)
+                uint32_t value;
+                std::memcpy(&value, at + (Component * 4), 4);
+                return (float)value;
+            }
+        }
+
+        return 0.f;
+    }
+
+    inline uint32_t ReadIndex(size_t Index) const{
+        const uint8_t* at = this->Data + (Index * this->Stride);
+
+        switch(this->ComponentType){
+            case 5121: return at[0];
+            case 5123:{
+                uint16_t value;
+                std::memcpy(&value, at, 2);
+                return value;
+            }
+            case 5125:{
+                uint32_t value;
+                std::memcpy(&value, at, 4);
+                return value;
+            }
+        }
+
+        return 0;
+    }
+};
+
+static int ComponentSize(int ComponentType){
+    switch(ComponentType){
+        case 5120:
+        case 5121: return 1;
+        case 5122:
+        case 5123: return 2;
+        case 5125:
+        case 5126: return 4;
+    }
+    return 0;
+}
+
+static int ComponentCount(std::string_view Type){
+    if(Type == "SCALAR") return 1;
+    if(Type == "VEC2") return 2;
+    if(Type == "VEC3") return 3;
+    if(Type == "VEC4") return 4;
+    return 0;
+}
+
+static bool ResolveAccessor(const GLTFValue& Root, const uint8_t* Bin, size_t BinLength, double Index, GLTFAccessor& Out){
+    const GLTFValue* accessors = Root.Get("accessors");
+    const GLTFValue* bufferViews = Root.Get("bufferViews");
+
+    const GLTFValue* accessor = accessors ? accessors->At(Index) : nullptr;
+    if(!accessor || !bufferViews)
+        return false;
+
+    if(accessor->Get("sparse")){
+        WARN("SPARSE GLTF ACCESSORS ARE NOT SUPPORTED");
+        return false;
+    }
+
+    const GLTFValue* view = bufferViews->At(accessor->NumberOr("bufferView", -1));
+    const GLTFValue* type = accessor->Get("type");
+    if(!view || !type || view->NumberOr("buffer", 0) != 0)
+        return false;
+
+    Out.ComponentType = (int)accessor->NumberOr("componentType", 0);
+    Out.Components = ComponentCount(type->Text);
+    Out.Count = accessor->SizeOr("count", 0);
+
+    const GLTFValue* normalized = accessor->Get("normalized");
+    Out.Normalized = normalized && normalized->Number != 0;
+
+    size_t elementSize = (size_t)ComponentSize(Out.ComponentType) * Out.Components;
+    Out.Stride = view->SizeOr("byteStride", 0);
+    if(!Out.Stride)
+        Out.Stride = elementSize;
+
+    size_t offset = view->SizeOr("byteOffset", 0) + accessor->SizeOr("byteOffset", 0);
+    size_t viewEnd = view->SizeOr("byteOffset", 0) + view->SizeOr("byteLength", 0);
+
+    //The last element only needs its own size, not a whole stride
+    if(!elementSize || !Out.Count || Out.Count > BinLength || Out.Stride > BinLength || viewEnd > BinLength || offset + ((Out.Count - 1) * Out.Stride) + elementSize > viewEnd)
+        return false;
+
+    Out.Data = Bin + offset;
+    return true;
+}
+
+static glm::mat4 NodeMatrix(const GLTFValue& Node){
+    glm::mat4 matrix(1.f);
+
+    if(const GLTFValue* values = Node.Get("matrix"); values && values->Children.size() == 16){
+        for(int i = 0; i < 16; i++){
+            matrix[i / 4][i % 4] = (float)values->Children[i].Number;
+        }
+        return matrix;
+    }
+
+    glm::vec3 translation(0.f);
+    glm::quat rotation(1.f, 0.f, 0.f, 0.f);
+    glm::vec3 scale(1.f);
+
+    if(const GLTFValue* values = Node.Get("translation"); values && values->Children.size() == 3)
+        translation = glm::vec3(values->Children[0].Number, values->Children[1].Number, values->Children[2].Number);
+    if(const GLTFValue* values = Node.Get("rotation"); values && values->Children.size() == 4) //Stored x, y, z, w
+        rotation = glm::quat((float)values->Children[3].Number, (float)values->Children[0].Number, (float)values->Children[1].Number, (float)values->Children[2].Number);
+    if(const GLTFValue* values = Node.Get("scale"); values && values->Children.size() == 3)
+        scale = glm::vec3(values->Children[0].Number, values->Children[1].Number, values->Children[2].Number);
+
+    matrix = glm::translate(matrix, translation);
+    matrix = matrix * glm::mat4_cast(rotation);
+    matrix = glm::scale(matrix, scale);
+
+    return matrix;
+}
+
+struct GLTFDraw{
+    const GLTFValue* Primitive;
+    glm::mat4 Transform;
+};
+
+static void CollectNodes(const GLTFValue& Root, double Node, const glm::mat4& Parent, std::vector<GLTFDraw>& Draws, int Depth){
+    const GLTFValue* nodes = Root.Get("nodes");
+    const GLTFValue* node = nodes ? nodes->At(Node) : nullptr;
+
+    if(!node || Depth > 64)
+        return;
+
+    glm::mat4 transform = Parent * NodeMatrix(*node);
+
+    const GLTFValue* meshes = Root.Get("meshes");
+    if(const GLTFValue* mesh = meshes ? meshes->At(node->NumberOr("mesh", -1)) : nullptr; mesh){
+        if(const GLTFValue* primitives = mesh->Get("primitives"); primitives){
+            for (auto i = primitives->Children.begin(); i != primitives->Children.end(); i++){
+                Draws.push_back(GLTFDraw{&(*i), transform});
+            }
+        }
+    }
+
+    if(const GLTFValue* children = node->Get("children"); children){
+        for (auto i = children->Children.begin(); i != children->Children.end(); i++){
+            CollectNodes(Root, (*i).Number, transform, Draws, Depth + 1);
+        }
+    }
+}
+
+int UnifiedEngine::ImportGLB(const std::string& FilePath, Mesh& Out){
+    MappedFile file;
+
+    if(file.Open(FilePath)){
+        return -1;
+    }
+
+    const uint8_t* bytes = file.Bytes();
+    size_t length = file.Length();
+
+    uint32_t header[3] = {0, 0, 0};
+    if(length >= 12)
+        std::memcpy(header, bytes, 12);
+
+    if(header[0] != GLB_MAGIC || header[1] != 2 || header[2] > length){
+        FAULT("NOT A GLTF 2.0 BINARY: ", FilePath.c_str());
+        return -1;
+    }
+
+    //Chunks follow the header, JSON first
+    const char* json = nullptr;
+    size_t jsonLength = 0;
+    const uint8_t* bin = nullptr;
+    size_t binLength = 0;
+
+    for(size_t offset = 12; offset + 8 <= header[2];){
+        uint32_t chunk[2];
+        std::memcpy(chunk, bytes + offset, 8);
+
+        if(offset + 8 + chunk[0] > header[2])
+            break;
+
+        if(chunk[1] == GLB_CHUNK_JSON && !json){
+            json = (const char*)bytes + offset + 8;
+            jsonLength = chunk[0];
+        }
+        else if(chunk[1] == GLB_CHUNK_BIN && !bin){
+            bin = bytes + offset + 8;
+            binLength = chunk[0];
+        }
+
+        offset += 8 + ((chunk[0] + 3) & ~3u);
+    }
+
+    GLTFValue root;
+    OBJCursor c = {json, json + jsonLength};
+
+    if(!json || !ParseJSON(c, root) || root.Type != GLTFValue::GLTF_OBJECT){
+        FAULT("GLTF JSON IS CORRUPT: ", FilePath.c_str());
+        return -1;
+    }
+
+    //Everything in the default scene with its node transforms baked in, or every mesh as is without one
+    std::vector<GLTFDraw> draws;
+    const GLTFValue* scenes = root.Get("scenes");
+    const GLTFValue* scene = scenes ? scenes->At(root.NumberOr("scene", 0)) : nullptr;
+
+    if(const GLTFValue* nodes = scene ? scene->Get("nodes") : nullptr; nodes){
+        for (auto i = nodes->Children.begin(); i != nodes->Children.end(); i++){
+            CollectNodes(root, (*i).Number, glm::mat4(1.f), draws, 0);
+        }
+    }
+    else if(const GLTFValue* meshes = root.Get("meshes"); meshes){
+        for (auto i = meshes->Children.begin(); i != meshes->Children.end(); i++){
+            if(const GLTFValue* primitives = (*i).Get("primitives"); primitives){
+                for (auto j = primitives->Children.begin(); j != primitives->Children.end(); j++){
+                    draws.push_back(GLTFDraw{&(*j), glm::mat4(1.f)});
+                }
+            }
+        }
+    }
+
+    Out.vertices.clear();
+    Out.indices.clear();
+    Out.LODs.clear();
+
+    for (auto i = draws.begin(); i != draws.end(); i++){
+        const GLTFValue& primitive = *(*i).Primitive;
+        const GLTFValue* attributes = primitive.Get("attributes");
+
+        if(primitive.NumberOr("mode", 4) != 4){
+            WARN("SKIPPING NON TRIANGLE GLTF PRIMITIVE: ", FilePath.c_str());
+            continue;
+        }
+
+        GLTFAccessor position, normal, uv, color, indices;
+
+        if(!attributes || !ResolveAccessor(root, bin, binLength, attributes->NumberOr("POSITION", -1), position) || position.Components != 3){
+            WARN("SKIPPING GLTF PRIMITIVE WITHOUT POSITIONS: ", FilePath.c_str());
+            continue;
+        }
+
+        bool hasNormal = ResolveAccessor(root, bin, binLength, attributes->NumberOr("NORMAL", -1), normal) && normal.Count == position.Count;
+        bool hasUV = ResolveAccessor(root, bin, binLength, attributes->NumberOr("TEXCOORD_0", -1), uv) && uv.Count == position.Count;
+        bool hasColor = ResolveAccessor(root, bin, binLength, attributes->NumberOr("COLOR_0", -1), color) && color.Count == position.Count;
+        bool hasIndices = ResolveAccessor(root, bin, binLength, primitive.NumberOr("indices", -1), indices) && indices.Components == 1;
+
+        size_t vertexBase = Out.vertices.size();
+        size_t indexBase = Out.indices.size();
+        size_t indexCount = hasIndices ? indices.Count - (indices.Count % 3) : position.Count - (position.Count % 3);
+
+        Out.vertices.resize(vertexBase + position.Count);
+        Out.indices.resize(indexBase + indexCount);
+
+        glm::mat4 transform = (*i).Transform;
+        glm::mat3 normalTransform = glm::transpose(glm::inverse(glm::mat3(transform)));
+
+        //Straight from the binary chunk into place, big primitives are split over the workers
+        ForRanges(position.Count, 1 << 14, [&](size_t Begin, size_t End){
+            for(size_t v = Begin; v < End; v++){
+                Vertex& vertex = Out.vertices[vertexBase + v];
+
+                vertex = Vertex{};
+                vertex.position = glm::vec3(transform * glm::vec4(position.Read(v, 0), position.Read(v, 1), position.Read(v, 2), 1.f));
+
+                if(hasNormal)
+                    vertex.normal = glm::normalize(normalTransform * glm::vec3(normal.Read(v, 0), normal.Read(v, 1), normal.Read(v, 2)));
+
+                //glTF puts v = 0 at the top of the image
+                if(hasUV)
+                    vertex.uv = glm::vec2(uv.Read(v, 0), 1.f - uv.Read(v, 1));
+
+                if(hasColor)
+                    vertex.color = glm::vec3(color.Read(v, 0), color.Read(v, 1), color.Read(v, 2));
+            }
+        });
+
+        std::atomic<bool> invalid{false};
+        ForRanges(indexCount, 1 << 16, [&](size_t Begin, size_t End){
+            for(size_t n = Begin; n < End; n++){
+                uint32_t index = hasIndices ? indices.ReadIndex(n) : (uint32_t)n;
+
+                if(index >= position.Count){
+                    invalid = true;
+                    index = 0;
+                }
+
+                Out.indices[indexBase + n] = vertexBase + index;
+            }
+        });
+
+        if(invalid)
+            WARN("GLTF INDEX OUT OF RANGE, CLAMPED: ", FilePath.c_str());
+    }
+
+    if(Out.vertices.empty()){
+        FAULT("GLTF HAS NO TRIANGLES: ", FilePath.c_str());
+        return -1;
+    }
+
+    Out.GeneratedAABB = computeBounds(&Out);
+
+    return 0;
+}
+
+int UnifiedEngine::ImportMesh(const std::string& FilePath, Mesh& Out){
+    std::string extension = std::filesystem::path(FilePath).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c){return std::tolower(c);});
+
+    if(extension == ".obj")
+        return ImportOBJ(FilePath, Out);
+    if(extension == ".glb")
+        return ImportGLB(FilePath, Out);
+
+    FAULT("UNSUPPORTED MESH FORMAT: ", FilePath.c_str());
+    return -1;
+}
@@ -0,0 +1,427 @@
+#include <Unified-Engine/Objects/Mesh/meshOptimize.h>
+#include <Unified-Engine/debug.h>
+#include <GLM/geometric.hpp>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+using namespace UnifiedEngine;
+
+//Forsyth scoring, the cache modelled while ordering is bigger than the one measured so it is never starved
+constexpr int FORSYTH_CACHE_SIZE = 32;
+constexpr float FORSYTH_DECAY_POWER = 1.5f;
+constexpr float FORSYTH_LAST_TRIANGLE = 0.75f;
+constexpr float FORSYTH_VALENCE_SCALE = 2.f;
+constexpr float FORSYTH_VALENCE_POWER = 0.5f;
+
+//Cache the overdraw pass measures against when deciding where clusters start
+constexpr unsigned OVERDRAW_CACHE_SIZE = 16;
+
+constexpr GLuint NO_VERTEX = UINT32_MAX;
+
+//Ranges optimised on their own, LOD ranges never share triangles
+static std::vector<MeshLOD> IndexRanges(const Mesh& mesh){
+    if(mesh.LODs.empty())
+        return {MeshLOD{0, (GLuint)mesh.indices.size(), 0.f}};
+
+    return mesh.LODs;
+}
+
+static bool ValidRange(const Mesh& mesh, const MeshLOD& Range){
+    return (Range.IndexCount % 3) == 0 && (size_t)Range.FirstIndex + Range.IndexCount <= mesh.indices.size();
+}
+
+static bool ValidIndices(const Mesh& mesh){
+    for (auto i = mesh.indices.begin(); i != mesh.indices.end(); i++){
+        if(*i >= mesh.vertices.size())
+            return false;
+    }
+
+    return (mesh.indices.size() % 3) == 0;
+}
+
+static size_t VertexRange(const GLuint* Indices, size_t Count){
+    size_t range = 0;
+    for(size_t i = 0; i < Count; i++){
+        range = std::max(range, (size_t)Indices[i] + 1);
+    }
+    return range;
+}
+
+//FIFO simulation, a vertex is cached while fewer than CacheSize misses happened since it was loaded
+static size_t CacheMisses(const GLuint* Indices, size_t Count, size_t VertexCount, unsigned CacheSize, size_t* Referenced = nullptr){
+    std::vector<size_t> loaded(VertexCount, SIZE_MAX);
+    size_t misses = 0;
+    size_t referenced = 0;
+
+    for(size_t i = 0; i < Count; i++){
+        size_t& at = loaded[Indices[i]];
+
+        if(at == SIZE_MAX)
+            referenced++;
+
+        if(at == SIZE_MAX || misses - at >= CacheSize){
+            at = misses;
+            misses++;
+        }
+    }
+
+    if(Referenced)
+        *Referenced = referenced;
+
+    return misses;
+}
+
+MeshCacheStats UnifiedEngine::AnalyzeVertexCache(const Mesh& mesh, unsigned CacheSize){
+    MeshCacheStats stats = {};
+
+    if(mesh.indices.size() < 3 || CacheSize == 0)
+        return stats;
+
+    size_t vertexCount = VertexRange(mesh.indices.data(), mesh.indices.size());
+
+    size_t misses = 0;
+    size_t referenced = 0;
+    size_t triangles = 0;
+
+    //Every LOD is drawn on its own so each starts with a cold cache
+    std::vector<MeshLOD> ranges = IndexRanges(mesh);
+    for (auto i = ranges.begin(); i != ranges.end(); i++){
+        if(!ValidRange(mesh, *i))
+            continue;
+
+        size_t rangeReferenced = 0;
+        misses += CacheMisses(mesh.indices.data() + (*i).FirstIndex, (*i).IndexCount, vertexCount, CacheSize, &rangeReferenced);
+        referenced += rangeReferenced;
+        triangles += (*i).IndexCount / 3;
+    }
+
+    if(triangles)
+        stats.ACMR = (float)misses / triangles;
+    if(referenced)
+        stats.ATVR = (float)misses / referenced;
+
+    return stats;
+}
+
+// ---------------------------------------------------------------- Vertex cache
+
+static float ForsythVertexScore(int CachePosition, GLuint Valence){
+    //Nothing left to draw with it
+    if(Valence == 0)
+        return -1.f;
+
+    float score = 0.f;
+
+    if(CachePosition >= 0){
+        //The last triangle's vertices are scored lower so strips do not just run backwards
+        if(CachePosition < 3)
+            score = FORSYTH_LAST_TRIANGLE;
+        else
+            score = std::pow(1.f - ((float)(CachePosition - 3) / (FORSYTH_CACHE_SIZE - 3)), FORSYTH_DECAY_POWER);
+    }
+
+    //Finish off vertices with few triangles left before they leave the cache
+    return score + (FORSYTH_VALENCE_SCALE * std::pow((float)Valence, -FORSYTH_VALENCE_POWER));
+}
+
+static void ForsythRange(GLuint* Indices, size_t Count, size_t VertexCount){
+    size_t triangles = Count / 3;
+
+    if(triangles < 2)
+        return;
+
+    //Triangles still to be drawn using each vertex, [Offsets[v], Offsets[v] + Valence[v])
+    std::vector<GLuint> valence(VertexCount, 0);
+    for(size_t i = 0; i < Count; i++){
+        valence[Indices[i]]++;
+    }
+
+    std::vector<GLuint> offsets(VertexCount + 1, 0);
+    for(size_t v = 0; v < VertexCount; v++){
+        offsets[v + 1] = offsets[v] + valence[v];
+    }
+
+    std::vector<GLuint> adjacency(Count);
+    {
+        std::vector<GLuint> fill(offsets.begin(), offsets.end() - 1);
+        for(size_t i = 0; i < Count; i++){
+            adjacency[fill[Indices[i]]++] = (GLuint)(i / 3);
+        }
+    }
+
+    std::vector<int> cachePosition(VertexCount, -1);
+    std::vector<float> vertexScore(VertexCount);
+    for(size_t v = 0; v < VertexCount; v++){
+        vertexScore[v] = ForsythVertexScore(-1, valence[v]);
+    }
+
+    std::vector<bool> emitted(triangles, false);
+    std::vector<GLuint> output;
+    output.reserve(Count);
+
+    std::vector<GLuint> cache;
+    std::vector<GLuint> next;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    next.reserve(FORSYTH_CACHE_SIZE + 3);
+
+    size_t cursor = 0;
+    int64_t best = -1;
+
+    for(size_t n = 0; n < triangles; n++){
+        //Nothing in the cache connects to anything left, restart from the next undrawn triangle
+        if(best < 0){
+            while(emitted[cursor])
+                cursor++;
+            best = cursor;
+        }
+
+        GLuint triangle = (GLuint)best;
+        const GLuint* corners = Indices + (triangle * 3);
+        emitted[triangle] = true;
+
+        next.clear();
+
+        for(int k = 0; k < 3; k++){
+            GLuint v = corners[k];
+            output.push_back(v);
+
+            //Swap the triangle out of the vertex's live list
+            GLuint* live = adjacency.data() + offsets[v];
+            for(GLuint j = 0; j < valence[v]; j++){
+                if(live[j] == triangle){
+                    std::swap(live[j], live[valence[v] - 1]);
+                    break;
+                }
+            }
+            valence[v]--;
+
+            if(std::find(next.begin(), next.end(), v) == next.end())
+                next.push_back(v);
+        }
+
+        //Drawn vertices move to the front, the rest shift back and the overflow drops out
+        for (auto i = cache.begin(); i != cache.end(); i++){
+            if(std::find(next.begin(), next.end(), *i) == next.end())
+                next.push_back(*i);
+        }
+
+        for(size_t k = 0; k < next.size(); k++){
+            GLuint v = next[k];
+            cachePosition[v] = (k < FORSYTH_CACHE_SIZE) ? (int)k : -1;
+            vertexScore[v] = ForsythVertexScore(cachePosition[v], valence[v]);
+        }
+
+        if(next.size() > FORSYTH_CACHE_SIZE)
+            next.resize(FORSYTH_CACHE_SIZE);
+        cache.swap(next);
+
+        //Only triangles touching the cache changed, the best of those goes next
+        best = -1;
+        float bestScore = -1.f;
+
+        for (auto i = cache.begin(); i != cache.end(); i++){
+            const GLuint* live = adjacency.data() + offsets[*i];
+
+            for(GLuint j = 0; j < valence[*i]; j++){
+                GLuint t = live[j];
+                float score = vertexScore[Indices[t * 3]] + vertexScore[Indices[t * 3 + 1]] + vertexScore[Indices[t * 3 + 2]];
+
+                if(score > bestScore){
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+    }
+
+    std::copy(output.begin(), output.end(), Indices);
+}
+
+int UnifiedEngine::OptimizeVertexCache(Mesh& mesh){
+    if(mesh.indices.empty())
+        return 0;
+
+    if(!ValidIndices(mesh)){
+        FAULT("MESH INDICES ARE OUT OF RANGE");
+        return -1;
+    }
+
+    std::vector<MeshLOD> ranges = IndexRanges(mesh);
+    for (auto i = ranges.begin(); i != ranges.end(); i++){
+        if(ValidRange(mesh, *i))
+            ForsythRange(mesh.indices.data() + (*i).FirstIndex, (*i).IndexCount, mesh.vertices.size());
+    }
+
+    return 0;
+}
+
+// ---------------------------------------------------------------- Overdraw
+
+struct OverdrawCluster{
+    size_t FirstTriangle;
+    size_t TriangleCount;
+    float Key;
+};
+
+static void OverdrawRange(const Mesh& mesh, GLuint* Indices, size_t Count, float Threshold){
+    size_t triangles = Count / 3;
+
+    if(triangles < 2)
+        return;
+
+    size_t vertexCount = mesh.vertices.size();
+
+    //A cluster starts wherever the cache order restarted (All three corners missed), moving whole
+    //clusters around costs at most one cold start each
+    std::vector<OverdrawCluster> clusters;
+    {
+        std::vector<size_t> loaded(vertexCount, SIZE_MAX);
+        size_t misses = 0;
+
+        for(size_t t = 0; t < triangles; t++){
+            int triangleMisses = 0;
+
+            for(int k = 0; k < 3; k++){
+                size_t& at = loaded[Indices[t * 3 + k]];
+                if(at == SIZE_MAX || misses - at >= OVERDRAW_CACHE_SIZE){
+                    at = misses;
+                    misses++;
+                    triangleMisses++;
+                }
+            }
+
+            if(t == 0 || triangleMisses == 3)
+                clusters.push_back(OverdrawCluster{t, 0, 0.f});
+
+            clusters.back().TriangleCount++;
+        }
+    }
+
+    if(clusters.size() < 2)
+        return;
+
+    //Area weighted centroid and normal per cluster, and the centroid of the whole range
+    std::vector<glm::vec3> centroids(clusters.size(), glm::vec3(0.f));
+    std::vector<glm::vec3> normals(clusters.size(), glm::vec3(0.f));
+    glm::vec3 center(0.f);
+    float totalArea = 0.f;
+
+    for(size_t c = 0; c < clusters.size(); c++){
+        float area = 0.f;
+
+        for(size_t t = clusters[c].FirstTriangle; t < clusters[c].FirstTriangle + clusters[c].TriangleCount; t++){
+            const glm::vec3& a = mesh.vertices[Indices[t * 3]].position;
+            const glm::vec3& b = mesh.vertices[Indices[t * 3 + 1]].position;
+            const glm::vec3& d = mesh.vertices[Indices[t * 3 + 2]].position;
+
+            glm::vec3 normal = glm::cross(b - a, d - a);
+            float weight = glm::length(normal);
+
+            centroids[c] += ((a + b + d) / 3.f) * weight;
+            normals[c] += normal;
+            area += weight;
+        }
+
+        center += centroids[c];
+        totalArea += area;
+
+        if(area > 0.f)
+            centroids[c] /= area;
+    }
+
+    if(totalArea > 0.f)
+        center /= totalArea;
+
+    //Clusters facing away from the middle are in front of the rest, draw them first
+    for(size_t c = 0; c < clusters.size(); c++){
+        float length = glm::length(normals[c]);
+        clusters[c].Key = (length > 0.f) ? glm::dot(centroids[c] - center, normals[c] / length) : 0.f;
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(), [](const OverdrawCluster& a, const OverdrawCluster& b){
+        return a.Key > b.Key;
+    });
+
+    std::vector<GLuint> sorted;
+    sorted.reserve(Count);
+    for (auto i = clusters.begin(); i != clusters.end(); i++){
+        sorted.insert(sorted.end(), Indices + ((*i).FirstTriangle * 3), Indices + (((*i).FirstTriangle + (*i).TriangleCount) * 3));
+    }
+
+    //Keep the cache order when the clusters were too small for it to pay off
+    size_t before = CacheMisses(Indices, Count, vertexCount, OVERDRAW_CACHE_SIZE);
+    size_t after = CacheMisses(sorted.data(), Count, vertexCount, OVERDRAW_CACHE_SIZE);
+
+    if(after <= before * Threshold)
+        std::copy(sorted.begin(), sorted.end(), Indices);
+}
+
+int UnifiedEngine::OptimizeOverdraw(Mesh& mesh, float Threshold){
+    if(mesh.indices.empty())
+        return 0;
+
+    if(!ValidIndices(mesh)){
+        FAULT("MESH INDICES ARE OUT OF RANGE");
+        return -1;
+    }
+
+    std::vector<MeshLOD> ranges = IndexRanges(mesh);
+    for (auto i = ranges.begin(); i != ranges.end(); i++){
+        if(ValidRange(mesh, *i))
+            OverdrawRange(mesh, mesh.indices.data() + (*i).FirstIndex, (*i).IndexCount, Threshold);
+    }
+
+    return 0;
+}
+
+// ---------------------------------------------------------------- Vertex fetch
+
+int UnifiedEngine::OptimizeVertexFetch(Mesh& mesh){
+    //Drawn straight from the vertices, none of them would look used
+    if(mesh.indices.empty())
+        return 0;
+
+    if(!ValidIndices(mesh)){
+        FAULT("MESH INDICES ARE OUT OF RANGE");
+        return -1;
+    }
+
+    std::vector<GLuint> remap(mesh.vertices.size(), NO_VERTEX);
+    GLuint used = 0;
+
+    for (auto i = mesh.indices.begin(); i != mesh.indices.end(); i++){
+        if(remap[*i] == NO_VERTEX)
+            remap[*i] = used++;
+        *i = remap[*i];
+    }
+
+    std::vector<Vertex> vertices(used);
+    for(size_t v = 0; v < mesh.vertices.size(); v++){
+        if(remap[v] != NO_VERTEX)
+            vertices[remap[v]] = mesh.vertices[v];
+    }
+
+    mesh.vertices.swap(vertices);
+
+    return 0;
+}
+
+int UnifiedEngine::OptimizeMesh(Mesh& mesh, bool Report){
+    if(mesh.indices.empty())
+        return 0;
+
+    MeshCacheStats before = AnalyzeVertexCache(mesh);
+
+    if(OptimizeVertexCache(mesh) || OptimizeOverdraw(mesh) || OptimizeVertexFetch(mesh)){
+        return -1;
+    }
+
+    if(Report){
+        MeshCacheStats after = AnalyzeVertexCache(mesh);
+        LOG("MESH OPTIMISED, ACMR ", before.ACMR, " -> ", after.ACMR, ", ATVR ", before.ATVR, " -> ", after.ATVR);
+    }
+
+    return 0;
+}
@@ -0,0 +1,412 @@
+#include <Unified-Engine/Objects/Mesh/meshSimplify.h>
+#include <Unified-Engine/debug.h>
+#include <GLM/geometric.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cfloat>
+#include <cmath>
+
+using namespace UnifiedEngine;
+
+//Border planes are weighted over the faces so open edges stay put
+constexpr double BORDER_WEIGHT = 10.0;
+
+//A collapse may not turn a triangle more than ~75 degrees
+constexpr float FLIP_LIMIT = 0.25f;
+
+//Nothing more is generated once an LOD keeps this much of the one before it
+constexpr float LOD_MIN_REDUCTION = 0.9f;
+
+/**
+ * @brief Weighted squared distances to a set of planes, v'Av + 2b.v + c with A symmetric.
+ *        Error is divided by the total weight so it stays a squared object space distance.
+ *
+ */
+struct Quadric{
+    double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+    double b0 = 0, b1 = 0, b2 = 0;
+    double c = 0;
+    double w = 0;
+
+    void AddPlane(const glm::vec3& n, float d, double Weight){
+        a00 += Weight * n.x * n.x; a01 += Weight * n.x * n.y; a02 += Weight * n.x * n.z;
+        a11 += Weight * n.y * n.y; a12 += Weight * n.y * n.z; a22 += Weight * n.z * n.z;
+        b0 += Weight * n.x * d; b1 += Weight * n.y * d; b2 += Weight * n.z * d;
+        c += Weight * d * d;
+        w += Weight;
+    }
+
+    void Add(const Quadric& q){
+        a00 += q.a00; a01 += q.a01; a02 += q.a02;
+        a11 += q.a11; a12 += q.a12; a22 += q.a22;
+        b0 += q.b0; b1 += q.b1; b2 += q.b2;
+        c += q.c;
+        w += q.w;
+    }
+
+    double Error(const glm::vec3& v) const{
+        double x = v.x, y = v.y, z = v.z;
+        double e = (a00 * x * x) + (a11 * y * y) + (a22 * z * z)
+            + 2.0 * ((a01 * x * y) + (a02 * x * z) + (a12 * y * z))
+            + 2.0 * ((b0 * x) + (b1 * y) + (b2 * z))
+            + c;
+        return (w > 0.0) ? std::max(e / w, 0.0) : 0.0;
+    }
+};
+
+struct Collapse{
+    double Cost;
+    GLuint From;
+    GLuint To;
+};
+
+struct PositionHash{
+    size_t operator()(const glm::vec3& p) const{
+        uint32_t bits[3];
+        std::memcpy(bits, &p, sizeof(bits));
+        return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+    }
+};
+
+static inline uint64_t EdgeKey(GLuint a, GLuint b){
+    return (a < b) ? (((uint64_t)a << 32) | b) : (((uint64_t)b << 32) | a);
+}
+
+float UnifiedEngine::SimplifyIndices(const Mesh& mesh, const GLuint* Indices, size_t Count, size_t TargetCount, float TargetError, std::vector<GLuint>& Out){
+    Out.assign(Indices, Indices + (Count - (Count % 3)));
+
+    size_t vertexCount = mesh.vertices.size();
+    if(Out.size() <= TargetCount || vertexCount == 0)
+        return 0.f;
+
+    //Weld by position, collapses work on welded points and attribute vertices follow
+    std::vector<GLuint> point(vertexCount);
+    std::vector<glm::vec3> position;
+    {
+        std::unordered_map<glm::vec3, GLuint, PositionHash> weld;
+        weld.reserve(vertexCount);
+
+        for(size_t v = 0; v < vertexCount; v++){
+            auto found = weld.emplace(mesh.vertices[v].position, (GLuint)position.size());
+            if(found.second)
+                position.push_back(mesh.vertices[v].position);
+            point[v] = found.first->second;
+        }
+    }
+
+    size_t pointCount = position.size();
+
+    //Vertices at each point, [GroupOffsets[p], GroupOffsets[p + 1])
+    std::vector<GLuint> groupOffsets(pointCount + 1, 0);
+    std::vector<GLuint> groups(vertexCount);
+    {
+        for(size_t v = 0; v < vertexCount; v++){
+            groupOffsets[point[v] + 1]++;
+        }
+        for(size_t p = 0; p < pointCount; p++){
+            groupOffsets[p + 1] += groupOffsets[p];
+        }
+
+        std::vector<GLuint> fill(groupOffsets.begin(), groupOffsets.end() - 1);
+        for(size_t v = 0; v < vertexCount; v++){
+            groups[fill[point[v]]++] = (GLuint)v;
+        }
+    }
+
+    std::vector<uint64_t> keys;
+    std::vector<bool> border(pointCount, false);
+
+    //Marks open edges (Used by one triangle), Keys holds each distinct edge once and sorted
+    auto FindBorders = [&](){
+        keys.clear();
+        for(size_t i = 0; i < Out.size(); i += 3){
+            for(int k = 0; k < 3; k++){
+                GLuint a = point[Out[i + k]];
+                GLuint b = point[Out[i + ((k + 1) % 3)]];
+                if(a != b)
+                    keys.push_back(EdgeKey(a, b));
+            }
+        }
+
+        std::sort(keys.begin(), keys.end());
+
+        std::fill(border.begin(), border.end(), false);
+        size_t unique = 0;
+
+        for(size_t i = 0; i < keys.size();){
+            size_t j = i;
+            while(j < keys.size() && keys[j] == keys[i])
+                j++;
+
+            //Border edges keep the top bit so the collapse pass can find them
+            uint64_t key = keys[i];
+            if(j - i == 1){
+                border[key >> 32] = true;
+                border[key & 0xFFFFFFFF] = true;
+                key |= 1ull << 63;
+            }
+
+            keys[unique++] = key;
+            i = j;
+        }
+
+        keys.resize(unique);
+    };
+
+    //Face planes weighted by area and border planes by length squared
+    std::vector<Quadric> quadrics(pointCount);
+    FindBorders();
+    {
+        std::vector<uint64_t> borderEdges;
+        for (auto i = keys.begin(); i != keys.end(); i++){
+            if((*i) >> 63)
+                borderEdges.push_back((*i) & ~(1ull << 63));
+        }
+
+        for(size_t i = 0; i < Out.size(); i += 3){
+            GLuint p[3] = {point[Out[i]], point[Out[i + 1]], point[Out[i + 2]]};
+
+            glm::vec3 normal = glm::cross(position[p[1]] - position[p[0]], position[p[2]] - position[p[0]]);
+            float area = glm::length(normal);
+            if(area <= 0.f)
+                continue;
+
+            normal /= area;
+
+            for(int k = 0; k < 3; k++){
+                quadrics[p[k]].AddPlane(normal, -glm::dot(normal, position[p[0]]), area * 0.5);
+
+                GLuint a = p[k];
+                GLuint b = p[(k + 1) % 3];
+                if(!border[a] || !border[b] || !std::binary_search(borderEdges.begin(), borderEdges.end(), EdgeKey(a, b)))
+                    continue;
+
+                //Plane through the edge at right angles to the face
+                glm::vec3 edge = position[b] - position[a];
+                float length = glm::length(edge);
+                if(length <= 0.f)
+                    continue;
+
+                glm::vec3 side = glm::normalize(glm::cross(edge, normal));
+                double weight = BORDER_WEIGHT * length * length;
+                quadrics[a].AddPlane(side, -glm::dot(side, position[a]), weight);
+                quadrics[b].AddPlane(side, -glm::dot(side, position[a]), weight);
+            }
+        }
+    }
+
+    double maxCost = (double)TargetError * TargetError;
+    double reached = 0.0;
+
+    std::vector<GLuint> adjacencyOffsets(pointCount + 1);
+    std::vector<GLuint> adjacency;
+    std::vector<bool> locked(pointCount);
+    std::vector<GLuint> remap(vertexCount);
+    std::vector<Collapse> collapses;
+
+    //Each pass collapses the cheapest independent edges, then the triangles are rebuilt
+    while(Out.size() > TargetCount){
+        //Triangles around each point
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+        for(size_t i = 0; i < Out.size(); i++){
+            adjacencyOffsets[point[Out[i]] + 1]++;
+        }
+        for(size_t p = 0; p < pointCount; p++){
+            adjacencyOffsets[p + 1] += adjacencyOffsets[p];
+        }
+
+        adjacency.resize(Out.size());
+        {
+            std::vector<GLuint> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for(size_t i = 0; i < Out.size(); i++){
+                adjacency[fill[point[Out[i]]]++] = (GLuint)(i / 3);
+            }
+        }
+
+        FindBorders();
+
+        //Cheapest direction of every edge, a border point only slides along the border
+        collapses.clear();
+        for (auto i = keys.begin(); i != keys.end(); i++){
+            bool borderEdge = (*i) >> 63;
+            GLuint a = ((*i) >> 32) & 0x7FFFFFFF;
+            GLuint b = (*i) & 0xFFFFFFFF;
+
+            Quadric q = quadrics[a];
+            q.Add(quadrics[b]);
+
+            bool aMoves = !border[a] || borderEdge;
+            bool bMoves = !border[b] || borderEdge;
+
+            double toB = aMoves ? q.Error(position[b]) : DBL_MAX;
+            double toA = bMoves ? q.Error(position[a]) : DBL_MAX;
+
+            if(toB == DBL_MAX && toA == DBL_MAX)
+                continue;
+
+            if(toB <= toA)
+                collapses.push_back(Collapse{toB, a, b});
+            else
+                collapses.push_back(Collapse{toA, b, a});
+        }
+
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y){
+            return x.Cost < y.Cost;
+        });
+
+        std::fill(locked.begin(), locked.end(), false);
+        for(size_t v = 0; v < vertexCount; v++){
+            remap[v] = (GLuint)v;
+        }
+
+        size_t removed = 0;
+        size_t needed = (Out.size() - TargetCount) / 3;
+        size_t done = 0;
+
+        for (auto i = collapses.begin(); i != collapses.end() && removed < needed; i++){
+            const Collapse& collapse = *i;
+
+            if(collapse.Cost > maxCost)
+                break;
+
+            if(locked[collapse.From] || locked[collapse.To])
+                continue;
+
+            //Every triangle that survives has to keep facing the same way
+            const glm::vec3& target = position[collapse.To];
+            bool flips = false;
+            size_t lost = 0;
+
+            for(GLuint j = adjacencyOffsets[collapse.From]; j < adjacencyOffsets[collapse.From + 1] && !flips; j++){
+                const GLuint* corners = Out.data() + (adjacency[j] * 3);
+                GLuint p[3] = {point[corners[0]], point[corners[1]], point[corners[2]]};
+
+                if(p[0] == collapse.To || p[1] == collapse.To || p[2] == collapse.To){
+                    lost++;
+                    continue;
+                }
+
+                glm::vec3 before[3] = {position[p[0]], position[p[1]], position[p[2]]};
+                glm::vec3 after[3] = {before[0], before[1], before[2]};
+                for(int k = 0; k < 3; k++){
+                    if(p[k] == collapse.From)
+                        after[k] = target;
+                }
+
+                glm::vec3 n0 = glm::cross(before[1] - before[0], before[2] - before[0]);
+                glm::vec3 n1 = glm::cross(after[1] - after[0], after[2] - after[0]);
+
+                flips = glm::dot(n0, n1) < FLIP_LIMIT * glm::length(n0) * glm::length(n1);
+            }
+
+            if(flips)
+                continue;
+
+            //Neighbours are held for the rest of the pass so the flip test stays true
+            for(GLuint j = adjacencyOffsets[collapse.From]; j < adjacencyOffsets[collapse.From + 1]; j++){
+                const GLuint* corners = Out.data() + (adjacency[j] * 3);
+                for(int k = 0; k < 3; k++){
+                    locked[point[corners[k]]] = true;
+                }
+            }
+            locked[collapse.From] = true;
+            locked[collapse.To] = true;
+
+            //Each attribute vertex at From moves to the closest matching one at To
+            for(GLuint j = groupOffsets[collapse.From]; j < groupOffsets[collapse.From + 1]; j++){
+                const Vertex& from = mesh.vertices[groups[j]];
+                float bestDistance = FLT_MAX;
+
+                for(GLuint k = groupOffsets[collapse.To]; k < groupOffsets[collapse.To + 1]; k++){
+                    const Vertex& to = mesh.vertices[groups[k]];
+                    glm::vec3 dn = from.normal - to.normal;
+                    glm::vec3 dc = from.color - to.color;
+                    glm::vec2 du = from.uv - to.uv;
+                    float distance = glm::dot(dn, dn) + glm::dot(dc, dc) + glm::dot(du, du);
+
+                    if(distance < bestDistance){
+                        bestDistance = distance;
+                        remap[groups[j]] = groups[k];
+                    }
+                }
+            }
+
+            quadrics[collapse.To].Add(quadrics[collapse.From]);
+            reached = std::max(reached, collapse.Cost);
+            removed += lost;
+            done++;
+        }
+
+        if(done == 0)
+            break;
+
+        //Rebuild without the triangles that collapsed to a line
+        size_t write = 0;
+        for(size_t i = 0; i < Out.size(); i += 3){
+            GLuint a = remap[Out[i]], b = remap[Out[i + 1]], c = remap[Out[i + 2]];
+
+            if(point[a] == point[b] || point[b] == point[c] || point[a] == point[c])
+                continue;
+
+            Out[write++] = a;
+            Out[write++] = b;
+            Out[write++] = c;
+        }
+        Out.resize(write);
+    }
+
+    return (float)std::sqrt(reached);
+}
+
+int UnifiedEngine::GenerateLODs(Mesh& mesh, unsigned MaxLODs, float Ratio, float MaxError){
+    for (auto i = mesh.indices.begin(); i != mesh.indices.end(); i++){
+        if(*i >= mesh.vertices.size()){
+            FAULT("MESH INDICES ARE OUT OF RANGE");
+            return -1;
+        }
+    }
+
+    //Only LOD 0 is kept, the rest are rebuilt from it
+    if(mesh.LODs.size()){
+        const MeshLOD& full = mesh.LODs.front();
+        std::vector<GLuint> base(mesh.indices.begin() + full.FirstIndex, mesh.indices.begin() + full.FirstIndex + full.IndexCount);
+        mesh.indices.swap(base);
+    }
+
+    mesh.indices.resize(mesh.indices.size() - (mesh.indices.size() % 3));
+    mesh.LODs = {MeshLOD{0, (GLuint)mesh.indices.size(), 0.f}};
+
+    AABB box = {};
+    for (auto i = mesh.vertices.begin(); i != mesh.vertices.end(); i++){
+        box.expand((*i).position);
+    }
+
+    float limit = mesh.vertices.empty() ? 0.f : MaxError * glm::length(box.max - box.min);
+    float error = 0.f;
+
+    //Each LOD is simplified from the last, the errors add up
+    std::vector<GLuint> previous = mesh.indices;
+    std::vector<GLuint> simplified;
+
+    for(unsigned lod = 1; lod < MaxLODs; lod++){
+        size_t target = (size_t)((previous.size() / 3) * Ratio) * 3;
+        if(target < 3)
+            break;
+
+        float reached = SimplifyIndices(mesh, previous.data(), previous.size(), target, limit - error, simplified);
+
+        if(simplified.empty() || simplified.size() > previous.size() * LOD_MIN_REDUCTION)
+            break;
+
+        error += reached;
+
+        mesh.LODs.push_back(MeshLOD{(GLuint)mesh.indices.size(), (GLuint)simplified.size(), error});
+        mesh.indices.insert(mesh.indices.end(), simplified.begin(), simplified.end());
+
+        previous.swap(simplified);
+    }
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include <Unified-Engine/Utility/mappedFile.h>
+#include <Unified-Engine/debug.h>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+using namespace UnifiedEngine;
+
+MappedFile::MappedFile(){
+
+}
+MappedFile::MappedFile(const std::string& FilePath){
+    this->Open(FilePath);
+}
+MappedFile::~MappedFile(){
+    this->Close();
+}
+
+int MappedFile::Open(const std::string& FilePath){
+    this->Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(FilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if(file == INVALID_HANDLE_VALUE){
+        FAULT("COULD NOT OPEN FILE: ", FilePath.c_str());
+        return -1;
+    }
+
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size) || !size.QuadPart){
+        FAULT("COULD NOT MAP EMPTY FILE: ", FilePath.c_str());
+        CloseHandle(file);
+        return -1;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+    if(!view){
+        FAULT("COULD NOT MAP FILE: ", FilePath.c_str());
+        if(mapping)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        return -1;
+    }
+
+    this->File = file;
+    this->Mapping = mapping;
+    this->Data = (const uint8_t*)view;
+    this->Size = (size_t)size.QuadPart;
+#else
+    int descriptor = open(FilePath.c_str(), O_RDONLY);
+    if(descriptor < 0){
+        FAULT("COULD NOT OPEN FILE: ", FilePath.c_str());
+        return -1;
+    }
+
+    struct stat info;
+    if(fstat(descriptor, &info) || !info.st_size){
+        FAULT("COULD NOT MAP EMPTY FILE: ", FilePath.c_str());
+        close(descriptor);
+        return -1;
+    }
+
+    void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if(view == MAP_FAILED){
+        FAULT("COULD NOT MAP FILE: ", FilePath.c_str());
+        close(descriptor);
+        return -1;
+    }
+
+    this->Descriptor = descriptor;
+    this->Data = (const uint8_t*)view;
+    this->Size = (size_t)info.st_size;
+#endif
+
+    return 0;
+}
+
+int MappedFile::Close(){
+    if(!this->Data)
+        return 0;
+
+#ifdef _WIN32
+    UnmapViewOfFile(this->Data);
+    CloseHandle((HANDLE)this->Mapping);
+    CloseHandle((HANDLE)this->File);
+    this->Mapping = nullptr;
+    this->File = nullptr;
+#else
+    munmap((void*)this->Data, this->Size);
+    close(this->Descriptor);
+    this->Descriptor = -1;
+#endif
+
+    this->Data = nullptr;
+    this->Size = 0;
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include <Unified-Engine/Utility/simd.h>
+
+#if defined(UE_SIMD_SSE2) && defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace UnifiedEngine {
+
+    /// @brief Checks the CPU (and OS register saving) for AVX2 and FMA, the result is cached
+    /// @return True if AVX2 kernels can be used
+    bool CPUSupportsAVX2() {
+#if defined(UE_SIMD_SSE2)
+    #if defined(_MSC_VER)
+        static const bool supported = [](){
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+                return false;
+
+            __cpuid(info, 1);
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            bool avx = (info[2] & (1 << 28)) != 0;
+            bool fma = (info[2] & (1 << 12)) != 0; //The AVX2 kernels use FMA too
+            if (!osxsave || !avx || !fma || (_xgetbv(0) & 0x6) != 0x6)
+                return false;
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+        }();
+        return supported;
+    #else
+        static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        return supported;
+    #endif
+#else
+        return false;
+#endif
+    }
+}
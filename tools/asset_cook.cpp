@@ -0,0 +1,231 @@
+//Offline texture cooker, packs every image under a folder into atlas pages with their mips
+//so the runtime can memory map them instead of decoding (See Core/Rendering/texturePack.h)
+//
+//Usage: asset_cook <Input Folder> <Output .uepack>
+//Paths in the pack are relative to the input folder, mount the pack with the same root
+
+#include <Unified-Engine/Core/Rendering/texturePackFormat.h>
+#include <Unified-Engine/Core/Rendering/mipBuilder.h>
+#include <Unified-Engine/Core/threadPool.h>
+#include <Unified-Engine/debug.h>
+#include <SOIL2/SOIL2.h>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include <list>
+#include <string>
+#include <cstring>
+
+using namespace UnifiedEngine;
+
+struct CookedImage{
+    std::string Path; //Relative, '/' seperated
+    uint8_t* Data = nullptr;
+    int width = 0;
+    int height = 0;
+
+    uint32_t Page = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+};
+
+struct CookSpace{
+    uint32_t x;
+    uint32_t y;
+    uint32_t w;
+    uint32_t h;
+};
+
+//Guillotine split like TextureAtlas::FindAvailableSpace, but spaces with no area are never kept
+static bool FindSpace(std::vector<std::list<CookSpace>>& Pages, CookedImage& image){
+    for (size_t page = 0; page <= Pages.size(); page++){
+        if(page == Pages.size())
+            Pages.push_back(std::list<CookSpace>{CookSpace{0, 0, TEXTURE_PACK_PAGE_SIZE, TEXTURE_PACK_PAGE_SIZE}});
+
+        std::list<CookSpace>& spaces = Pages[page];
+
+        for (auto j = spaces.begin(); j != spaces.end(); j++){
+            if((uint32_t)image.width <= (*j).w && (uint32_t)image.height <= (*j).h){
+                CookSpace Small = {(*j).x + image.width, (*j).y, (*j).w - image.width, (uint32_t)image.height};
+                CookSpace Big = {(*j).x, (*j).y + image.height, (*j).w, (*j).h - image.height};
+
+                if(Big.w && Big.h)
+                    spaces.insert(j, Big);
+                if(Small.w && Small.h)
+                    spaces.insert(j, Small);
+
+                image.Page = page;
+                image.x = (*j).x;
+                image.y = (*j).y;
+
+                spaces.erase(j);
+                return true;
+            }
+        }
+
+        //A fresh page could not hold it either
+        if(spaces.size() == 1 && spaces.front().w == TEXTURE_PACK_PAGE_SIZE && spaces.front().h == TEXTURE_PACK_PAGE_SIZE)
+            return false;
+    }
+
+    return false;
+}
+
+static bool IsImage(const std::filesystem::path& Path){
+    std::string extension = Path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c){return std::tolower(c);});
+
+    return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga"
+        || extension == ".bmp" || extension == ".psd" || extension == ".gif";
+}
+
+int main(int argc, char** argv){
+    if(argc != 3){
+        std::cout << "Usage: asset_cook <Input Folder> <Output .uepack>" << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path root = argv[1];
+    std::string output = argv[2];
+
+    if(!std::filesystem::is_directory(root)){
+        FAULT("INPUT IS NOT A FOLDER: ", argv[1]);
+        return 1;
+    }
+
+    //Mips are filtered across every core
+    __GLOBAL_THREAD_POOL = new ThreadPool();
+
+    //Decode everything
+    std::vector<CookedImage> images;
+
+    for (auto i = std::filesystem::recursive_directory_iterator(root); i != std::filesystem::recursive_directory_iterator(); i++){
+        if(!(*i).is_regular_file() || !IsImage((*i).path()))
+            continue;
+
+        CookedImage image;
+        image.Path = std::filesystem::relative((*i).path(), root).generic_string();
+        image.Data = SOIL_load_image((*i).path().string().c_str(), &image.width, &image.height, NULL, SOIL_LOAD_RGBA);
+
+        if(!image.Data){
+            WARN("COULD NOT DECODE, SKIPPING: ", image.Path.c_str());
+            continue;
+        }
+
+        if(image.width > (int)TEXTURE_PACK_PAGE_SIZE || image.height > (int)TEXTURE_PACK_PAGE_SIZE){
+            WARN("LARGER THAN A PAGE, SKIPPING: ", image.Path.c_str());
+            SOIL_free_image_data(image.Data);
+            continue;
+        }
+
+        images.push_back(image);
+    }
+
+    //Tallest first packs the guillotine much tighter
+    std::sort(images.begin(), images.end(), [](const CookedImage& a, const CookedImage& b){
+        return (a.height != b.height) ? a.height > b.height : a.width > b.width;
+    });
+
+    std::vector<std::list<CookSpace>> spaces;
+    for (auto i = images.begin(); i != images.end(); i++){
+        FindSpace(spaces, (*i));
+    }
+
+    uint32_t mipCount = 0;
+    while((TEXTURE_PACK_PAGE_SIZE >> mipCount) > 0)
+        mipCount++;
+
+    //Lay the file out
+    TexturePackHeader header = {};
+    header.Magic = TEXTURE_PACK_MAGIC;
+    header.Version = TEXTURE_PACK_VERSION;
+    header.PageSize = TEXTURE_PACK_PAGE_SIZE;
+    header.PageCount = spaces.size();
+    header.MipCount = mipCount;
+    header.EntryCount = images.size();
+    header.EntryOffset = sizeof(TexturePackHeader);
+    header.StringOffset = header.EntryOffset + (images.size() * sizeof(TexturePackEntry));
+    header.PageStride = TexturePackMipOffset(TEXTURE_PACK_PAGE_SIZE, mipCount);
+
+    std::vector<TexturePackEntry> entries;
+    std::string strings;
+
+    for (auto i = images.begin(); i != images.end(); i++){
+        TexturePackEntry entry = {};
+        entry.PathOffset = strings.size();
+        entry.PathLength = (*i).Path.size();
+        entry.Page = (*i).Page;
+        entry.x = (*i).x;
+        entry.y = (*i).y;
+        entry.w = (*i).width;
+        entry.h = (*i).height;
+
+        //Same order and flip as TextureAtlas::PlaceImageAt
+        float size = (float)TEXTURE_PACK_PAGE_SIZE;
+        float uv[8] = {
+            entry.x / size, 1.f - (entry.y / size),
+            (entry.x + entry.w) / size, 1.f - (entry.y / size),
+            entry.x / size, 1.f - ((entry.y + entry.h) / size),
+            (entry.x + entry.w) / size, 1.f - ((entry.y + entry.h) / size)
+        };
+        std::memcpy(entry.UV, uv, sizeof(uv));
+
+        entries.push_back(entry);
+        strings += (*i).Path;
+    }
+
+    uint64_t stringsEnd = header.StringOffset + strings.size();
+    header.PageOffset = ((stringsEnd + TEXTURE_PACK_ALIGNMENT - 1) / TEXTURE_PACK_ALIGNMENT) * TEXTURE_PACK_ALIGNMENT;
+
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    if(!file){
+        FAULT("COULD NOT OPEN OUTPUT: ", output.c_str());
+        return 1;
+    }
+
+    file.write((const char*)&header, sizeof(header));
+    file.write((const char*)entries.data(), entries.size() * sizeof(TexturePackEntry));
+    file.write(strings.data(), strings.size());
+
+    std::vector<char> padding(header.PageOffset - stringsEnd, 0);
+    file.write(padding.data(), padding.size());
+
+    //Pages are built one at a time into a single buffer, the decoded images stay until the end
+    std::vector<uint8_t> page(header.PageStride);
+
+    //Gamma correct Kaiser with premultiplied filtering, stored straight so it suits the default blending
+    MipSettings mips = {};
+
+    for(uint32_t p = 0; p < header.PageCount; p++){
+        std::fill(page.begin(), page.end(), 0);
+
+        for (auto i = images.begin(); i != images.end(); i++){
+            if((*i).Page != p)
+                continue;
+
+            for(int y = 0; y < (*i).height; y++){
+                std::memcpy(&page[((((size_t)(*i).y + y) * TEXTURE_PACK_PAGE_SIZE) + (*i).x) * 4], (*i).Data + ((size_t)y * (*i).width * 4), (size_t)(*i).width * 4);
+            }
+        }
+
+        BuildMipChain(page.data(), TEXTURE_PACK_PAGE_SIZE, mips);
+        file.write((const char*)page.data(), page.size());
+    }
+
+    for (auto i = images.begin(); i != images.end(); i++){
+        SOIL_free_image_data((*i).Data);
+    }
+
+    if(!file){
+        FAULT("FAILED WRITING: ", output.c_str());
+        return 1;
+    }
+
+    delete __GLOBAL_THREAD_POOL;
+    __GLOBAL_THREAD_POOL = nullptr;
+
+    LOG("COOKED ", images.size(), " TEXTURES INTO ", header.PageCount, " PAGES: ", output.c_str());
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+//Offline mesh converter, turns a model into a .uemesh the runtime can memory map and upload
+//without parsing (See Objects/Mesh/meshFile.h)
+//
+//Usage: mesh_convert [--compact | --half] [--no-optimize] [--lods <Count>] <Input .obj/.glb> <Output .uemesh>
+//  --compact      16 bit positions within the bounds, packed normals/colours/uvs (VERTEX_LAYOUT_COMPACT)
+//  --half         Same with half float positions (VERTEX_LAYOUT_COMPACT_HALF)
+//  --no-optimize  Keep the authored triangle and vertex order (See Objects/Mesh/meshOptimize.h)
+//  --lods         Simplify into an LOD chain of up to Count levels, each about half the last (See Objects/Mesh/meshSimplify.h)
+
+#include <Unified-Engine/Objects/Mesh/meshImport.h>
+#include <Unified-Engine/Objects/Mesh/meshFile.h>
+#include <Unified-Engine/Objects/Mesh/meshOptimize.h>
+#include <Unified-Engine/Objects/Mesh/meshSimplify.h>
+#include <Unified-Engine/Core/threadPool.h>
+#include <Unified-Engine/debug.h>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+using namespace UnifiedEngine;
+
+int main(int argc, char** argv){
+    VertexLayout layout = VERTEX_LAYOUT_FULL;
+    bool optimize = true;
+    bool usage = false;
+    int lods = 1;
+
+    int arg = 1;
+    for(; arg < argc && std::string(argv[arg]).rfind("--", 0) == 0; arg++){
+        std::string flag = argv[arg];
+
+        if(flag == "--compact")
+            layout = VERTEX_LAYOUT_COMPACT;
+        else if(flag == "--half")
+            layout = VERTEX_LAYOUT_COMPACT_HALF;
+        else if(flag == "--no-optimize")
+            optimize = false;
+        else if(flag == "--lods" && arg + 1 < argc)
+            lods = std::max(std::atoi(argv[++arg]), 1);
+        else
+            usage = true;
+    }
+
+    if(usage || argc - arg != 2){
+        std::cout << "Usage: mesh_convert [--compact | --half] [--no-optimize] [--lods <Count>] <Input .obj/.glb> <Output .uemesh>" << std::endl;
+        return 1;
+    }
+
+    std::string input = argv[arg];
+    std::string output = argv[arg + 1];
+
+    //Importers split big files across every core
+    __GLOBAL_THREAD_POOL = new ThreadPool();
+
+    Mesh mesh = {};
+
+    if(ImportMesh(input, mesh)){
+        return 1;
+    }
+
+    if(lods > 1 && GenerateLODs(mesh, lods)){
+        return 1;
+    }
+
+    //Cache, overdraw and fetch order, logs the ACMR/ATVR gained
+    if(optimize && OptimizeMesh(mesh)){
+        return 1;
+    }
+
+    mesh.Layout = layout;
+
+    if(WriteMeshFile(output, mesh)){
+        return 1;
+    }
+
+    LOG("CONVERTED ", mesh.vertices.size(), " VERTICES AND ", (mesh.LODs.size() ? mesh.LODs.front().IndexCount : mesh.indices.size()) / 3, " TRIANGLES IN ", std::max(mesh.LODs.size(), (size_t)1), " LODS: ", output.c_str());
+
+    delete __GLOBAL_THREAD_POOL;
+    __GLOBAL_THREAD_POOL = nullptr;
+
+    return 0;
+}